@@ -0,0 +1,22 @@
+# Use an installed Google Benchmark when available, otherwise download it as with Google Test
+find_package(benchmark QUIET)
+if (NOT benchmark_FOUND)
+	if (CMAKE_VERSION VERSION_LESS 3.2)
+		set(UPDATE_DISCONNECTED_IF_AVAILABLE "")
+	else()
+		set(UPDATE_DISCONNECTED_IF_AVAILABLE "UPDATE_DISCONNECTED 1")
+	endif()
+
+	download_project(PROJ                googlebenchmark
+					 GIT_REPOSITORY      https://github.com/google/benchmark.git
+					 GIT_TAG             v1.8.3
+					 ${UPDATE_DISCONNECTED_IF_AVAILABLE}
+	)
+
+	# Only build the benchmark library itself
+	set(BENCHMARK_ENABLE_TESTING OFF CACHE BOOL "" FORCE)
+	set(BENCHMARK_ENABLE_GTEST_TESTS OFF CACHE BOOL "" FORCE)
+	set(BENCHMARK_ENABLE_INSTALL OFF CACHE BOOL "" FORCE)
+
+	add_subdirectory(${googlebenchmark_SOURCE_DIR} ${googlebenchmark_BINARY_DIR})
+endif()
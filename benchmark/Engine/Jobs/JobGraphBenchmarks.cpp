@@ -0,0 +1,58 @@
+#include <Engine/Jobs/JobGraph.hpp>
+
+// STL includes
+#include <algorithm>
+// Google Benchmark includes
+#include <benchmark/benchmark.h>
+// AndGen includes
+#include <Engine/Parallelism/ThreadPool.hpp>
+
+namespace AndGen::Benchmarks
+{
+	// Runs a graph with one node fanning out to N empty nodes, which fan back in to a single node
+	static void JobGraph_FanOutFanIn(benchmark::State& state)
+	{
+		ThreadPool threadPool(std::max(ThreadPool::GetIdealThreadCount(), 1u));
+		JobGraph graph;
+
+		JobGraph::NodeId root	= graph.AddNode([] {});
+		JobGraph::NodeId sink	= graph.AddNode([] {});
+		for (int64_t i = 0; i < state.range(0); i++)
+		{
+			JobGraph::NodeId node = graph.AddNode([] {});
+			graph.AddEdge(root, node);
+			graph.AddEdge(node, sink);
+		}
+		graph.Compile();
+
+		for (auto _ : state)
+		{
+			graph.Run(threadPool);
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(graph.NodeCount()));
+	}
+	BENCHMARK(JobGraph_FanOutFanIn)->RangeMultiplier(4)->Range(4, 1024)->UseRealTime();
+
+	// Runs a graph of N empty nodes, each depending on the last
+	static void JobGraph_Chain(benchmark::State& state)
+	{
+		ThreadPool threadPool(std::max(ThreadPool::GetIdealThreadCount(), 1u));
+		JobGraph graph;
+
+		JobGraph::NodeId previous = graph.AddNode([] {});
+		for (int64_t i = 1; i < state.range(0); i++)
+		{
+			JobGraph::NodeId node = graph.AddNode([] {});
+			graph.AddEdge(previous, node);
+			previous = node;
+		}
+		graph.Compile();
+
+		for (auto _ : state)
+		{
+			graph.Run(threadPool);
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+	BENCHMARK(JobGraph_Chain)->RangeMultiplier(4)->Range(4, 1024)->UseRealTime();
+}
@@ -0,0 +1,33 @@
+#include <Engine/Jobs/JobProfiler.hpp>
+
+// Google Benchmark includes
+#include <benchmark/benchmark.h>
+
+namespace AndGen::Benchmarks
+{
+	// Records an event while capturing, which should take well under 50ns
+	static void JobProfiler_Record(benchmark::State& state)
+	{
+		int job = 0;
+		JobProfiler::BeginCapture();
+		for (auto _ : state)
+		{
+			JobProfiler::Record(JobProfiler::EventType::JobBegin, &job);
+		}
+		JobProfiler::EndCapture();
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(JobProfiler_Record)->ThreadRange(1, 8);
+
+	// Records an event while not capturing
+	static void JobProfiler_Record_NotCapturing(benchmark::State& state)
+	{
+		int job = 0;
+		for (auto _ : state)
+		{
+			JobProfiler::Record(JobProfiler::EventType::JobBegin, &job);
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(JobProfiler_Record_NotCapturing);
+}
@@ -0,0 +1,64 @@
+#include <Engine/Jobs/JobQueue.hpp>
+
+// Google Benchmark includes
+#include <benchmark/benchmark.h>
+// AndGen includes
+#include <Engine/Jobs/JobRecord.hpp>
+#include <Engine/Jobs/LockFreeJobQueue.hpp>
+
+namespace AndGen::Benchmarks
+{
+	// Each thread adds an empty job then takes the next job, with 1..N threads sharing the queue
+	template<class QueueType>
+	static void JobQueue_PushPop(benchmark::State& state)
+	{
+		static QueueType* s_jobQueue = nullptr;
+		if (state.thread_index() == 0)
+		{
+			s_jobQueue = new QueueType();
+		}
+
+		for (auto _ : state)
+		{
+			s_jobQueue->AddJob(JobRecord::Create([] {}));
+
+			JobRecord* record = s_jobQueue->GetNextJob();
+			if (record != nullptr)
+			{
+				JobRecord::Execute(record);
+			}
+		}
+		state.SetItemsProcessed(state.iterations());
+
+		if (state.thread_index() == 0)
+		{
+			delete s_jobQueue;
+			s_jobQueue = nullptr;
+		}
+	}
+	BENCHMARK_TEMPLATE(JobQueue_PushPop, JobQueue)->ThreadRange(1, 16)->UseRealTime();
+	BENCHMARK_TEMPLATE(JobQueue_PushPop, LockFreeJobQueue)->ThreadRange(1, 16)->UseRealTime();
+
+	// Adds a batch of empty jobs, then takes each of them, on a single thread
+	template<class QueueType>
+	static void JobQueue_PushPopBatch(benchmark::State& state)
+	{
+		QueueType jobQueue;
+		size_t batchSize = static_cast<size_t>(state.range(0));
+
+		for (auto _ : state)
+		{
+			for (size_t i = 0; i < batchSize; i++)
+			{
+				jobQueue.AddJob(JobRecord::Create([] {}));
+			}
+			while (JobRecord* record = jobQueue.GetNextJob())
+			{
+				JobRecord::Execute(record);
+			}
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+	BENCHMARK_TEMPLATE(JobQueue_PushPopBatch, JobQueue)->RangeMultiplier(8)->Range(8, 4096);
+	BENCHMARK_TEMPLATE(JobQueue_PushPopBatch, LockFreeJobQueue)->RangeMultiplier(8)->Range(8, 4096);
+}
@@ -0,0 +1,166 @@
+#include <Engine/Parallelism/Barrier.hpp>
+#include <Engine/Parallelism/Latch.hpp>
+#include <Engine/Parallelism/Semaphore.hpp>
+#include <Engine/Parallelism/SpinLock.hpp>
+
+// STL includes
+#include <barrier>
+#include <cstdint>
+#include <latch>
+#include <memory>
+#include <mutex>
+#include <semaphore>
+// Google Benchmark includes
+#include <benchmark/benchmark.h>
+
+namespace AndGen::Benchmarks
+{
+	// Most threads contending for each primitive, beginning from a single uncontended thread
+	constexpr int MaxThreadCount = 8;
+
+	// std::counting_semaphore, with the same interface as Semaphore
+	class StdSemaphore
+	{
+	public:
+		explicit StdSemaphore(std::uint32_t initialCount) : m_semaphore(initialCount) {}
+
+		inline void Acquire()	{ m_semaphore.acquire(); }
+		inline void Release()	{ m_semaphore.release(); }
+
+	private:
+		std::counting_semaphore<> m_semaphore;
+	};
+
+	// std::latch, with the same interface as Latch
+	class StdLatch
+	{
+	public:
+		explicit StdLatch(std::uint32_t count) : m_latch(count) {}
+
+		inline void CountDown()		{ m_latch.count_down(); }
+		inline void ArriveAndWait()	{ m_latch.arrive_and_wait(); }
+
+	private:
+		std::latch m_latch;
+	};
+
+	// std::barrier, with the same interface as Barrier
+	class StdBarrier
+	{
+	public:
+		explicit StdBarrier(std::uint32_t threadCount) : m_barrier(threadCount) {}
+
+		inline void ArriveAndWait()	{ m_barrier.arrive_and_wait(); }
+
+	private:
+		std::barrier<> m_barrier;
+	};
+
+	// Locks and unlocks a lock shared by every benchmark thread, around a short critical section
+	template<class LockType>
+	static void Lock_LockUnlock(benchmark::State& state)
+	{
+		static LockType lock;
+		static std::uint64_t value = 0;
+
+		for (auto _ : state)
+		{
+			std::scoped_lock<LockType> guard(lock);
+			benchmark::DoNotOptimize(++value);
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK_TEMPLATE(Lock_LockUnlock, SpinLock)->ThreadRange(1, MaxThreadCount)->UseRealTime();
+	BENCHMARK_TEMPLATE(Lock_LockUnlock, std::mutex)->ThreadRange(1, MaxThreadCount)->UseRealTime();
+
+	// Releases and then acquires a semaphore shared by every benchmark thread, which blocks while other
+	// threads have taken every count
+	template<class SemaphoreType>
+	static void Semaphore_ReleaseAcquire(benchmark::State& state)
+	{
+		static std::unique_ptr<SemaphoreType> semaphore;
+		if (state.thread_index() == 0)
+		{
+			semaphore = std::make_unique<SemaphoreType>(0);
+		}
+
+		for (auto _ : state)
+		{
+			semaphore->Release();
+			semaphore->Acquire();
+		}
+		state.SetItemsProcessed(state.iterations());
+
+		if (state.thread_index() == 0)
+		{
+			semaphore.reset();
+		}
+	}
+	BENCHMARK_TEMPLATE(Semaphore_ReleaseAcquire, Semaphore)->ThreadRange(1, MaxThreadCount)->UseRealTime();
+	BENCHMARK_TEMPLATE(Semaphore_ReleaseAcquire, StdSemaphore)->ThreadRange(1, MaxThreadCount)->UseRealTime();
+
+	// Counts down a latch shared by every benchmark thread, which never reaches zero
+	template<class LatchType>
+	static void Latch_CountDown(benchmark::State& state)
+	{
+		static std::unique_ptr<LatchType> latch;
+		if (state.thread_index() == 0)
+		{
+			latch = std::make_unique<LatchType>(UINT32_MAX);
+		}
+
+		for (auto _ : state)
+		{
+			latch->CountDown();
+		}
+		state.SetItemsProcessed(state.iterations());
+
+		if (state.thread_index() == 0)
+		{
+			latch.reset();
+		}
+	}
+	BENCHMARK_TEMPLATE(Latch_CountDown, Latch)->ThreadRange(1, MaxThreadCount)->UseRealTime();
+	BENCHMARK_TEMPLATE(Latch_CountDown, StdLatch)->ThreadRange(1, MaxThreadCount)->UseRealTime();
+
+	// Constructs a latch for a single thread, and arrives at it, completing it without blocking
+	template<class LatchType>
+	static void Latch_ArriveAndWait(benchmark::State& state)
+	{
+		for (auto _ : state)
+		{
+			LatchType latch(1);
+			latch.ArriveAndWait();
+			benchmark::DoNotOptimize(&latch);
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK_TEMPLATE(Latch_ArriveAndWait, Latch)->UseRealTime();
+	BENCHMARK_TEMPLATE(Latch_ArriveAndWait, StdLatch)->UseRealTime();
+
+	// Arrives at a barrier shared by every benchmark thread and waits for the others each iteration,
+	// which completes a phase without blocking for a single thread
+	template<class BarrierType>
+	static void Barrier_ArriveAndWait(benchmark::State& state)
+	{
+		static std::unique_ptr<BarrierType> barrier;
+		if (state.thread_index() == 0)
+		{
+			barrier = std::make_unique<BarrierType>(static_cast<std::uint32_t>(state.threads()));
+		}
+
+		// Every thread runs the same amount of iterations, so each phase is completed by all of them
+		for (auto _ : state)
+		{
+			barrier->ArriveAndWait();
+		}
+		state.SetItemsProcessed(state.iterations());
+
+		if (state.thread_index() == 0)
+		{
+			barrier.reset();
+		}
+	}
+	BENCHMARK_TEMPLATE(Barrier_ArriveAndWait, Barrier)->ThreadRange(1, MaxThreadCount)->UseRealTime();
+	BENCHMARK_TEMPLATE(Barrier_ArriveAndWait, StdBarrier)->ThreadRange(1, MaxThreadCount)->UseRealTime();
+}
@@ -0,0 +1,41 @@
+#include <Engine/Parallelism/ThreadNotifier.hpp>
+
+// STL includes
+#include <atomic>
+#include <thread>
+// Google Benchmark includes
+#include <benchmark/benchmark.h>
+
+namespace AndGen::Benchmarks
+{
+	// Wakes a waiting thread, and waits for it to wake this thread in turn
+	static void ThreadNotifier_WakeRoundTrip(benchmark::State& state)
+	{
+		ThreadNotifier ping;
+		ThreadNotifier pong;
+		std::atomic_bool isRunning = true;
+		std::thread thread([&ping, &pong, &isRunning]
+		{
+			while (true)
+			{
+				ping.Wait();
+				if (!isRunning.load())
+				{
+					break;
+				}
+				pong.Notify();
+			}
+		});
+
+		for (auto _ : state)
+		{
+			ping.Notify();
+			pong.Wait();
+		}
+
+		isRunning = false;
+		ping.Notify();
+		thread.join();
+	}
+	BENCHMARK(ThreadNotifier_WakeRoundTrip)->UseRealTime();
+}
@@ -0,0 +1,80 @@
+#include <Engine/Parallelism/ThreadPool.hpp>
+
+// STL includes
+#include <atomic>
+#include <chrono>
+#include <thread>
+// Google Benchmark includes
+#include <benchmark/benchmark.h>
+
+namespace AndGen::Benchmarks
+{
+	// Amount of jobs queued for each iteration of throughput benchmarks
+	constexpr int64_t BatchSize = 1024;
+
+	// Queues a batch of empty jobs and waits for them, against the amount of threads in the pool
+	static void ThreadPool_EmptyJobThroughput(benchmark::State& state)
+	{
+		ThreadPool threadPool(static_cast<unsigned int>(state.range(0)));
+
+		for (auto _ : state)
+		{
+			JobCounter counter;
+			for (int64_t i = 0; i < BatchSize; i++)
+			{
+				threadPool.QueueJob([] {}, &counter);
+			}
+			threadPool.Wait(counter);
+		}
+		state.SetItemsProcessed(state.iterations() * BatchSize);
+	}
+	BENCHMARK(ThreadPool_EmptyJobThroughput)->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+
+	// Spawns a batch of empty jobs from within a job and waits for them, against the amount of threads in the pool
+	static void ThreadPool_SpawnThroughput(benchmark::State& state)
+	{
+		ThreadPool threadPool(static_cast<unsigned int>(state.range(0)));
+
+		for (auto _ : state)
+		{
+			JobCounter counter;
+			threadPool.QueueJob([&counter]
+			{
+				for (int64_t i = 0; i < BatchSize; i++)
+				{
+					ThreadPool::Spawn([] {}, &counter);
+				}
+			}, &counter);
+			threadPool.Wait(counter);
+		}
+		state.SetItemsProcessed(state.iterations() * BatchSize);
+	}
+	BENCHMARK(ThreadPool_SpawnThroughput)->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+
+	// Time from queueing a job until a pooled thread starts it, against the amount of threads in the pool
+	static void ThreadPool_StartLatency(benchmark::State& state)
+	{
+		ThreadPool threadPool(static_cast<unsigned int>(state.range(0)));
+		std::atomic<std::chrono::steady_clock::rep> startTime = 0;
+
+		for (auto _ : state)
+		{
+			// Spin rather than waiting on the pool, so this thread doesn't start the job itself
+			startTime.store(0);
+			std::chrono::steady_clock::time_point queueTime = std::chrono::steady_clock::now();
+			threadPool.QueueJob([&startTime]
+			{
+				startTime.store(std::chrono::steady_clock::now().time_since_epoch().count());
+			});
+			while (startTime.load() == 0)
+			{
+				std::this_thread::yield();
+			}
+
+			std::chrono::steady_clock::duration latency =
+				std::chrono::steady_clock::duration(startTime.load()) - queueTime.time_since_epoch();
+			state.SetIterationTime(std::chrono::duration<double>(latency).count());
+		}
+	}
+	BENCHMARK(ThreadPool_StartLatency)->RangeMultiplier(2)->Range(1, 16)->UseManualTime();
+}
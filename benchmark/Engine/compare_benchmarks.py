@@ -0,0 +1,77 @@
+#!/usr/bin/env python3
+"""Compares Google Benchmark JSON results against a baseline, flagging benchmarks which slowed down.
+
+Usage: compare_benchmarks.py <baseline.json> <results.json> [--threshold 0.1] [--metric real_time]
+
+Exits with 1 when any benchmark regressed by more than the threshold, so it can gate changes.
+"""
+
+import argparse
+import json
+import sys
+
+# Time units reported by Google Benchmark, in nanoseconds
+TIME_UNITS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def load_times(path, metric):
+    """Loads the time of each benchmark in a results file, in nanoseconds, by benchmark name."""
+    with open(path, "r", encoding="utf-8") as file:
+        results = json.load(file)
+
+    times = {}
+    for benchmark in results.get("benchmarks", []):
+        # Skip aggregates of repetitions other than the mean
+        if benchmark.get("run_type") == "aggregate" and benchmark.get("aggregate_name") != "mean":
+            continue
+        if "error_occurred" in benchmark or metric not in benchmark:
+            continue
+
+        name = benchmark.get("run_name", benchmark["name"])
+        times[name] = benchmark[metric] * TIME_UNITS[benchmark.get("time_unit", "ns")]
+
+    return times
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("baseline", help="Results to compare against")
+    parser.add_argument("results", help="Results to check")
+    parser.add_argument("--threshold", type=float, default=0.1,
+                        help="Fraction a benchmark may slow down by before it's flagged (default 0.1)")
+    parser.add_argument("--metric", choices=["real_time", "cpu_time"], default="real_time",
+                        help="Time compared for each benchmark (default real_time)")
+    arguments = parser.parse_args()
+
+    baseline = load_times(arguments.baseline, arguments.metric)
+    results = load_times(arguments.results, arguments.metric)
+
+    regressions = []
+    nameWidth = max([len(name) for name in results] + [len("Benchmark")])
+    print(f"{'Benchmark':<{nameWidth}}  {'Baseline':>14}  {'Result':>14}  {'Change':>8}")
+    for name, time in results.items():
+        if name not in baseline:
+            print(f"{name:<{nameWidth}}  {'-':>14}  {time:>12.1f}ns  {'new':>8}")
+            continue
+
+        change = (time - baseline[name]) / baseline[name] if baseline[name] > 0 else 0.0
+        flag = ""
+        if change > arguments.threshold:
+            regressions.append(name)
+            flag = "  REGRESSION"
+        print(f"{name:<{nameWidth}}  {baseline[name]:>12.1f}ns  {time:>12.1f}ns  {change:>+7.1%}{flag}")
+
+    for name in baseline:
+        if name not in results:
+            print(f"{name:<{nameWidth}}  {baseline[name]:>12.1f}ns  {'-':>14}  {'missing':>8}")
+
+    if regressions:
+        print(f"\n{len(regressions)} benchmark(s) regressed by more than {arguments.threshold:.0%}")
+        return 1
+
+    print(f"\nNo benchmarks regressed by more than {arguments.threshold:.0%}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
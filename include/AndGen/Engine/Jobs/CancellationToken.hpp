@@ -0,0 +1,83 @@
+#ifndef CANCELLATIONTOKEN_H
+#define CANCELLATIONTOKEN_H
+
+// STL includes
+#include <atomic>
+
+namespace AndGen
+{
+	/// <summary>
+	/// Flag cancelling a group of jobs, such as all the jobs streaming a single area
+	/// </summary>
+	/// <remarks>
+	/// <para>A token is given to jobs when they're queued. Jobs whose token has been cancelled are skipped when
+	/// taken by a thread, but still complete, so counters and waits are released. Jobs depending on a skipped
+	/// job are skipped as well. Jobs which have already begun aren't interrupted, although long running jobs
+	/// may poll <see cref="IsCancelled"/> to finish early.</para>
+	/// <para>Tokens may have a parent, and are cancelled whenever their parent is, so cancelling a level can cancel
+	/// each of its chunks. Tokens must outlive all jobs queued with them, as with <see cref="JobCounter"/>.</para>
+	/// <para>Cancelled jobs are left within the queues rather than purged from them, as skipping a job costs a
+	/// single check as it's taken, and purging would lock each queue while the pool's threads are taking jobs.
+	/// Functions hold their token within their captures, where queues can't see it. Clearing a queue with
+	/// <see cref="PooledThread::ClearQueue"/> or <see cref="JobQueue::Clear"/> discards all of its jobs instead,
+	/// completing them as cancelled whatever their token.</para>
+	/// </remarks>
+	class CancellationToken
+	{
+	public:
+		/// <summary>
+		/// Constructs a new token which hasn't been cancelled
+		/// </summary>
+		/// <param name="parent">Token which also cancels this token, if any, and must outlive it</param>
+		explicit CancellationToken(const CancellationToken* parent = nullptr) : m_isCancelled(false), m_parent(parent) {}
+		CancellationToken(const CancellationToken&)				= delete;
+		CancellationToken& operator=(const CancellationToken&)	= delete;
+		/// <summary>
+		/// Destroys this token
+		/// </summary>
+		~CancellationToken() = default;
+
+		/// <summary>
+		/// Cancels jobs queued with this token, or any token it's the parent of
+		/// </summary>
+		inline void Cancel()
+		{
+			m_isCancelled.store(true, std::memory_order_relaxed);
+		}
+
+		/// <summary>
+		/// Has this token, or any of its parents, been cancelled?
+		/// </summary>
+		/// <remarks>
+		/// Only reads a flag for each token, so it's cheap enough to poll frequently from within a job.
+		/// </remarks>
+		inline bool IsCancelled() const
+		{
+			for (const CancellationToken* token = this; token != nullptr; token = token->m_parent)
+			{
+				if (token->m_isCancelled.load(std::memory_order_relaxed))
+				{
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		/// <summary>
+		/// Clears this token's cancellation, so it can be reused once all jobs queued with it have completed
+		/// </summary>
+		inline void Reset()
+		{
+			m_isCancelled.store(false, std::memory_order_relaxed);
+		}
+
+	private:
+		// Has this token been cancelled?
+		std::atomic_bool m_isCancelled;
+		// Token which also cancels this token, if any
+		const CancellationToken* m_parent;
+	};
+}
+
+#endif
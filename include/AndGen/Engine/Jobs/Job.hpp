@@ -3,57 +3,183 @@
 
 // STL includes
 #include <atomic>
+#include <chrono>
 #include <memory>
 #include <list>
 #include <vector>
+// AndGen includes
+#include <AndGen/Engine/Jobs/CancellationToken.hpp>
+#include <AndGen/Engine/Jobs/JobCounter.hpp>
+#include <AndGen/Engine/Jobs/JobName.hpp>
+#include <AndGen/Engine/Jobs/JobPriority.hpp>
 
 namespace AndGen
 {
+	// Pre-declarations
+	class ThreadPool;
+
 	/// <summary>
-	/// Abstract class representing a job to be executed by worker threads of the 
+	/// Abstract class representing a job to be executed by worker threads of the
 	/// job system
 	/// </summary>
-	class Job
+	class Job : public std::enable_shared_from_this<Job>
 	{
 	public:
 		/// <summary>
 		/// De-constructs this job
 		/// </summary>
-		virtual ~Job() = default;
+		/// <remarks>
+		/// Jobs depending on this job which never completed, such as a dependency which was never queued, are
+		/// cancelled and released, so they still complete rather than being held indefinitely.
+		/// </remarks>
+		virtual ~Job();
 
 		/// <summary>
 		/// Runs this job and flags this job as completed
 		/// </summary>
+		/// <remarks>
+		/// Once completed, any jobs scheduled to depend on this job and which have no other
+		/// dependencies left are queued to execute. Cancelled jobs are completed without executing,
+		/// and cancel the jobs depending on them.
+		/// </remarks>
 		inline void Run()
 		{
-			// Execute the job (if not already completed)
+			// Execute the job (if not already completed or cancelled)
 			if (!m_isCompleted)
 			{
-				Execute();
+				if (IsCancelled())
+				{
+					m_isCancelled.store(true, std::memory_order_relaxed);
+				}
+				else
+				{
+					Execute();
+				}
 				m_isCompleted = true;
+
+				Internal_Complete();
 			}
 		}
 
+		/// <summary>
+		/// Schedules this job to execute after another job has completed
+		/// </summary>
+		/// <remarks>
+		/// Dependencies must be scheduled before this job is queued with a <see cref="ThreadPool"/>.
+		/// Once queued, this job is held by the thread pool until all of its dependencies have
+		/// completed, then is queued on the thread completing the last dependency.
+		/// Scheduling a dependency on a job which has already completed has no effect.
+		/// </remarks>
+		/// <param name="dependsOn">Job which must complete before this job can execute</param>
+		/// <typeparam name="JobType">Type of job depended on</typeparam>
+		/// <exception cref="std::invalid_argument">Thrown when a job is scheduled to depend on itself</exception>
+		/// <exception cref="std::logic_error">Thrown when this job has already been queued</exception>
 		template<class JobType>
-		void Schedule(std::shared_ptr<JobType> dependsOn);
+		void Schedule(std::shared_ptr<JobType> dependsOn)
+		{
+			Internal_Schedule(std::static_pointer_cast<Job>(dependsOn));
+		}
+		/// <summary>
+		/// Schedules this job to execute after a collection of jobs have completed
+		/// </summary>
+		/// <param name="dependsOn">Jobs which must complete before this job can execute</param>
+		/// <typeparam name="JobType">Type of jobs depended on</typeparam>
 		template<class JobType>
-		void Schedule(std::vector<std::shared_ptr<JobType>> dependsOn);
+		void Schedule(std::vector<std::shared_ptr<JobType>> dependsOn)
+		{
+			for (size_t i = 0; i < dependsOn.size(); i++)
+			{
+				Internal_Schedule(std::static_pointer_cast<Job>(dependsOn[i]));
+			}
+		}
+		/// <summary>
+		/// Schedules this job to execute after a collection of jobs have completed
+		/// </summary>
+		/// <param name="dependsOn">Jobs which must complete before this job can execute</param>
+		/// <typeparam name="JobType">Type of jobs depended on</typeparam>
 		template<class JobType>
-		void Schedule(std::list<std::shared_ptr<JobType>> dependsOn);
+		void Schedule(std::list<std::shared_ptr<JobType>> dependsOn)
+		{
+			for (const std::shared_ptr<JobType>& dependency : dependsOn)
+			{
+				Internal_Schedule(std::static_pointer_cast<Job>(dependency));
+			}
+		}
+
+		/// <summary>
+		/// Sets the token which cancels this job
+		/// </summary>
+		/// <remarks>
+		/// The token must be set before this job is queued with a <see cref="ThreadPool"/>, and must outlive it.
+		/// </remarks>
+		/// <param name="token">Token cancelling this job, or null for none</param>
+		/// <exception cref="std::logic_error">Thrown when this job has already been queued</exception>
+		void SetCancellationToken(const CancellationToken* token);
+
+		/// <summary>
+		/// Names this job, attributing its execution within profiler captures
+		/// </summary>
+		/// <remarks>
+		/// The name must be set before this job is queued with a <see cref="ThreadPool"/>, and must have static
+		/// storage, such as a name declared with <see cref="ANDGEN_JOB_NAME"/>.
+		/// </remarks>
+		/// <param name="name">Name of this job, or null for none</param>
+		/// <exception cref="std::logic_error">Thrown when this job has already been queued</exception>
+		void SetName(const JobName* name);
+
+		/// <summary>
+		/// Name of this job, if any
+		/// </summary>
+		inline const JobName* GetName() const
+		{
+			return m_name;
+		}
+
+		/// <summary>
+		/// Has this job been cancelled, either by its token or by a job it depends on being cancelled?
+		/// </summary>
+		/// <remarks>
+		/// Cheap enough to poll frequently from within <see cref="Execute"/>, to finish early once cancelled.
+		/// </remarks>
+		inline bool IsCancelled() const
+		{
+			return m_isCancelled.load(std::memory_order_relaxed) ||
+				(m_cancellationToken != nullptr && m_cancellationToken->IsCancelled());
+		}
 
 		/// <summary>
 		/// Has this job been completed?
 		/// </summary>
+		/// <remarks>
+		/// Cancelled jobs are completed once skipped, see <see cref="IsCancelled"/>.
+		/// </remarks>
 		inline bool IsCompleted() const
 		{
 			return m_isCompleted;
 		}
 
+		/// <summary>
+		/// Amount of dependencies which haven't completed yet
+		/// </summary>
+		inline int PendingDependenciesCount() const
+		{
+			// Exclude the count held until this job is queued
+			int pendingDependencies = m_pendingDependencies.load(std::memory_order_acquire);
+			return m_threadPool.load(std::memory_order_acquire) == nullptr ? pendingDependencies - 1 : pendingDependencies;
+		}
+
 	protected:
 		/// <summary>
 		/// Constructs a new job
 		/// </summary>
-		Job() : m_isCompleted(false) {}
+		Job() : Job(nullptr) {}
+		/// <summary>
+		/// Constructs a new named job
+		/// </summary>
+		/// <param name="name">Name of the job, with static storage</param>
+		explicit Job(const JobName* name) : m_isCompleted(false), m_isCancelled(false), m_pendingDependencies(1),
+			m_successors(nullptr), m_threadPool(nullptr), m_counter(nullptr), m_cancellationToken(nullptr),
+			m_name(name), m_priority(JobPriority::Frame), m_deadline(std::chrono::steady_clock::time_point::max()) {}
 		Job(const Job&) = delete;
 
 		/// <summary>
@@ -62,13 +188,68 @@ namespace AndGen
 		virtual void Execute() = 0;
 
 	private:
+		friend class JobRecord;
+		friend class ThreadPool;
+
+		/// <summary>
+		/// Node within the list of jobs depending on a job
+		/// </summary>
+		struct Successor
+		{
+			// Job depending on the job owning this node
+			std::shared_ptr<Job> job;
+			// Next node in the list
+			Successor* next;
+
+			// Nodes are allocated from recycled pools, rather than the heap
+			static void* operator new(size_t size);
+			static void operator delete(void* node, size_t size);
+		};
+
 		// Is this job currently completed?
 		std::atomic_bool m_isCompleted;
+		// Was this job skipped, or has a job it depends on been skipped?
+		std::atomic_bool m_isCancelled;
+
+		// Amount of dependencies which must complete before this job can be executed,
+		// plus one which is held until this job is queued
+		std::atomic_int m_pendingDependencies;
+		// Lock-free list of jobs depending on this job,
+		// which is closed once this job has completed
+		std::atomic<Successor*> m_successors;
+		// Thread pool this job was queued with, if any
+		std::atomic<ThreadPool*> m_threadPool;
+		// Counter given when this job was queued, if any
+		JobCounter* m_counter;
+		// Token cancelling this job, if any
+		const CancellationToken* m_cancellationToken;
+		// Name of this job, if any
+		const JobName* m_name;
+		// Priority given when this job was queued
+		JobPriority m_priority;
+		// Deadline given when this job was queued, or the latest time for none
+		std::chrono::steady_clock::time_point m_deadline;
 
-		// Jobs this job depends on being completed to execute
-		std::vector<Job*> m_dependencies;
+		// Marks the end of a successor list for a completed job
+		static Successor s_completedSuccessors;
 
+		// Adds this job to the successors of another job
 		void Internal_Schedule(std::shared_ptr<Job> dependsOn);
+		// Releases the count held until queued, returning true if this job is ready to execute
+		bool Internal_Queue(ThreadPool& threadPool, JobCounter* counter, JobPriority priority,
+			std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max());
+		// Releases jobs depending on this job, cancelling them if this job was cancelled and queueing those
+		// with no dependencies left, and decrements counters this job was queued with
+		void Internal_Complete();
+		// Releases a list of successors, cancelling them if requested and queueing those with no dependencies left
+		static void Internal_ReleaseSuccessors(Successor* successor, bool isCancelled);
+
+		// Completes this job as cancelled without executing it, once it has been discarded from a queue
+		inline void Internal_Discard()
+		{
+			m_isCancelled.store(true, std::memory_order_relaxed);
+			Run();
+		}
 	};
 }
 
@@ -0,0 +1,96 @@
+#ifndef JOBCOUNTER_H
+#define JOBCOUNTER_H
+
+// STL includes
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace AndGen
+{
+	/// <summary>
+	/// Counts jobs which have been queued together but haven't completed yet
+	/// </summary>
+	/// <remarks>
+	/// A counter is given to a <see cref="ThreadPool"/> when queueing jobs, and is incremented for each
+	/// job queued and decremented as each job completes. Waiting on a counter through the thread pool
+	/// executes queued jobs on the waiting thread until the counter reaches zero, blocking once there's
+	/// nothing left to execute until the decrement reaching zero wakes it. Counters must outlive all jobs
+	/// queued with them.
+	/// </remarks>
+	class JobCounter
+	{
+	public:
+		/// <summary>
+		/// Constructs a new job counter with no jobs
+		/// </summary>
+		JobCounter() : m_count(0) {}
+		JobCounter(const JobCounter&)				= delete;
+		JobCounter& operator=(const JobCounter&)	= delete;
+		/// <summary>
+		/// Destroys this job counter
+		/// </summary>
+		~JobCounter() = default;
+
+		/// <summary>
+		/// Amount of jobs which haven't completed yet
+		/// </summary>
+		inline unsigned int Count() const
+		{
+			return m_count.load(std::memory_order_acquire) & ~WaitingFlag;
+		}
+
+		/// <summary>
+		/// Have all jobs counted been completed?
+		/// </summary>
+		inline bool IsComplete() const
+		{
+			return Count() == 0;
+		}
+
+		/// <summary>
+		/// Counts jobs which have been queued
+		/// </summary>
+		/// <param name="count">Amount of jobs queued</param>
+		inline void Increment(unsigned int count = 1)
+		{
+			m_count.fetch_add(count, std::memory_order_relaxed);
+		}
+
+		/// <summary>
+		/// Counts jobs which have completed
+		/// </summary>
+		/// <param name="count">Amount of jobs completed</param>
+		inline void Decrement(unsigned int count = 1)
+		{
+			// Only wake threads blocked waiting once the last job completes, pairing with Internal_Park(),
+			// without reading the counter again as a waiting thread may destroy it once the count reaches zero
+			if (m_count.fetch_sub(count, std::memory_order_acq_rel) == (count | WaitingFlag))
+			{
+				WakeWaiters();
+			}
+		}
+
+	private:
+		friend class ThreadPool;
+
+		// Set alongside the count while threads are blocked, or about to block, waiting for it to reach zero
+		static constexpr std::uint32_t WaitingFlag = 0x80000000u;
+
+		// Amount of jobs which haven't completed yet, plus the waiting flag,
+		// kept on its own cache line as it's written by every completing thread
+		alignas(64) mutable std::atomic<std::uint32_t> m_count;
+
+		// Wakes all threads blocked waiting for the count to reach zero
+		void WakeWaiters();
+
+		// Blocks the calling thread until the count reaches zero, or it's woken spuriously
+		void Internal_Park() const;
+		// Blocks the calling thread until the count reaches zero, a timeout passes, or it's woken spuriously
+		void Internal_ParkFor(std::chrono::nanoseconds timeout) const;
+		// Clears the waiting flag once the count has reached zero, so completing the counter again doesn't wake anything
+		void ClearWaitingFlag() const;
+	};
+}
+
+#endif
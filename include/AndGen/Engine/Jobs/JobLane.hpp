@@ -0,0 +1,27 @@
+#ifndef JOBLANE_H
+#define JOBLANE_H
+
+namespace AndGen
+{
+	/// <summary>
+	/// Set of threads a job is executed by, given when the job is queued
+	/// </summary>
+	/// <remarks>
+	/// Jobs which block, such as reading files, should be queued on the I/O lane, so they never occupy the
+	/// threads executing jobs for the frame. Jobs depending on an I/O job are still queued on their own lane
+	/// once it completes.
+	/// </remarks>
+	enum class JobLane
+	{
+		/// <summary>
+		/// Jobs executed by the thread pool's own threads
+		/// </summary>
+		Compute,
+		/// <summary>
+		/// Jobs executed by the thread pool's separate I/O threads, which spend most of their time blocked
+		/// </summary>
+		IO
+	};
+}
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef JOBNAME_H
+#define JOBNAME_H
+
+// STL includes
+#include <cstdint>
+#include <source_location>
+
+/// <summary>
+/// Pointer to a static <see cref="AndGen::JobName"/> with a given name and the location the macro is used at
+/// </summary>
+#define ANDGEN_JOB_NAME(name) \
+	([]() -> const ::AndGen::JobName* { static constexpr ::AndGen::JobName jobName(name); return &jobName; }())
+
+namespace AndGen
+{
+	/// <summary>
+	/// Static name and source location identifying a type of job, or a profiling zone within a job
+	/// </summary>
+	/// <remarks>
+	/// Names are declared as constants with static storage, such as with <see cref="ANDGEN_JOB_NAME"/>, and
+	/// are referred to by pointer, so naming a job copies no strings. Named jobs are attributed by name within
+	/// captures of the <see cref="JobProfiler"/>, rather than as anonymous jobs.
+	/// </remarks>
+	struct JobName
+	{
+		/// <summary>
+		/// Constructs a name, at the location it's declared at
+		/// </summary>
+		/// <param name="name">Name, which must have static storage such as a string literal</param>
+		/// <param name="location">Location within the source code, defaulting to where the name is declared</param>
+		explicit constexpr JobName(const char* name,
+			std::source_location location = std::source_location::current()) :
+			name(name), file(location.file_name()), line(location.line()) {}
+
+		/// <summary>
+		/// Name of the job or zone, such as the system it's part of
+		/// </summary>
+		const char* name;
+		/// <summary>
+		/// Source file declaring the name
+		/// </summary>
+		const char* file;
+		/// <summary>
+		/// Line within the source file declaring the name
+		/// </summary>
+		std::uint_least32_t line;
+	};
+}
+
+#endif
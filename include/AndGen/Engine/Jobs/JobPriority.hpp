@@ -0,0 +1,42 @@
+#ifndef JOBPRIORITY_H
+#define JOBPRIORITY_H
+
+// STL includes
+#include <cstddef>
+
+namespace AndGen
+{
+	/// <summary>
+	/// Priority of a job queued within the job system, from highest to lowest
+	/// </summary>
+	/// <remarks>
+	/// Threads always take jobs from the highest priority with jobs waiting, although lower priorities
+	/// are aged so they're still served periodically while higher priorities are busy.
+	/// </remarks>
+	enum class JobPriority
+	{
+		/// <summary>
+		/// Jobs which the current frame is blocked on, executed before any other job
+		/// </summary>
+		Critical,
+		/// <summary>
+		/// Jobs which must complete within the current frame
+		/// </summary>
+		Frame,
+		/// <summary>
+		/// Jobs which may span several frames, such as streaming assets
+		/// </summary>
+		Background,
+		/// <summary>
+		/// Jobs executed only while there's no other work
+		/// </summary>
+		Idle
+	};
+
+	/// <summary>
+	/// Amount of job priorities
+	/// </summary>
+	constexpr size_t JobPriorityCount = static_cast<size_t>(JobPriority::Idle) + 1;
+}
+
+#endif
@@ -0,0 +1,183 @@
+#ifndef RESULTJOB_H
+#define RESULTJOB_H
+
+// STL includes
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+// AndGen includes
+#include <AndGen/Engine/Jobs/Job.hpp>
+#include <AndGen/Engine/Jobs/JobCounter.hpp>
+
+namespace AndGen
+{
+	// Pre-declarations
+	template<class T>
+	class JobFuture;
+
+	/// <summary>
+	/// Abstract job producing a value, which is stored inline within the job
+	/// </summary>
+	/// <remarks>
+	/// The value is held alongside the job itself, so creating the job with std::make_shared allocates once,
+	/// with no separate shared state or locking as with std::promise. Results are read once the job has
+	/// completed, either by waiting on a counter it was queued with or through a <see cref="JobFuture"/>.
+	/// </remarks>
+	/// <typeparam name="T">Type of value produced</typeparam>
+	template<class T>
+	class ResultJob : public Job
+	{
+		static_assert(!std::is_reference<T>::value, "Jobs cannot produce references");
+
+	public:
+		/// <summary>
+		/// De-constructs this job, and its value if produced
+		/// </summary>
+		virtual ~ResultJob() = default;
+
+		/// <summary>
+		/// Has this job produced its value?
+		/// </summary>
+		/// <remarks>
+		/// Jobs which were cancelled complete without producing a value.
+		/// </remarks>
+		inline bool HasResult() const
+		{
+			return IsCompleted() && m_result.has_value();
+		}
+
+		/// <summary>
+		/// The value produced by this job
+		/// </summary>
+		/// <exception cref="std::logic_error">Thrown when the job hasn't completed, or was cancelled</exception>
+		inline T& GetResult()
+		{
+			if (!HasResult())
+			{
+				throw std::logic_error("Job has not produced a result");
+			}
+
+			return *m_result;
+		}
+		/// <summary>
+		/// The value produced by this job
+		/// </summary>
+		/// <exception cref="std::logic_error">Thrown when the job hasn't completed, or was cancelled</exception>
+		inline const T& GetResult() const
+		{
+			if (!HasResult())
+			{
+				throw std::logic_error("Job has not produced a result");
+			}
+
+			return *m_result;
+		}
+
+	protected:
+		/// <summary>
+		/// Constructs a new job
+		/// </summary>
+		ResultJob() : Job() {}
+		/// <summary>
+		/// Constructs a new named job
+		/// </summary>
+		/// <param name="name">Name of the job, with static storage</param>
+		explicit ResultJob(const JobName* name) : Job(name) {}
+		ResultJob(const ResultJob&) = delete;
+
+		/// <summary>
+		/// Work to be executed on the work threads, producing the job's value
+		/// </summary>
+		virtual T Compute() = 0;
+
+	private:
+		template<class>
+		friend class JobFuture;
+
+		// Value produced by this job, once executed
+		std::optional<T> m_result;
+		// Counts this job while queued through a future, so it can be waited on
+		JobCounter m_futureCounter;
+
+		// Stores the value produced by this job
+		virtual void Execute() override final
+		{
+			m_result.emplace(Compute());
+		}
+	};
+
+	/// <summary>
+	/// Abstract job producing no value, which may be waited on and continued through a <see cref="JobFuture"/>
+	/// </summary>
+	/// <remarks>
+	/// Used for continuations returning nothing. Jobs which aren't waited on through a future should derive
+	/// from <see cref="Job"/>.
+	/// </remarks>
+	template<>
+	class ResultJob<void> : public Job
+	{
+	public:
+		/// <summary>
+		/// De-constructs this job
+		/// </summary>
+		virtual ~ResultJob() = default;
+
+		/// <summary>
+		/// Has this job executed?
+		/// </summary>
+		/// <remarks>
+		/// Jobs which were cancelled complete without executing.
+		/// </remarks>
+		inline bool HasResult() const
+		{
+			return IsCompleted() && m_hasExecuted;
+		}
+
+		/// <summary>
+		/// Ensures this job has executed
+		/// </summary>
+		/// <exception cref="std::logic_error">Thrown when the job hasn't completed, or was cancelled</exception>
+		inline void GetResult() const
+		{
+			if (!HasResult())
+			{
+				throw std::logic_error("Job has not produced a result");
+			}
+		}
+
+	protected:
+		/// <summary>
+		/// Constructs a new job
+		/// </summary>
+		ResultJob() : Job(), m_hasExecuted(false) {}
+		/// <summary>
+		/// Constructs a new named job
+		/// </summary>
+		/// <param name="name">Name of the job, with static storage</param>
+		explicit ResultJob(const JobName* name) : Job(name), m_hasExecuted(false) {}
+		ResultJob(const ResultJob&) = delete;
+
+		/// <summary>
+		/// Work to be executed on the work threads
+		/// </summary>
+		virtual void Compute() = 0;
+
+	private:
+		template<class>
+		friend class JobFuture;
+
+		// Has this job executed?
+		bool m_hasExecuted;
+		// Counts this job while queued through a future, so it can be waited on
+		JobCounter m_futureCounter;
+
+		// Executes this job, recording that it wasn't cancelled
+		virtual void Execute() override final
+		{
+			Compute();
+			m_hasExecuted = true;
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,301 @@
+#include "HardwareCounters.hpp"
+
+// STL includes
+#include <array>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#if defined(__linux__)
+// Linux includes
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Counters within each thread's group, the first of which leads the group
+enum class Counter
+{
+	Cycles,
+	Instructions,
+	L1DataMisses,
+	LastLevelCacheMisses,
+	BranchMisses,
+	Count
+};
+
+// Amount of counters within each thread's group
+static constexpr size_t CounterCount = static_cast<size_t>(Counter::Count);
+static_assert(CounterCount == AndGen::HardwareCounters::CounterCount, "Every counter should be read into a scope");
+
+// Values of each counter, by counter
+using CounterValues = AndGen::HardwareCounters::CounterValues;
+
+// Totals of each type of job sampled by a thread, kept once the thread has exited
+struct ThreadTotals
+{
+	// Guards the totals, only contended while they're being gathered or reset
+	std::mutex mutex;
+	// Totals of each type of job, by the job's name
+	std::unordered_map<const AndGen::JobName*, AndGen::HardwareCounterTotals> jobs;
+};
+
+// Totals of every thread which has sampled jobs
+struct Registry
+{
+	// Guards the threads
+	std::mutex mutex;
+	// Totals of each thread which has opened its counters
+	std::vector<std::shared_ptr<ThreadTotals>> threads;
+};
+
+// Returns the totals of every thread which has sampled jobs
+static Registry& GetRegistry()
+{
+	static Registry registry;
+	return registry;
+}
+
+// Group of counters opened by a thread, closed once the thread exits
+class ThreadCounters
+{
+public:
+	ThreadCounters()
+	{
+		m_files.fill(-1);
+		m_positions.fill(-1);
+	}
+	ThreadCounters(const ThreadCounters&)				= delete;
+	ThreadCounters& operator=(const ThreadCounters&)	= delete;
+	~ThreadCounters()
+	{
+#if defined(__linux__)
+		for (int file : m_files)
+		{
+			if (file >= 0)
+			{
+				close(file);
+			}
+		}
+#endif
+	}
+
+	// Opens the group of counters, if it hasn't been attempted yet, returning whether it's open
+	bool Open()
+	{
+		if (!m_hasAttempted)
+		{
+			m_hasAttempted	= true;
+			m_isOpen		= OpenGroup();
+			if (m_isOpen)
+			{
+				m_totals = std::make_shared<ThreadTotals>();
+
+				Registry& registry = GetRegistry();
+				std::scoped_lock<std::mutex> lock(registry.mutex);
+				registry.threads.push_back(m_totals);
+			}
+		}
+
+		return m_isOpen;
+	}
+
+	// Reads the counters as a job begins, returning false if they can't be read
+	bool BeginJob(CounterValues& beginning)
+	{
+		return Open() && Read(beginning);
+	}
+
+	// Reads the counters as a job ends, adding the difference since it began to the totals of its name
+	void EndJob(const AndGen::JobName* name, const CounterValues& beginning)
+	{
+		CounterValues end;
+		if (!Read(end))
+		{
+			return;
+		}
+
+		std::scoped_lock<std::mutex> lock(m_totals->mutex);
+		AndGen::HardwareCounterTotals& totals = m_totals->jobs[name];
+		totals.jobs++;
+		totals.cycles				+= end[static_cast<size_t>(Counter::Cycles)] -
+			beginning[static_cast<size_t>(Counter::Cycles)];
+		totals.instructions			+= end[static_cast<size_t>(Counter::Instructions)] -
+			beginning[static_cast<size_t>(Counter::Instructions)];
+		totals.l1DataMisses			+= end[static_cast<size_t>(Counter::L1DataMisses)] -
+			beginning[static_cast<size_t>(Counter::L1DataMisses)];
+		totals.lastLevelCacheMisses	+= end[static_cast<size_t>(Counter::LastLevelCacheMisses)] -
+			beginning[static_cast<size_t>(Counter::LastLevelCacheMisses)];
+		totals.branchMisses			+= end[static_cast<size_t>(Counter::BranchMisses)] -
+			beginning[static_cast<size_t>(Counter::BranchMisses)];
+	}
+
+private:
+	// File of each counter, or -1 if it couldn't be opened
+	std::array<int, CounterCount> m_files;
+	// Position of each counter's value when reading the group, or -1 if it couldn't be opened
+	std::array<int, CounterCount> m_positions;
+	// Amount of counters opened within the group
+	int m_openCount		= 0;
+	// Has opening the group been attempted?
+	bool m_hasAttempted	= false;
+	// Is the group open?
+	bool m_isOpen		= false;
+	// Totals of each type of job sampled by the thread
+	std::shared_ptr<ThreadTotals> m_totals;
+
+#if defined(__linux__)
+	// Opens a counter of the calling thread, within the group led by a given file
+	static int OpenCounter(std::uint32_t type, std::uint64_t config, int groupFile)
+	{
+		perf_event_attr attributes	= {};
+		attributes.size				= sizeof(attributes);
+		attributes.type				= type;
+		attributes.config			= config;
+		attributes.disabled			= groupFile < 0 ? 1 : 0;
+		attributes.exclude_kernel	= 1;
+		attributes.exclude_hv		= 1;
+		attributes.read_format		= PERF_FORMAT_GROUP;
+
+		return static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, groupFile, 0));
+	}
+
+	// Opens the group of counters, led by the cycle counter, skipping any other counters which can't be opened
+	bool OpenGroup()
+	{
+		constexpr std::uint64_t CacheReadMiss = (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+			(PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+		constexpr std::array<std::pair<std::uint32_t, std::uint64_t>, CounterCount> Events =
+		{{
+			{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+			{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+			{ PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | CacheReadMiss },
+			{ PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_LL | CacheReadMiss },
+			{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES }
+		}};
+
+		for (size_t i = 0; i < CounterCount; i++)
+		{
+			m_files[i] = OpenCounter(Events[i].first, Events[i].second, m_files[0]);
+			if (m_files[i] >= 0)
+			{
+				m_positions[i] = m_openCount++;
+			}
+			else if (i == 0)
+			{
+				// Without the leader, such as when perf_event_paranoid forbids access, nothing can be counted
+				return false;
+			}
+		}
+
+		return ioctl(m_files[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP) == 0;
+	}
+
+	// Reads every counter within the group at once, leaving counters which couldn't be opened at zero
+	bool Read(CounterValues& values) const
+	{
+		// Group reads begin with the amount of counters, followed by each counter's value
+		std::array<std::uint64_t, CounterCount + 1> buffer;
+		ssize_t size = read(m_files[0], buffer.data(), sizeof(buffer));
+		if (size < static_cast<ssize_t>(sizeof(std::uint64_t) * (m_openCount + 1)) ||
+			buffer[0] != static_cast<std::uint64_t>(m_openCount))
+		{
+			return false;
+		}
+
+		for (size_t i = 0; i < CounterCount; i++)
+		{
+			values[i] = m_positions[i] >= 0 ? buffer[m_positions[i] + 1] : 0;
+		}
+
+		return true;
+	}
+#else
+	// Hardware counters are only sampled with Linux perf_event counters
+	bool OpenGroup()
+	{
+		return false;
+	}
+
+	// Hardware counters are only sampled with Linux perf_event counters
+	bool Read(CounterValues&) const
+	{
+		return false;
+	}
+#endif
+};
+
+// Counters of the calling thread, opened on the first job it samples
+static thread_local ThreadCounters s_threadCounters;
+
+// Are jobs currently sampled?
+std::atomic_bool AndGen::HardwareCounters::s_isEnabled = false;
+
+// Begins sampling the jobs executed by every thread
+void AndGen::HardwareCounters::Enable()
+{
+	s_isEnabled.store(true, std::memory_order_relaxed);
+}
+
+// Stops sampling jobs
+void AndGen::HardwareCounters::Disable()
+{
+	s_isEnabled.store(false, std::memory_order_relaxed);
+}
+
+// Can the calling thread open its hardware counters?
+bool AndGen::HardwareCounters::IsAvailable()
+{
+	return s_threadCounters.Open();
+}
+
+// Totals of each type of job sampled by every thread, since last reset
+std::vector<AndGen::HardwareCounters::JobTypeTotals> AndGen::HardwareCounters::GetJobTotals()
+{
+	std::unordered_map<const JobName*, HardwareCounterTotals> jobs;
+
+	Registry& registry = GetRegistry();
+	std::scoped_lock<std::mutex> lock(registry.mutex);
+	for (const std::shared_ptr<ThreadTotals>& thread : registry.threads)
+	{
+		std::scoped_lock<std::mutex> threadLock(thread->mutex);
+		for (const auto& [name, totals] : thread->jobs)
+		{
+			jobs[name] += totals;
+		}
+	}
+
+	std::vector<JobTypeTotals> jobTotals;
+	jobTotals.reserve(jobs.size());
+	for (const auto& [name, totals] : jobs)
+	{
+		jobTotals.push_back({ name, totals });
+	}
+
+	return jobTotals;
+}
+
+// Clears the totals of each type of job
+void AndGen::HardwareCounters::ResetJobTotals()
+{
+	Registry& registry = GetRegistry();
+	std::scoped_lock<std::mutex> lock(registry.mutex);
+	for (const std::shared_ptr<ThreadTotals>& thread : registry.threads)
+	{
+		std::scoped_lock<std::mutex> threadLock(thread->mutex);
+		thread->jobs.clear();
+	}
+}
+
+// Reads the calling thread's counters as a job begins
+bool AndGen::HardwareCounters::BeginJob(CounterValues& beginning)
+{
+	return s_threadCounters.BeginJob(beginning);
+}
+
+// Reads the calling thread's counters as a job ends
+void AndGen::HardwareCounters::EndJob(const JobName* name, const CounterValues& beginning)
+{
+	s_threadCounters.EndJob(name, beginning);
+}
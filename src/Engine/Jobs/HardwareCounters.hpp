@@ -0,0 +1,197 @@
+#ifndef HARDWARECOUNTERS_H
+#define HARDWARECOUNTERS_H
+
+// STL includes
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+// AndGen includes
+#include <AndGen/Engine/Jobs/JobName.hpp>
+
+namespace AndGen
+{
+	/// <summary>
+	/// Totals of the hardware counters measured while executing jobs
+	/// </summary>
+	/// <remarks>
+	/// Counters which the processor or the system doesn't support are left at zero.
+	/// </remarks>
+	struct HardwareCounterTotals
+	{
+		/// <summary>
+		/// Amount of jobs measured
+		/// </summary>
+		std::uint64_t jobs					= 0;
+		/// <summary>
+		/// Processor cycles, while executing in user space
+		/// </summary>
+		std::uint64_t cycles				= 0;
+		/// <summary>
+		/// Instructions retired, while executing in user space
+		/// </summary>
+		std::uint64_t instructions			= 0;
+		/// <summary>
+		/// Reads missing the level 1 data cache
+		/// </summary>
+		std::uint64_t l1DataMisses			= 0;
+		/// <summary>
+		/// Reads missing the last level cache
+		/// </summary>
+		std::uint64_t lastLevelCacheMisses	= 0;
+		/// <summary>
+		/// Branches mispredicted
+		/// </summary>
+		std::uint64_t branchMisses			= 0;
+
+		/// <summary>
+		/// Instructions retired per cycle, or zero if no cycles were counted
+		/// </summary>
+		inline double InstructionsPerCycle() const
+		{
+			return cycles > 0 ? static_cast<double>(instructions) / static_cast<double>(cycles) : 0.0;
+		}
+
+		/// <summary>
+		/// Adds the totals of other jobs to these totals
+		/// </summary>
+		/// <param name="other">Totals to add</param>
+		HardwareCounterTotals& operator+=(const HardwareCounterTotals& other)
+		{
+			jobs					+= other.jobs;
+			cycles					+= other.cycles;
+			instructions			+= other.instructions;
+			l1DataMisses			+= other.l1DataMisses;
+			lastLevelCacheMisses	+= other.lastLevelCacheMisses;
+			branchMisses			+= other.branchMisses;
+
+			return *this;
+		}
+	};
+
+	/// <summary>
+	/// Samples the processor's hardware counters around each job, totalling them by the job's name
+	/// </summary>
+	/// <remarks>
+	/// <para>While enabled, each thread executing a <see cref="Job"/>, such as a <see cref="PooledThread"/>, opens
+	/// its own group of Linux perf_event counters on the first job it executes, then reads them as each job
+	/// begins and ends. Jobs are totalled by their <see cref="JobName"/>, giving the instructions per cycle
+	/// and cache misses of each type of job. Counts of jobs executed while another job waits are included
+	/// within both jobs.</para>
+	/// <para>Reading the counters takes a system call, so sampling is a diagnostic mode which slows small jobs
+	/// considerably. It's only compiled into the thread pool with the <c>ANDGEN_HARDWARE_COUNTERS</c>
+	/// option. Threads which can't open the counters, such as when perf_event_paranoid forbids it or on
+	/// systems other than Linux, execute their jobs without sampling them.</para>
+	/// </remarks>
+	class HardwareCounters
+	{
+	public:
+		/// <summary>
+		/// Amount of counters within each thread's group
+		/// </summary>
+		static constexpr size_t CounterCount = 5;
+		/// <summary>
+		/// Values read from each counter of a thread's group
+		/// </summary>
+		using CounterValues = std::array<std::uint64_t, CounterCount>;
+
+		/// <summary>
+		/// Totals of a type of job, identified by its name
+		/// </summary>
+		struct JobTypeTotals
+		{
+			/// <summary>
+			/// Name of the type of job, or null for jobs which weren't named
+			/// </summary>
+			const JobName* name;
+			/// <summary>
+			/// Totals of the jobs of this type
+			/// </summary>
+			HardwareCounterTotals totals;
+		};
+
+		/// <summary>
+		/// Begins sampling the jobs executed by every thread
+		/// </summary>
+		static void Enable();
+		/// <summary>
+		/// Stops sampling jobs, leaving each thread's counters open to resume sampling later
+		/// </summary>
+		static void Disable();
+
+		/// <summary>
+		/// Are jobs currently sampled?
+		/// </summary>
+		static inline bool IsEnabled()
+		{
+			return s_isEnabled.load(std::memory_order_relaxed);
+		}
+
+		/// <summary>
+		/// Can the calling thread open its hardware counters?
+		/// </summary>
+		/// <remarks>
+		/// Opens the calling thread's counters if they haven't been opened yet. Returns false when the system
+		/// doesn't allow access to hardware counters, in which case jobs executed by the thread aren't sampled.
+		/// </remarks>
+		static bool IsAvailable();
+
+		/// <summary>
+		/// Totals of each type of job sampled by every thread, since last reset
+		/// </summary>
+		static std::vector<JobTypeTotals> GetJobTotals();
+		/// <summary>
+		/// Clears the totals of each type of job
+		/// </summary>
+		static void ResetJobTotals();
+
+		/// <summary>
+		/// Samples the calling thread's counters for the lifetime of a job's execution
+		/// </summary>
+		/// <remarks>
+		/// The values read as the job begins are kept by the scope, so jobs on fibers of the same thread may end
+		/// in any order.
+		/// </remarks>
+		class JobScope
+		{
+		public:
+			/// <summary>
+			/// Reads the counters as the job begins, if sampling is enabled
+			/// </summary>
+			/// <param name="name">Name of the job, if any</param>
+			explicit JobScope(const JobName* name) : m_name(name),
+				m_isSampling(HardwareCounters::IsEnabled() && HardwareCounters::BeginJob(m_beginning)) {}
+			JobScope(const JobScope&)				= delete;
+			JobScope& operator=(const JobScope&)	= delete;
+			/// <summary>
+			/// Reads the counters as the job ends, adding the difference to the totals of the job's name
+			/// </summary>
+			~JobScope()
+			{
+				if (m_isSampling)
+				{
+					HardwareCounters::EndJob(m_name, m_beginning);
+				}
+			}
+
+		private:
+			// Name of the job
+			const JobName* m_name;
+			// Values of the counters as the job began, if sampling
+			CounterValues m_beginning;
+			// Were the counters read as the job began?
+			bool m_isSampling;
+		};
+
+	private:
+		// Are jobs currently sampled?
+		static std::atomic_bool s_isEnabled;
+
+		// Reads the calling thread's counters as a job begins, returning false if they can't be read
+		static bool BeginJob(CounterValues& beginning);
+		// Reads the calling thread's counters as a job ends, adding the difference to the totals of its name
+		static void EndJob(const JobName* name, const CounterValues& beginning);
+	};
+}
+
+#endif
@@ -1,9 +1,157 @@
 #include <AndGen/Engine/Jobs/Job.hpp>
 
+// STL includes
+#include <stdexcept>
 // AndGen includes
 #include <AndGen/Exceptions/NotImplementedException.hpp>
+#include "../Parallelism/ThreadPool.hpp"
+#include "TaskFrameAllocator.hpp"
 
+// Marks the end of a successor list for a completed job
+AndGen::Job::Successor AndGen::Job::s_completedSuccessors = { nullptr, nullptr };
+
+// Allocates a node within the list of jobs depending on a job
+void* AndGen::Job::Successor::operator new(size_t size)
+{
+	return TaskFrameAllocator::Allocate(size);
+}
+
+// Returns a node within the list of jobs depending on a job
+void AndGen::Job::Successor::operator delete(void* node, size_t size)
+{
+	TaskFrameAllocator::Deallocate(node, size);
+}
+
+// De-constructs this job
+AndGen::Job::~Job()
+{
+	// Cancel jobs which were waiting on this job if it never completed, so they're still released
+	Internal_ReleaseSuccessors(m_successors.exchange(&s_completedSuccessors, std::memory_order_acq_rel), true);
+}
+
+// Adds this job to the successors of another job
 void AndGen::Job::Internal_Schedule(std::shared_ptr<AndGen::Job> dependsOn)
 {
-	throw NotImplementedException();
+	// Ignore null dependencies
+	if (dependsOn == nullptr)
+	{
+		return;
+	}
+
+	if (dependsOn.get() == this)
+	{
+		throw std::invalid_argument("A job cannot depend on itself");
+	}
+	if (m_threadPool.load(std::memory_order_acquire) != nullptr)
+	{
+		throw std::logic_error("Dependencies cannot be scheduled once a job has been queued");
+	}
+
+	// Count dependency before it can be released by the other job completing
+	m_pendingDependencies.fetch_add(1, std::memory_order_relaxed);
+
+	// Push onto the other job's successors, unless it has already completed
+	Successor* successor	= new Successor{ shared_from_this(), nullptr };
+	Successor* head			= dependsOn->m_successors.load(std::memory_order_acquire);
+	do
+	{
+		if (head == &s_completedSuccessors)
+		{
+			// Dependency already completed, so there's nothing to wait for
+			delete successor;
+			m_pendingDependencies.fetch_sub(1, std::memory_order_relaxed);
+
+			return;
+		}
+
+		successor->next = head;
+	} while (!dependsOn->m_successors.compare_exchange_weak(head, successor,
+		std::memory_order_release, std::memory_order_acquire));
+}
+
+// Sets the token which cancels this job
+void AndGen::Job::SetCancellationToken(const AndGen::CancellationToken* token)
+{
+	if (m_threadPool.load(std::memory_order_acquire) != nullptr)
+	{
+		throw std::logic_error("Cancellation tokens cannot be set once a job has been queued");
+	}
+
+	m_cancellationToken = token;
+}
+
+// Names this job, attributing its execution within profiler captures
+void AndGen::Job::SetName(const AndGen::JobName* name)
+{
+	if (m_threadPool.load(std::memory_order_acquire) != nullptr)
+	{
+		throw std::logic_error("Names cannot be set once a job has been queued");
+	}
+
+	m_name = name;
+}
+
+// Releases the count held until queued, returning true if this job is ready to execute
+bool AndGen::Job::Internal_Queue(AndGen::ThreadPool& threadPool, AndGen::JobCounter* counter,
+	AndGen::JobPriority priority, std::chrono::steady_clock::time_point deadline)
+{
+	// Ignore jobs which have already been queued
+	ThreadPool* expectedThreadPool = nullptr;
+	if (!m_threadPool.compare_exchange_strong(expectedThreadPool, &threadPool, std::memory_order_acq_rel))
+	{
+		return false;
+	}
+
+	// Count job as queued, including while it waits for dependencies
+	threadPool.m_queuedJobsCounter.Increment();
+	if (counter != nullptr)
+	{
+		counter->Increment();
+	}
+	m_counter	= counter;
+	m_priority	= priority;
+	m_deadline	= deadline;
+
+	return m_pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1;
+}
+
+// Releases jobs depending on this job, cancelling them if this job was cancelled and queueing those
+// with no dependencies left, and decrements counters this job was queued with
+void AndGen::Job::Internal_Complete()
+{
+	bool isCancelled = m_isCancelled.load(std::memory_order_relaxed);
+
+	// Close successor list, so no more jobs can be scheduled to depend on this job
+	Internal_ReleaseSuccessors(m_successors.exchange(&s_completedSuccessors, std::memory_order_acq_rel), isCancelled);
+
+	// Successors have been queued, so this job can now be counted as completed
+	if (m_counter != nullptr)
+	{
+		m_counter->Decrement();
+	}
+}
+
+// Releases a list of successors, cancelling them if requested and queueing those with no dependencies left
+void AndGen::Job::Internal_ReleaseSuccessors(AndGen::Job::Successor* successor, bool isCancelled)
+{
+	while (successor != nullptr && successor != &s_completedSuccessors)
+	{
+		Successor* next = successor->next;
+
+		// Jobs depending on a skipped job are skipped too, once they're taken by a thread
+		std::shared_ptr<Job>& job = successor->job;
+		if (isCancelled)
+		{
+			job->m_isCancelled.store(true, std::memory_order_relaxed);
+		}
+
+		// Queue job if this was the last dependency, and it has already been queued
+		if (job->m_pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		{
+			job->m_threadPool.load(std::memory_order_acquire)->QueueReadyJob(std::move(job));
+		}
+
+		delete successor;
+		successor = next;
+	}
 }
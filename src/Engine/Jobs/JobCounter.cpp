@@ -0,0 +1,47 @@
+#include <AndGen/Engine/Jobs/JobCounter.hpp>
+
+// AndGen includes
+#include "../Parallelism/Futex.hpp"
+
+// Wakes all threads blocked waiting for the count to reach zero
+void AndGen::JobCounter::WakeWaiters()
+{
+	// Waking doesn't read the count, so it's harmless if a thread which saw the count reach zero
+	// has already destroyed the counter
+	Futex::WakeAll(m_count);
+}
+
+// Blocks the calling thread until the count reaches zero, or it's woken spuriously
+void AndGen::JobCounter::Internal_Park() const
+{
+	// Flag this thread as waiting while reading the count, pairing with Decrement()
+	std::uint32_t count = m_count.fetch_or(WaitingFlag, std::memory_order_acq_rel) | WaitingFlag;
+	if (count != WaitingFlag)
+	{
+		Futex::Wait(m_count, count);
+	}
+
+	ClearWaitingFlag();
+}
+
+// Blocks the calling thread until the count reaches zero, a timeout passes, or it's woken spuriously
+void AndGen::JobCounter::Internal_ParkFor(std::chrono::nanoseconds timeout) const
+{
+	// Flag this thread as waiting while reading the count, pairing with Decrement()
+	std::uint32_t count = m_count.fetch_or(WaitingFlag, std::memory_order_acq_rel) | WaitingFlag;
+	if (count != WaitingFlag)
+	{
+		Futex::WaitFor(m_count, count, timeout);
+	}
+
+	ClearWaitingFlag();
+}
+
+// Clears the waiting flag once the count has reached zero, so completing the counter again doesn't wake anything
+void AndGen::JobCounter::ClearWaitingFlag() const
+{
+	// Other threads still blocked were woken along with this thread, and threads about to block see the count
+	// change and return
+	std::uint32_t completed = WaitingFlag;
+	m_count.compare_exchange_strong(completed, 0, std::memory_order_relaxed);
+}
@@ -0,0 +1,194 @@
+#ifndef JOBFUTURE_H
+#define JOBFUTURE_H
+
+// STL includes
+#include <memory>
+#include <type_traits>
+#include <utility>
+// AndGen includes
+#include <AndGen/Engine/Jobs/JobLane.hpp>
+#include <AndGen/Engine/Jobs/JobPriority.hpp>
+#include <AndGen/Engine/Jobs/ResultJob.hpp>
+#include "../Parallelism/ThreadPool.hpp"
+#include "PooledAllocator.hpp"
+
+namespace AndGen
+{
+	/// <summary>
+	/// Handle to the value of a job queued with a thread pool, which may be waited on or continued
+	/// </summary>
+	/// <remarks>
+	/// <para>Futures share ownership of a <see cref="ResultJob"/>, whose value is stored inline within the job,
+	/// and are cheap to copy. Jobs created from functions, including continuations, are allocated from the
+	/// recycled pools of <see cref="TaskFrameAllocator"/> along with their value and reference counts, as are the
+	/// nodes linking continuations to their jobs, so creating futures doesn't allocate from the heap once the
+	/// pools have warmed up. Only jobs given by the caller are allocated however the caller chose.</para>
+	/// <para>Waiting executes queued jobs from the thread pool until the value is ready, as with
+	/// <see cref="ThreadPool::Wait"/>, rather than blocking the waiting thread.</para>
+	/// <para>Continuations added with <see cref="Then"/> are scheduled as jobs depending on this future's job,
+	/// so they're queued by the thread completing it. Cancelled jobs produce no value, and cancel their
+	/// continuations.</para>
+	/// <para>Futures to jobs producing no value, such as continuations returning nothing, are of void. Getting
+	/// their value only waits for them, and their continuations take no arguments.</para>
+	/// </remarks>
+	/// <typeparam name="T">Type of value produced, or void for none</typeparam>
+	template<class T>
+	class JobFuture
+	{
+	public:
+		/// <summary>
+		/// Type returned by a callable object continuing this future, see <see cref="Then"/>
+		/// </summary>
+		template<class Function>
+		using ContinuationResult = typename std::conditional_t<std::is_void<T>::value,
+			std::invoke_result<std::decay_t<Function>&>,
+			std::invoke_result<std::decay_t<Function>&, std::add_lvalue_reference_t<T>>>::type;
+
+		/// <summary>
+		/// Queues a job with a thread pool, returning a future to its value
+		/// </summary>
+		/// <remarks>
+		/// The job's dependencies must be scheduled before it's queued, and the job mustn't have been queued already.
+		/// </remarks>
+		/// <param name="threadPool">Thread pool to execute the job, which must outlive the job</param>
+		/// <param name="job">Job producing the value</param>
+		/// <param name="priority">Priority of the job</param>
+		/// <param name="lane">Set of threads to execute the job</param>
+		/// <exception cref="std::logic_error">Thrown when the thread pool has no threads</exception>
+		JobFuture(ThreadPool& threadPool, std::shared_ptr<ResultJob<T>> job, JobPriority priority = JobPriority::Frame,
+			JobLane lane = JobLane::Compute) : m_threadPool(&threadPool), m_job(std::move(job))
+		{
+			m_threadPool->QueueJob(m_job, &m_job->m_futureCounter, priority, lane);
+		}
+		/// <summary>
+		/// Queues a function with a thread pool, returning a future to the value it returns
+		/// </summary>
+		/// <param name="threadPool">Thread pool to execute the function, which must outlive the function</param>
+		/// <param name="function">Callable object taking no arguments, such as a lambda</param>
+		/// <param name="priority">Priority of the function</param>
+		/// <param name="lane">Set of threads to execute the function</param>
+		/// <typeparam name="Function">Type of callable object</typeparam>
+		/// <exception cref="std::logic_error">Thrown when the thread pool has no threads</exception>
+		template<class Function, class = std::enable_if_t<std::is_invocable<std::decay_t<Function>&>::value>>
+		JobFuture(ThreadPool& threadPool, Function&& function, JobPriority priority = JobPriority::Frame,
+			JobLane lane = JobLane::Compute) :
+			JobFuture(threadPool, CreateJob(std::forward<Function>(function)), priority, lane)
+		{
+		}
+
+		/// <summary>
+		/// Has the job completed, so waiting won't block?
+		/// </summary>
+		inline bool IsReady() const
+		{
+			return m_job->m_futureCounter.IsComplete();
+		}
+
+		/// <summary>
+		/// Waits for the job to complete, executing queued jobs from the thread pool while waiting
+		/// </summary>
+		inline void Wait() const
+		{
+			m_threadPool->Wait(m_job->m_futureCounter);
+		}
+
+		/// <summary>
+		/// Waits for the job to complete, and returns its value
+		/// </summary>
+		/// <exception cref="std::logic_error">Thrown when the job was cancelled</exception>
+		inline std::add_lvalue_reference_t<T> Get() const
+		{
+			Wait();
+
+			return m_job->GetResult();
+		}
+
+		/// <summary>
+		/// Queues a function to execute with the job's value once the job has completed
+		/// </summary>
+		/// <remarks>
+		/// The function is given a reference to the value, which is shared by all of the job's continuations, or
+		/// no arguments if the job produces no value. Functions returning nothing give a future of void.
+		/// </remarks>
+		/// <param name="function">Callable object taking the value, such as a lambda</param>
+		/// <param name="priority">Priority of the function</param>
+		/// <param name="lane">Set of threads to execute the function</param>
+		/// <typeparam name="Function">Type of callable object</typeparam>
+		/// <returns>Future to the value returned by the function</returns>
+		template<class Function>
+		JobFuture<ContinuationResult<Function>> Then(Function&& function, JobPriority priority = JobPriority::Frame,
+			JobLane lane = JobLane::Compute) const
+		{
+			using Result = ContinuationResult<Function>;
+
+			std::shared_ptr<ResultJob<Result>> continuation = JobFuture<Result>::CreateJob(
+				[job = m_job, function = std::forward<Function>(function)]() mutable -> Result
+				{
+					if constexpr (std::is_void<T>::value)
+					{
+						return function();
+					}
+					else
+					{
+						return function(job->GetResult());
+					}
+				});
+			continuation->Schedule(m_job);
+
+			return JobFuture<Result>(*m_threadPool, std::move(continuation), priority, lane);
+		}
+
+		/// <summary>
+		/// The job producing the value, such as for other jobs to be scheduled after
+		/// </summary>
+		inline const std::shared_ptr<ResultJob<T>>& GetJob() const
+		{
+			return m_job;
+		}
+
+	private:
+		template<class>
+		friend class JobFuture;
+
+		/// <summary>
+		/// Job producing the value returned by a callable object
+		/// </summary>
+		template<class Function>
+		class FunctionJob final : public ResultJob<T>
+		{
+		public:
+			explicit FunctionJob(Function&& function) : m_function(std::move(function)) {}
+
+		protected:
+			virtual T Compute() override
+			{
+				return m_function();
+			}
+
+		private:
+			// Callable object producing the value
+			Function m_function;
+		};
+
+		// Thread pool executing the job
+		ThreadPool* m_threadPool;
+		// Job producing the value
+		std::shared_ptr<ResultJob<T>> m_job;
+
+		// Creates a job producing the value returned by a callable object
+		template<class Function>
+		static std::shared_ptr<ResultJob<T>> CreateJob(Function&& function)
+		{
+			using FunctionType = std::decay_t<Function>;
+
+			return std::allocate_shared<FunctionJob<FunctionType>>(PooledAllocator<FunctionJob<FunctionType>>(),
+				FunctionType(std::forward<Function>(function)));
+		}
+	};
+
+	// Deduces the type of value from the function queued
+	template<class Function, class... Args>
+	JobFuture(ThreadPool&, Function&&, Args...) -> JobFuture<std::invoke_result_t<std::decay_t<Function>&>>;
+}
+
+#endif
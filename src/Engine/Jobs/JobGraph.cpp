@@ -0,0 +1,304 @@
+#include "JobGraph.hpp"
+
+// STL includes
+#include <algorithm>
+#include <stdexcept>
+// AndGen includes
+#include "../Parallelism/ThreadPool.hpp"
+
+// Constructs a new empty graph
+AndGen::JobGraph::JobGraph() : m_rootCount(0), m_criticalPathLength(0), m_isCompiled(true), m_threadPool(nullptr),
+	m_cancellationToken(nullptr)
+{
+}
+
+// Destroys this graph, waiting for it to complete if it's executing
+AndGen::JobGraph::~JobGraph()
+{
+	// Nodes refer to this graph, so it can't be destroyed before they complete
+	Wait();
+}
+
+// Adds a node to the graph
+AndGen::JobGraph::NodeId AndGen::JobGraph::AddNode(std::function<void()> function, AndGen::JobPriority priority,
+	AndGen::JobLane lane)
+{
+	if (!function)
+	{
+		throw std::invalid_argument("Graph nodes must have a function to execute");
+	}
+	EnsureNotExecuting();
+
+	m_functions.push_back(std::move(function));
+	m_priorities.push_back(priority);
+	m_lanes.push_back(lane);
+	m_isCompiled = false;
+
+	return m_functions.size() - 1;
+}
+
+// Adds an edge to the graph, so a node executes after another node has completed
+void AndGen::JobGraph::AddEdge(AndGen::JobGraph::NodeId before, AndGen::JobGraph::NodeId after)
+{
+	if (before >= m_functions.size() || after >= m_functions.size())
+	{
+		throw std::out_of_range("Edges can only be added between nodes within the graph");
+	}
+	if (before == after)
+	{
+		throw std::invalid_argument("A node cannot depend on itself");
+	}
+	EnsureNotExecuting();
+
+	m_edges.emplace_back(before, after);
+	m_isCompiled = false;
+}
+
+// Sorts the graph's nodes topologically, and computes the dependencies of each node
+void AndGen::JobGraph::Compile()
+{
+	EnsureNotExecuting();
+
+	// Group edges by the node they begin from, so each node's successors are contiguous
+	size_t nodeCount = m_functions.size();
+	std::vector<size_t> successorOffsets(nodeCount + 1, 0);
+	std::vector<unsigned int> dependencyCounts(nodeCount, 0);
+	for (size_t i = 0; i < m_edges.size(); i++)
+	{
+		successorOffsets[m_edges[i].first + 1]++;
+		dependencyCounts[m_edges[i].second]++;
+	}
+	for (size_t i = 0; i < nodeCount; i++)
+	{
+		successorOffsets[i + 1] += successorOffsets[i];
+	}
+	std::vector<NodeId> successorIds(m_edges.size());
+	std::vector<size_t> nextSuccessor(successorOffsets.begin(), successorOffsets.end() - 1);
+	for (size_t i = 0; i < m_edges.size(); i++)
+	{
+		successorIds[nextSuccessor[m_edges[i].first]++] = m_edges[i].second;
+	}
+
+	// Sort nodes breadth first from nodes without dependencies, so they come first
+	std::vector<NodeId> order;
+	order.reserve(nodeCount);
+	std::vector<unsigned int> remainingDependencies(dependencyCounts);
+	for (NodeId i = 0; i < nodeCount; i++)
+	{
+		if (remainingDependencies[i] == 0)
+		{
+			order.push_back(i);
+		}
+	}
+	size_t rootCount = order.size();
+	for (size_t i = 0; i < order.size(); i++)
+	{
+		for (size_t j = successorOffsets[order[i]]; j < successorOffsets[order[i] + 1]; j++)
+		{
+			if (--remainingDependencies[successorIds[j]] == 0)
+			{
+				order.push_back(successorIds[j]);
+			}
+		}
+	}
+	if (order.size() != nodeCount)
+	{
+		throw std::logic_error("Unable to compile job graph - graph contains a cycle");
+	}
+
+	// Lay out nodes in order, with successors referring to nodes by index
+	std::vector<size_t> nodeIndices(nodeCount);
+	for (size_t i = 0; i < nodeCount; i++)
+	{
+		nodeIndices[order[i]] = i;
+	}
+
+	std::unique_ptr<CompiledNode[]> nodes(new CompiledNode[nodeCount]);
+	std::vector<size_t> successors;
+	successors.reserve(m_edges.size());
+	std::vector<size_t> depths(nodeCount, 1);
+	size_t criticalPathLength = 0;
+	for (size_t i = 0; i < nodeCount; i++)
+	{
+		NodeId id					= order[i];
+		CompiledNode& node			= nodes[i];
+		node.function				= &m_functions[id];
+		node.id						= id;
+		node.firstSuccessor			= successors.size();
+		node.successorCount			= successorOffsets[id + 1] - successorOffsets[id];
+		node.dependencyCount		= dependencyCounts[id];
+		node.priority				= m_priorities[id];
+		node.lane					= m_lanes[id];
+		node.pendingDependencies.store(0, std::memory_order_relaxed);
+		node.duration				= std::chrono::nanoseconds::zero();
+
+		// Nodes are visited after all of their dependencies, so their depth is final
+		criticalPathLength = std::max(criticalPathLength, depths[i]);
+		for (size_t j = successorOffsets[id]; j < successorOffsets[id + 1]; j++)
+		{
+			size_t successor	= nodeIndices[successorIds[j]];
+			depths[successor]	= std::max(depths[successor], depths[i] + 1);
+			successors.push_back(successor);
+		}
+	}
+
+	m_nodes					= std::move(nodes);
+	m_nodeIndices			= std::move(nodeIndices);
+	m_successors			= std::move(successors);
+	m_rootCount				= rootCount;
+	m_criticalPathLength	= criticalPathLength;
+	m_isCompiled			= true;
+}
+
+// Begins executing the graph, queueing nodes without dependencies with a thread pool
+void AndGen::JobGraph::Launch(AndGen::ThreadPool& threadPool, const AndGen::CancellationToken* token)
+{
+	EnsureNotExecuting();
+	if (!m_isCompiled)
+	{
+		Compile();
+	}
+	if (threadPool.Size() == 0)
+	{
+		throw std::logic_error("Unable to enqueue job - thread pool has no threads");
+	}
+
+	// Reset the dependencies of every node, and durations of nodes which may be skipped if cancelled
+	size_t nodeCount = m_functions.size();
+	for (size_t i = 0; i < nodeCount; i++)
+	{
+		m_nodes[i].pendingDependencies.store(m_nodes[i].dependencyCount, std::memory_order_relaxed);
+		m_nodes[i].duration = std::chrono::nanoseconds::zero();
+	}
+
+	// Hold a count while queueing, so the graph can't complete before all roots are queued
+	m_threadPool		= &threadPool;
+	m_cancellationToken	= token;
+	m_counter.Increment();
+	for (size_t i = 0; i < m_rootCount; i++)
+	{
+		QueueNode(i);
+	}
+	m_counter.Decrement();
+}
+
+// Waits for the graph to complete, executing queued jobs from its thread pool while waiting
+void AndGen::JobGraph::Wait()
+{
+	// The pool the graph last executed with is only used while the graph is executing, as it may since
+	// have been destroyed
+	if (m_threadPool != nullptr && !m_counter.IsComplete())
+	{
+		m_threadPool->Wait(m_counter);
+	}
+}
+
+// The chain of dependencies which took longest to execute when the graph last completed
+std::vector<AndGen::JobGraph::NodeId> AndGen::JobGraph::GetCriticalPath() const
+{
+	EnsureNotExecuting();
+	if (!m_isCompiled || m_functions.empty())
+	{
+		return {};
+	}
+
+	// Find the longest time to reach the end of each node, and the dependency it was reached through
+	size_t nodeCount = m_functions.size();
+	std::vector<std::chrono::nanoseconds> finishTimes(nodeCount, std::chrono::nanoseconds::zero());
+	std::vector<size_t> previous(nodeCount, nodeCount);
+	size_t last = 0;
+	for (size_t i = 0; i < nodeCount; i++)
+	{
+		finishTimes[i] += m_nodes[i].duration;
+		if (finishTimes[i] > finishTimes[last])
+		{
+			last = i;
+		}
+
+		for (size_t j = 0; j < m_nodes[i].successorCount; j++)
+		{
+			size_t successor = m_successors[m_nodes[i].firstSuccessor + j];
+			if (previous[successor] == nodeCount || finishTimes[i] > finishTimes[successor])
+			{
+				finishTimes[successor]	= finishTimes[i];
+				previous[successor]		= i;
+			}
+		}
+	}
+
+	// Walk back from the node finishing last
+	std::vector<NodeId> criticalPath;
+	for (size_t i = last; i != nodeCount; i = previous[i])
+	{
+		criticalPath.push_back(m_nodes[i].id);
+	}
+	std::reverse(criticalPath.begin(), criticalPath.end());
+
+	return criticalPath;
+}
+
+// The time taken by the chain of dependencies which took longest to execute when the graph last completed
+std::chrono::nanoseconds AndGen::JobGraph::GetCriticalPathDuration() const
+{
+	std::chrono::nanoseconds duration = std::chrono::nanoseconds::zero();
+	std::vector<NodeId> criticalPath = GetCriticalPath();
+	for (size_t i = 0; i < criticalPath.size(); i++)
+	{
+		duration += GetNodeDuration(criticalPath[i]);
+	}
+
+	return duration;
+}
+
+// The time taken by a node when the graph last completed
+std::chrono::nanoseconds AndGen::JobGraph::GetNodeDuration(AndGen::JobGraph::NodeId node) const
+{
+	if (node >= m_functions.size())
+	{
+		throw std::out_of_range("Node is not within the graph");
+	}
+	EnsureNotExecuting();
+
+	return m_isCompiled ? m_nodes[m_nodeIndices[node]].duration : std::chrono::nanoseconds::zero();
+}
+
+// Throws if the graph is executing
+void AndGen::JobGraph::EnsureNotExecuting() const
+{
+	if (!m_counter.IsComplete())
+	{
+		throw std::logic_error("Job graph cannot be used while executing");
+	}
+}
+
+// Queues a node, which has no dependencies left, with the thread pool
+void AndGen::JobGraph::QueueNode(size_t index)
+{
+	m_threadPool->QueueJob([this, index] { ExecuteNode(index); }, &m_counter, m_nodes[index].priority,
+		m_nodes[index].lane);
+}
+
+// Executes a node, then queues successors with no dependencies left, unless cancelled
+void AndGen::JobGraph::ExecuteNode(size_t index)
+{
+	CompiledNode& node = m_nodes[index];
+
+	// Skip cancelled nodes, leaving successors unqueued, as they're only counted once queued
+	if (m_cancellationToken != nullptr && m_cancellationToken->IsCancelled())
+	{
+		return;
+	}
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	(*node.function)();
+	node.duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+	for (size_t i = 0; i < node.successorCount; i++)
+	{
+		size_t successor = m_successors[node.firstSuccessor + i];
+		if (m_nodes[successor].pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		{
+			QueueNode(successor);
+		}
+	}
+}
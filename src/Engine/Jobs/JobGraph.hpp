@@ -0,0 +1,232 @@
+#ifndef JOBGRAPH_H
+#define JOBGRAPH_H
+
+// STL includes
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <vector>
+// AndGen includes
+#include <AndGen/Engine/Jobs/CancellationToken.hpp>
+#include <AndGen/Engine/Jobs/JobCounter.hpp>
+#include <AndGen/Engine/Jobs/JobLane.hpp>
+#include <AndGen/Engine/Jobs/JobPriority.hpp>
+
+namespace AndGen
+{
+	// Pre-declarations
+	class ThreadPool;
+
+	/// <summary>
+	/// Graph of jobs and their dependencies, which is built once and executed repeatedly
+	/// </summary>
+	/// <remarks>
+	/// <para>Nodes and edges are declared once, then compiled into a flat array of nodes in topological order,
+	/// each with its count of dependencies and a range of successors. Each launch resets the count of every
+	/// node, and queues nodes with the thread pool as their last dependency completes. Nodes are queued as
+	/// pooled job records, so launching a compiled graph doesn't allocate.</para>
+	/// <para>The time taken by each node is measured whenever the graph executes, giving the chain of nodes
+	/// which bounded the last execution through <see cref="GetCriticalPath"/>.</para>
+	/// </remarks>
+	class JobGraph
+	{
+	public:
+		/// <summary>
+		/// Identifies a node within a graph, in the order nodes were added
+		/// </summary>
+		using NodeId = size_t;
+
+		/// <summary>
+		/// Constructs a new empty graph
+		/// </summary>
+		JobGraph();
+		JobGraph(const JobGraph&)				= delete;
+		JobGraph& operator=(const JobGraph&)	= delete;
+		/// <summary>
+		/// Destroys this graph, waiting for it to complete if it's executing
+		/// </summary>
+		/// <remarks>
+		/// The thread pool the graph was launched with must outlive its execution, but not the graph itself.
+		/// </remarks>
+		~JobGraph();
+
+		/// <summary>
+		/// Adds a node to the graph
+		/// </summary>
+		/// <param name="function">Function executed by the node each time the graph executes</param>
+		/// <param name="priority">Priority the node is queued with</param>
+		/// <param name="lane">Set of threads the node is queued with</param>
+		/// <returns>Identifier of the node</returns>
+		/// <exception cref="std::invalid_argument">Thrown when the function is empty</exception>
+		/// <exception cref="std::logic_error">Thrown when the graph is executing</exception>
+		NodeId AddNode(std::function<void()> function, JobPriority priority = JobPriority::Frame,
+			JobLane lane = JobLane::Compute);
+
+		/// <summary>
+		/// Adds an edge to the graph, so a node executes after another node has completed
+		/// </summary>
+		/// <param name="before">Node which must complete first</param>
+		/// <param name="after">Node depending on the first node</param>
+		/// <exception cref="std::out_of_range">Thrown when either node isn't within the graph</exception>
+		/// <exception cref="std::invalid_argument">Thrown when a node is made to depend on itself</exception>
+		/// <exception cref="std::logic_error">Thrown when the graph is executing</exception>
+		void AddEdge(NodeId before, NodeId after);
+
+		/// <summary>
+		/// Sorts the graph's nodes topologically, and computes the dependencies of each node
+		/// </summary>
+		/// <remarks>
+		/// Graphs are compiled by <see cref="Launch"/> when nodes or edges were added since last compiled.
+		/// </remarks>
+		/// <exception cref="std::logic_error">Thrown when the graph contains a cycle, or is executing</exception>
+		void Compile();
+
+		/// <summary>
+		/// Begins executing the graph, queueing nodes without dependencies with a thread pool
+		/// </summary>
+		/// <remarks>
+		/// Returns once nodes without dependencies have been queued, and the graph completes asynchronously.
+		/// The graph must complete before it's launched again, or modified, and the thread pool must outlive
+		/// the graph's execution.
+		/// Once the token is cancelled, nodes which haven't begun are skipped along with all nodes depending
+		/// on them, and the graph completes once nodes which had already begun have completed.
+		/// </remarks>
+		/// <param name="threadPool">Thread pool to execute the graph's nodes</param>
+		/// <param name="token">Token cancelling the graph, if any, which must outlive this execution</param>
+		/// <exception cref="std::logic_error">Thrown when the graph is already executing, or contains a cycle,
+		/// or the thread pool has no threads</exception>
+		void Launch(ThreadPool& threadPool, const CancellationToken* token = nullptr);
+
+		/// <summary>
+		/// Waits for the graph to complete, executing queued jobs from its thread pool while waiting
+		/// </summary>
+		void Wait();
+
+		/// <summary>
+		/// Executes the graph with a thread pool, and waits for it to complete
+		/// </summary>
+		/// <param name="threadPool">Thread pool to execute the graph's nodes</param>
+		/// <param name="token">Token cancelling the graph, if any</param>
+		/// <exception cref="std::logic_error">Thrown when the graph is already executing, or contains a cycle,
+		/// or the thread pool has no threads</exception>
+		inline void Run(ThreadPool& threadPool, const CancellationToken* token = nullptr)
+		{
+			Launch(threadPool, token);
+			Wait();
+		}
+
+		/// <summary>
+		/// Has the graph completed, or was never launched?
+		/// </summary>
+		inline bool IsComplete() const
+		{
+			return m_counter.IsComplete();
+		}
+
+		/// <summary>
+		/// The amount of nodes within the graph
+		/// </summary>
+		inline size_t NodeCount() const
+		{
+			return m_functions.size();
+		}
+
+		/// <summary>
+		/// The amount of nodes within the longest chain of dependencies in the graph
+		/// </summary>
+		/// <remarks>
+		/// This is the least amount of nodes which must execute one after another, however many threads
+		/// execute the graph. Returns zero until the graph has been compiled.
+		/// </remarks>
+		inline size_t GetCriticalPathLength() const
+		{
+			return m_criticalPathLength;
+		}
+
+		/// <summary>
+		/// The chain of dependencies which took longest to execute when the graph last completed
+		/// </summary>
+		/// <returns>Nodes along the chain, in the order they executed</returns>
+		std::vector<NodeId> GetCriticalPath() const;
+
+		/// <summary>
+		/// The time taken by the chain of dependencies which took longest to execute when the graph last completed
+		/// </summary>
+		/// <remarks>
+		/// This is a lower bound on the time taken by the graph, however many threads execute it.
+		/// </remarks>
+		std::chrono::nanoseconds GetCriticalPathDuration() const;
+
+		/// <summary>
+		/// The time taken by a node when the graph last completed
+		/// </summary>
+		/// <param name="node">Node within the graph</param>
+		/// <exception cref="std::out_of_range">Thrown when the node isn't within the graph</exception>
+		std::chrono::nanoseconds GetNodeDuration(NodeId node) const;
+
+	private:
+		/// <summary>
+		/// Node compiled into topological order, along with its state while executing
+		/// </summary>
+		struct CompiledNode
+		{
+			// Function executed by the node
+			std::function<void()>* function;
+			// Identifier the node was added with
+			NodeId id;
+			// Index of the node's first successor within m_successors
+			size_t firstSuccessor;
+			// Amount of successors of the node
+			size_t successorCount;
+			// Amount of dependencies of the node
+			unsigned int dependencyCount;
+			// Priority the node is queued with
+			JobPriority priority;
+			// Set of threads the node is queued with
+			JobLane lane;
+			// Amount of dependencies which haven't completed yet during this execution
+			std::atomic_uint pendingDependencies;
+			// Time taken by the node when it last executed
+			std::chrono::nanoseconds duration;
+		};
+
+		// Functions of each node, by identifier
+		std::vector<std::function<void()>> m_functions;
+		// Priorities of each node, by identifier
+		std::vector<JobPriority> m_priorities;
+		// Lanes of each node, by identifier
+		std::vector<JobLane> m_lanes;
+		// Edges of the graph, as pairs of node identifiers
+		std::vector<std::pair<NodeId, NodeId>> m_edges;
+
+		// Nodes in topological order, with nodes without dependencies first
+		std::unique_ptr<CompiledNode[]> m_nodes;
+		// Index of each node within m_nodes, by identifier
+		std::vector<size_t> m_nodeIndices;
+		// Successors of every node as indices within m_nodes, with each node's successors contiguous
+		std::vector<size_t> m_successors;
+		// Amount of nodes without dependencies
+		size_t m_rootCount;
+		// Amount of nodes within the longest chain of dependencies
+		size_t m_criticalPathLength;
+		// Have nodes or edges been added since the graph was compiled?
+		bool m_isCompiled;
+
+		// Thread pool executing the graph, if it's been launched
+		ThreadPool* m_threadPool;
+		// Token cancelling the graph's current execution, if any
+		const CancellationToken* m_cancellationToken;
+		// Counts the graph's nodes which have been queued but haven't completed
+		JobCounter m_counter;
+
+		// Throws if the graph is executing
+		void EnsureNotExecuting() const;
+		// Queues a node, which has no dependencies left, with the thread pool
+		void QueueNode(size_t index);
+		// Executes a node, then queues successors with no dependencies left, unless cancelled
+		void ExecuteNode(size_t index);
+	};
+}
+
+#endif
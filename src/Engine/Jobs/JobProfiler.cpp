@@ -0,0 +1,416 @@
+#include "JobProfiler.hpp"
+
+// STL includes
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Buffers of every thread which has recorded events, and the times of the last capture
+struct AndGen::JobProfiler::Registry
+{
+	// Guards the buffers, and the times of the last capture
+	std::mutex mutex;
+	// Buffer of each thread which has recorded events, indexed by thread identifier
+	std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+
+	// Timestamp and steady clock time the last capture began and ended, to convert timestamps to time
+	std::int64_t beginTimestamp	= 0;
+	std::int64_t endTimestamp	= 0;
+	std::chrono::steady_clock::time_point beginTime;
+	std::chrono::steady_clock::time_point endTime;
+
+	// Frames to capture once the next frame begins
+	std::atomic<unsigned int> armedFrames	= 0;
+	// Frames left to capture, or zero if capturing until ended
+	std::atomic<unsigned int> framesLeft	= 0;
+};
+
+// Releases the calling thread's buffer to be reused once the thread exits
+struct AndGen::JobProfiler::ThreadExit
+{
+	~ThreadExit()
+	{
+		if (s_threadBuffer != nullptr)
+		{
+			s_threadBuffer->isInUse.store(false, std::memory_order_release);
+			s_threadBuffer = nullptr;
+		}
+	}
+};
+
+// Is the profiler currently recording events?
+std::atomic_bool AndGen::JobProfiler::s_isCapturing = false;
+// Buffer the calling thread records events into, once it has recorded an event
+thread_local AndGen::JobProfiler::ThreadBuffer* AndGen::JobProfiler::s_threadBuffer = nullptr;
+
+// Names threads are given within exported captures, until the first event is recorded
+static thread_local std::string s_threadName;
+
+// Converts timestamps to microseconds since the beginning of a capture
+class TimestampConverter
+{
+public:
+	TimestampConverter(std::int64_t beginTimestamp, std::int64_t endTimestamp, std::chrono::nanoseconds duration) :
+		m_beginTimestamp(beginTimestamp),
+		m_microsecondsPerTick(endTimestamp > beginTimestamp ?
+			static_cast<double>(duration.count()) / 1000.0 / static_cast<double>(endTimestamp - beginTimestamp) : 0.0) {}
+
+	inline double ToMicroseconds(std::int64_t timestamp) const
+	{
+		return static_cast<double>(timestamp - m_beginTimestamp) * m_microsecondsPerTick;
+	}
+	inline double ToMicroseconds(std::int64_t beginTimestamp, std::int64_t endTimestamp) const
+	{
+		return static_cast<double>(endTimestamp - beginTimestamp) * m_microsecondsPerTick;
+	}
+
+private:
+	std::int64_t m_beginTimestamp;
+	double m_microsecondsPerTick;
+};
+
+// Writes a JSON string, escaping characters which can't appear within one
+static void WriteJsonString(std::ostream& stream, const std::string& text)
+{
+	stream << '"';
+	for (char character : text)
+	{
+		if (character == '"' || character == '\\')
+		{
+			stream << '\\' << character;
+		}
+		else if (static_cast<unsigned char>(character) >= 0x20)
+		{
+			stream << character;
+		}
+	}
+	stream << '"';
+}
+
+// Begins recording events, until EndCapture() is called
+void AndGen::JobProfiler::BeginCapture()
+{
+	Registry& registry = GetRegistry();
+	std::scoped_lock<std::mutex> lock(registry.mutex);
+
+	registry.beginTimestamp	= ReadTimestamp();
+	registry.beginTime		= std::chrono::steady_clock::now();
+	registry.framesLeft.store(0, std::memory_order_relaxed);
+	s_isCapturing.store(true, std::memory_order_relaxed);
+}
+
+// Begins recording events when the next frame begins, until a given amount of frames have completed
+void AndGen::JobProfiler::CaptureFrames(unsigned int frameCount)
+{
+	GetRegistry().armedFrames.store(frameCount, std::memory_order_relaxed);
+}
+
+// Stops recording events
+void AndGen::JobProfiler::EndCapture()
+{
+	Registry& registry = GetRegistry();
+	std::scoped_lock<std::mutex> lock(registry.mutex);
+	if (!s_isCapturing.load(std::memory_order_relaxed))
+	{
+		return;
+	}
+
+	s_isCapturing.store(false, std::memory_order_relaxed);
+	registry.endTimestamp	= ReadTimestamp();
+	registry.endTime		= std::chrono::steady_clock::now();
+}
+
+// Marks the beginning of a new frame, beginning or ending captures of a number of frames
+void AndGen::JobProfiler::MarkFrame()
+{
+	Registry& registry = GetRegistry();
+
+	// End captures once their last frame has completed
+	if (IsCapturing() && registry.framesLeft.load(std::memory_order_relaxed) > 0 &&
+		registry.framesLeft.fetch_sub(1, std::memory_order_relaxed) == 1)
+	{
+		EndCapture();
+	}
+
+	// Begin captures armed to start with this frame
+	unsigned int armedFrames = registry.armedFrames.exchange(0, std::memory_order_relaxed);
+	if (armedFrames > 0)
+	{
+		BeginCapture();
+		registry.framesLeft.store(armedFrames, std::memory_order_relaxed);
+	}
+
+	Record(EventType::Frame);
+}
+
+// Names the calling thread within exported captures
+void AndGen::JobProfiler::SetThreadName(std::string name)
+{
+	if (s_threadBuffer != nullptr)
+	{
+		std::scoped_lock<std::mutex> lock(GetRegistry().mutex);
+		s_threadBuffer->name = name;
+	}
+
+	s_threadName = std::move(name);
+}
+
+// Writes the events of the last capture in the Chrome trace event JSON format
+void AndGen::JobProfiler::WriteChromeTrace(std::ostream& stream)
+{
+	/// <summary>
+	/// Event copied from a thread's buffer
+	/// </summary>
+	struct CopiedEvent
+	{
+		std::int64_t timestamp;
+		std::uintptr_t id;
+		EventType type;
+		std::uint32_t value;
+		unsigned int threadId;
+	};
+
+	Registry& registry = GetRegistry();
+	std::scoped_lock<std::mutex> lock(registry.mutex);
+
+	// Captures still in progress are written up to now
+	bool isCapturing = s_isCapturing.load(std::memory_order_relaxed);
+	std::int64_t beginTimestamp	= registry.beginTimestamp;
+	std::int64_t endTimestamp	= isCapturing ? ReadTimestamp() : registry.endTimestamp;
+	std::chrono::steady_clock::time_point endTime = isCapturing ? std::chrono::steady_clock::now() : registry.endTime;
+	TimestampConverter converter(beginTimestamp, endTimestamp,
+		std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - registry.beginTime));
+
+	// Copy events within the capture from each buffer, dropping any overwritten while copying
+	std::vector<CopiedEvent> events;
+	for (const std::unique_ptr<ThreadBuffer>& buffer : registry.buffers)
+	{
+		std::uint64_t head	= buffer->head.load(std::memory_order_acquire);
+		std::uint64_t first	= head > BufferCapacity ? head - BufferCapacity : 0;
+		size_t copiedBegin	= events.size();
+		for (std::uint64_t i = first; i < head; i++)
+		{
+			const Event& event = buffer->events[i & (BufferCapacity - 1)];
+			events.push_back({ event.timestamp.load(std::memory_order_relaxed), event.id.load(std::memory_order_relaxed),
+				event.type.load(std::memory_order_relaxed), event.value.load(std::memory_order_relaxed),
+				buffer->threadId });
+		}
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+		std::uint64_t newHead	= buffer->head.load(std::memory_order_relaxed);
+		std::uint64_t newFirst	= newHead > BufferCapacity ? newHead - BufferCapacity : 0;
+		if (newFirst > first)
+		{
+			size_t overwrittenCount = static_cast<size_t>(std::min(newFirst, head) - first);
+			events.erase(events.begin() + copiedBegin, events.begin() + copiedBegin + overwrittenCount);
+		}
+	}
+	events.erase(std::remove_if(events.begin(), events.end(), [beginTimestamp, endTimestamp](const CopiedEvent& event)
+	{
+		return event.timestamp < beginTimestamp || event.timestamp > endTimestamp;
+	}), events.end());
+	std::stable_sort(events.begin(), events.end(), [](const CopiedEvent& left, const CopiedEvent& right)
+	{
+		return left.timestamp < right.timestamp;
+	});
+
+	stream << std::fixed << std::setprecision(3);
+	stream << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+	stream << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"AndGen\"}}";
+	for (const std::unique_ptr<ThreadBuffer>& buffer : registry.buffers)
+	{
+		stream << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->threadId << ",\"args\":{\"name\":";
+		WriteJsonString(stream, buffer->name.empty() ? "Thread " + std::to_string(buffer->threadId) : buffer->name);
+		stream << "}}";
+	}
+
+	/// <summary>
+	/// Job which has begun executing on a thread, but not yet ended
+	/// </summary>
+	struct RunningJob
+	{
+		// Time the job began
+		std::int64_t beginTimestamp;
+		// Time the job was queued, or -1 if unknown
+		std::int64_t queueTimestamp;
+		// Name of the job, if any
+		const JobName* name;
+	};
+
+	// Pair jobs beginning with when they were queued and when they ended, and threads going idle with their next job
+	std::unordered_map<std::uintptr_t, std::int64_t> queueTimestamps;
+	std::map<std::pair<unsigned int, std::uintptr_t>, RunningJob> runningJobs;
+	std::unordered_map<unsigned int, std::uintptr_t> lastBegunJobs;
+	std::unordered_map<unsigned int, std::int64_t> idleTimestamps;
+	std::unordered_map<unsigned int, std::vector<std::pair<const JobName*, std::int64_t>>> openZones;
+	auto writeIdle = [&stream, &converter](unsigned int threadId, std::int64_t begin, std::int64_t end)
+	{
+		stream << ",\n{\"name\":\"Idle\",\"cat\":\"idle\",\"ph\":\"X\",\"pid\":1,\"tid\":" << threadId
+			<< ",\"ts\":" << converter.ToMicroseconds(begin) << ",\"dur\":" << converter.ToMicroseconds(begin, end) << "}";
+	};
+	auto writeSource = [&stream](const JobName* name)
+	{
+		stream << "\"file\":";
+		WriteJsonString(stream, name->file);
+		stream << ",\"line\":" << name->line;
+	};
+	for (const CopiedEvent& event : events)
+	{
+		switch (event.type)
+		{
+			case EventType::Queue:
+				queueTimestamps[event.id] = event.timestamp;
+				break;
+			case EventType::JobBegin:
+			{
+				std::unordered_map<unsigned int, std::int64_t>::iterator idle = idleTimestamps.find(event.threadId);
+				if (idle != idleTimestamps.end())
+				{
+					writeIdle(event.threadId, idle->second, event.timestamp);
+					idleTimestamps.erase(idle);
+				}
+
+				std::int64_t queueTimestamp = -1;
+				std::unordered_map<std::uintptr_t, std::int64_t>::iterator queued = queueTimestamps.find(event.id);
+				if (queued != queueTimestamps.end())
+				{
+					queueTimestamp = queued->second;
+					queueTimestamps.erase(queued);
+				}
+				runningJobs[{ event.threadId, event.id }] = { event.timestamp, queueTimestamp, nullptr };
+				lastBegunJobs[event.threadId] = event.id;
+				break;
+			}
+			case EventType::Name:
+			{
+				std::unordered_map<unsigned int, std::uintptr_t>::iterator lastBegun = lastBegunJobs.find(event.threadId);
+				if (lastBegun == lastBegunJobs.end())
+				{
+					break;
+				}
+
+				auto running = runningJobs.find({ event.threadId, lastBegun->second });
+				if (running != runningJobs.end())
+				{
+					running->second.name = reinterpret_cast<const JobName*>(event.id);
+				}
+				break;
+			}
+			case EventType::JobEnd:
+			{
+				auto running = runningJobs.find({ event.threadId, event.id });
+				if (running == runningJobs.end())
+				{
+					break;
+				}
+
+				const RunningJob& job = running->second;
+				stream << ",\n{\"name\":";
+				WriteJsonString(stream, job.name != nullptr ? job.name->name : "Job");
+				stream << ",\"cat\":\"job\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.threadId
+					<< ",\"ts\":" << converter.ToMicroseconds(job.beginTimestamp)
+					<< ",\"dur\":" << converter.ToMicroseconds(job.beginTimestamp, event.timestamp) << ",\"args\":{";
+				if (job.queueTimestamp >= 0)
+				{
+					stream << "\"queueWait\":" << converter.ToMicroseconds(job.queueTimestamp, job.beginTimestamp);
+					if (job.name != nullptr)
+					{
+						stream << ",";
+					}
+				}
+				if (job.name != nullptr)
+				{
+					writeSource(job.name);
+				}
+				stream << "}}";
+				runningJobs.erase(running);
+				break;
+			}
+			case EventType::Steal:
+				stream << ",\n{\"name\":\"Steal\",\"cat\":\"steal\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":" << event.threadId
+					<< ",\"ts\":" << converter.ToMicroseconds(event.timestamp) << ",\"args\":{\"victim\":" << event.value << "}}";
+				break;
+			case EventType::Idle:
+				idleTimestamps.emplace(event.threadId, event.timestamp);
+				break;
+			case EventType::Frame:
+				stream << ",\n{\"name\":\"Frame\",\"cat\":\"frame\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":" << event.threadId
+					<< ",\"ts\":" << converter.ToMicroseconds(event.timestamp) << "}";
+				break;
+			case EventType::ZoneBegin:
+				openZones[event.threadId].emplace_back(reinterpret_cast<const JobName*>(event.id), event.timestamp);
+				break;
+			case EventType::ZoneEnd:
+			{
+				// Zones begun before the capture are never written
+				std::vector<std::pair<const JobName*, std::int64_t>>& zones = openZones[event.threadId];
+				if (zones.empty() || reinterpret_cast<std::uintptr_t>(zones.back().first) != event.id)
+				{
+					break;
+				}
+
+				const JobName* name			= zones.back().first;
+				std::int64_t beginTimestamp	= zones.back().second;
+				zones.pop_back();
+
+				stream << ",\n{\"name\":";
+				WriteJsonString(stream, name->name);
+				stream << ",\"cat\":\"zone\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.threadId
+					<< ",\"ts\":" << converter.ToMicroseconds(beginTimestamp)
+					<< ",\"dur\":" << converter.ToMicroseconds(beginTimestamp, event.timestamp) << ",\"args\":{";
+				writeSource(name);
+				stream << "}}";
+				break;
+			}
+		}
+	}
+
+	// Threads still idle are idle until the end of the capture
+	for (const std::pair<const unsigned int, std::int64_t>& idle : idleTimestamps)
+	{
+		writeIdle(idle.first, idle.second, endTimestamp);
+	}
+
+	stream << "\n]}\n";
+}
+
+// The registry of buffers and captures
+AndGen::JobProfiler::Registry& AndGen::JobProfiler::GetRegistry()
+{
+	static Registry registry;
+	return registry;
+}
+
+// Assigns a buffer to the calling thread, reusing buffers of threads which have exited
+AndGen::JobProfiler::ThreadBuffer* AndGen::JobProfiler::RegisterThread()
+{
+	// Constructed on first use by each thread, releasing its buffer once the thread exits
+	static thread_local ThreadExit threadExit;
+
+	Registry& registry = GetRegistry();
+	std::scoped_lock<std::mutex> lock(registry.mutex);
+	for (const std::unique_ptr<ThreadBuffer>& buffer : registry.buffers)
+	{
+		bool isInUse = false;
+		if (buffer->isInUse.compare_exchange_strong(isInUse, true, std::memory_order_acquire))
+		{
+			s_threadBuffer = buffer.get();
+			break;
+		}
+	}
+
+	if (s_threadBuffer == nullptr)
+	{
+		registry.buffers.push_back(std::make_unique<ThreadBuffer>(static_cast<unsigned int>(registry.buffers.size() + 1)));
+		s_threadBuffer = registry.buffers.back().get();
+	}
+	s_threadBuffer->name = s_threadName;
+	(void)threadExit;
+
+	return s_threadBuffer;
+}
@@ -0,0 +1,298 @@
+#ifndef JOBPROFILER_H
+#define JOBPROFILER_H
+
+// STL includes
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <string>
+// AndGen includes
+#include <AndGen/Engine/Jobs/JobName.hpp>
+// Intrinsic includes
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/// <summary>
+/// Records an event with the job profiler, compiling to nothing unless built with the ANDGEN_JOB_PROFILER option
+/// </summary>
+#if defined(ANDGEN_JOB_PROFILER)
+#define ANDGEN_PROFILER_RECORD(type, ...) ::AndGen::JobProfiler::Record(::AndGen::JobProfiler::EventType::type, __VA_ARGS__)
+#else
+#define ANDGEN_PROFILER_RECORD(type, ...) ((void)0)
+#endif
+
+/// <summary>
+/// Times the rest of the enclosing scope as a named zone with the job profiler, such as within
+/// <see cref="AndGen::Job::Execute"/>, compiling to nothing unless built with the ANDGEN_JOB_PROFILER option
+/// </summary>
+#if defined(ANDGEN_JOB_PROFILER)
+#define ANDGEN_ZONE_CONCATENATE_INNER(left, right) left##right
+#define ANDGEN_ZONE_CONCATENATE(left, right) ANDGEN_ZONE_CONCATENATE_INNER(left, right)
+#define ANDGEN_ZONE(name) \
+	static constexpr ::AndGen::JobName ANDGEN_ZONE_CONCATENATE(andGenZoneName, __LINE__)(name); \
+	::AndGen::ProfileZone ANDGEN_ZONE_CONCATENATE(andGenZone, __LINE__)(&ANDGEN_ZONE_CONCATENATE(andGenZoneName, __LINE__))
+#else
+#define ANDGEN_ZONE(name) ((void)0)
+#endif
+
+namespace AndGen
+{
+	/// <summary>
+	/// Timeline profiler of the job system, exporting captures in the Chrome trace event format
+	/// </summary>
+	/// <remarks>
+	/// <para>Each thread records events into its own ring buffer, which only it writes to, so recording takes
+	/// a timestamp and a handful of stores without locking. Buffers hold the most recent
+	/// <see cref="BufferCapacity"/> events, older events are overwritten.</para>
+	/// <para>Threads within a <see cref="ThreadPool"/> record jobs being queued, beginning and ending, being stolen,
+	/// and the threads going idle, while built with the <c>ANDGEN_JOB_PROFILER</c> option. Without it, the
+	/// thread pool records nothing and the profiler costs nothing. Each job is identified by its
+	/// <see cref="JobRecord"/>, giving the time it waited between being queued and beginning.</para>
+	/// <para>Captures are written with <see cref="WriteChromeTrace"/>, which opens in Perfetto or chrome://tracing.</para>
+	/// </remarks>
+	class JobProfiler
+	{
+	public:
+		/// <summary>
+		/// Events recorded by each thread
+		/// </summary>
+		enum class EventType : std::uint32_t
+		{
+			/// <summary>
+			/// A job was queued, by the recording thread
+			/// </summary>
+			Queue,
+			/// <summary>
+			/// A job began executing
+			/// </summary>
+			JobBegin,
+			/// <summary>
+			/// A job finished executing
+			/// </summary>
+			JobEnd,
+			/// <summary>
+			/// A job was stolen from another thread, whose index is given as the event's value
+			/// </summary>
+			Steal,
+			/// <summary>
+			/// The thread ran out of jobs, and is idle until it next begins a job
+			/// </summary>
+			Idle,
+			/// <summary>
+			/// A new frame began
+			/// </summary>
+			Frame,
+			/// <summary>
+			/// Names the job most recently begun by the thread, given as the event's identifier
+			/// </summary>
+			Name,
+			/// <summary>
+			/// A profiling zone began, identified by its name
+			/// </summary>
+			ZoneBegin,
+			/// <summary>
+			/// A profiling zone ended, identified by its name
+			/// </summary>
+			ZoneEnd
+		};
+
+		/// <summary>
+		/// Amount of events each thread's ring buffer holds
+		/// </summary>
+		static constexpr std::uint64_t BufferCapacity = 1 << 15;
+
+		/// <summary>
+		/// Begins recording events, until <see cref="EndCapture"/> is called
+		/// </summary>
+		/// <remarks>
+		/// Events recorded by any earlier capture are no longer exported.
+		/// </remarks>
+		static void BeginCapture();
+		/// <summary>
+		/// Begins recording events when the next frame begins, until a given amount of frames have completed
+		/// </summary>
+		/// <param name="frameCount">Amount of frames to capture, counted by <see cref="MarkFrame"/></param>
+		static void CaptureFrames(unsigned int frameCount);
+		/// <summary>
+		/// Stops recording events
+		/// </summary>
+		static void EndCapture();
+
+		/// <summary>
+		/// Is the profiler currently recording events?
+		/// </summary>
+		static inline bool IsCapturing()
+		{
+			return s_isCapturing.load(std::memory_order_relaxed);
+		}
+
+		/// <summary>
+		/// Marks the beginning of a new frame, beginning or ending captures of a number of frames
+		/// </summary>
+		/// <remarks>
+		/// Called by <see cref="ThreadPool::BeginFrame"/> while built with the <c>ANDGEN_JOB_PROFILER</c> option.
+		/// </remarks>
+		static void MarkFrame();
+
+		/// <summary>
+		/// Names the calling thread within exported captures
+		/// </summary>
+		/// <param name="name">Name of the thread</param>
+		static void SetThreadName(std::string name);
+
+		/// <summary>
+		/// Records an event on the calling thread, if capturing
+		/// </summary>
+		/// <param name="type">Type of event</param>
+		/// <param name="id">Identifies the job the event applies to, if any</param>
+		/// <param name="value">Additional value of the event, such as the thread a job was stolen from</param>
+		static inline void Record(EventType type, const void* id = nullptr, std::uint32_t value = 0)
+		{
+			if (!s_isCapturing.load(std::memory_order_relaxed))
+			{
+				return;
+			}
+
+			ThreadBuffer* buffer = s_threadBuffer;
+			if (buffer == nullptr)
+			{
+				buffer = RegisterThread();
+			}
+			buffer->Push(ReadTimestamp(), type, id, value);
+		}
+
+		/// <summary>
+		/// Writes the events of the last capture in the Chrome trace event JSON format
+		/// </summary>
+		/// <remarks>
+		/// Jobs, zones and idle periods are written as complete events on their thread's track, with the time each
+		/// job waited after being queued as an argument. Named jobs and zones are written with their name and
+		/// source location, and anonymous jobs as "Job". Steals and frames are written as instant events.
+		/// May be called while threads are recording, although events may be missing from the end of a capture
+		/// still in progress.
+		/// </remarks>
+		/// <param name="stream">Stream to write to</param>
+		static void WriteChromeTrace(std::ostream& stream);
+
+	private:
+		/// <summary>
+		/// Event within a thread's ring buffer
+		/// </summary>
+		/// <remarks>
+		/// Fields are relaxed atomics so events can be exported while their thread overwrites them,
+		/// which compile to plain stores.
+		/// </remarks>
+		struct Event
+		{
+			// Time the event was recorded, see ReadTimestamp()
+			std::atomic<std::int64_t> timestamp;
+			// Identifies the job the event applies to, if any
+			std::atomic<std::uintptr_t> id;
+			// Type of event
+			std::atomic<EventType> type;
+			// Additional value of the event
+			std::atomic<std::uint32_t> value;
+		};
+
+		/// <summary>
+		/// Ring buffer of events written by a single thread
+		/// </summary>
+		struct ThreadBuffer
+		{
+			ThreadBuffer(unsigned int threadId) : events(new Event[BufferCapacity]), head(0), threadId(threadId),
+				isInUse(true) {}
+
+			// Events, indexed by their position modulo the capacity
+			std::unique_ptr<Event[]> events;
+			// Amount of events ever written to the buffer
+			std::atomic<std::uint64_t> head;
+			// Identifies the thread within exported captures
+			unsigned int threadId;
+			// Name of the thread within exported captures, guarded by the registry's mutex
+			std::string name;
+			// Is a thread currently writing to this buffer?
+			std::atomic_bool isInUse;
+
+			// Writes an event, overwriting the oldest if the buffer is full
+			inline void Push(std::int64_t timestamp, EventType type, const void* id, std::uint32_t value)
+			{
+				std::uint64_t index	= head.load(std::memory_order_relaxed);
+				Event& event		= events[index & (BufferCapacity - 1)];
+				event.timestamp.store(timestamp, std::memory_order_relaxed);
+				event.id.store(reinterpret_cast<std::uintptr_t>(id), std::memory_order_relaxed);
+				event.type.store(type, std::memory_order_relaxed);
+				event.value.store(value, std::memory_order_relaxed);
+				head.store(index + 1, std::memory_order_release);
+			}
+		};
+
+		/// <summary>
+		/// Buffers of every thread which has recorded events, and the times of the last capture
+		/// </summary>
+		struct Registry;
+		/// <summary>
+		/// Releases the calling thread's buffer to be reused once the thread exits
+		/// </summary>
+		struct ThreadExit;
+
+		// Is the profiler currently recording events?
+		static std::atomic_bool s_isCapturing;
+		// Buffer the calling thread records events into, once it has recorded an event
+		static thread_local ThreadBuffer* s_threadBuffer;
+
+		// Reads the current time cheaply, as processor ticks where available, otherwise as steady clock ticks
+		static inline std::int64_t ReadTimestamp()
+		{
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+			return static_cast<std::int64_t>(__rdtsc());
+#else
+			return std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+		}
+
+		// The registry of buffers and captures
+		static Registry& GetRegistry();
+		// Assigns a buffer to the calling thread, reusing buffers of threads which have exited
+		static ThreadBuffer* RegisterThread();
+	};
+
+	/// <summary>
+	/// Records the lifetime of a scope as a named zone with the <see cref="JobProfiler"/>
+	/// </summary>
+	/// <remarks>
+	/// Usually declared through <see cref="ANDGEN_ZONE"/>, which compiles away without the
+	/// <c>ANDGEN_JOB_PROFILER</c> option. Zones are written nested within the job executing them.
+	/// </remarks>
+	class ProfileZone
+	{
+	public:
+		/// <summary>
+		/// Begins a zone
+		/// </summary>
+		/// <param name="name">Name of the zone, with static storage</param>
+		explicit ProfileZone(const JobName* name) : m_name(name)
+		{
+			JobProfiler::Record(JobProfiler::EventType::ZoneBegin, m_name);
+		}
+		ProfileZone(const ProfileZone&)				= delete;
+		ProfileZone& operator=(const ProfileZone&)	= delete;
+		/// <summary>
+		/// Ends the zone
+		/// </summary>
+		~ProfileZone()
+		{
+			JobProfiler::Record(JobProfiler::EventType::ZoneEnd, m_name);
+		}
+
+	private:
+		// Name of the zone
+		const JobName* m_name;
+	};
+}
+
+#endif
@@ -5,9 +5,22 @@
 // AndGen includes
 #include <AndGen/Engine/Jobs/Job.hpp>
 #include <AndGen/Exceptions/NotImplementedException.hpp>
+#include "JobRecord.hpp"
+
+// Copy constructor
+AndGen::JobQueue::JobQueue(const AndGen::JobQueue& other) : m_count(0), m_passedOverCounts{}
+{
+	AddJobQueue(other);
+}
+
+// De-constructor, discarding any jobs left in the queue
+AndGen::JobQueue::~JobQueue()
+{
+	Clear();
+}
 
 // Adds a job to the end of the queue
-void AndGen::JobQueue::AddJob(std::shared_ptr<AndGen::Job> job)
+void AndGen::JobQueue::AddJob(std::shared_ptr<AndGen::Job> job, AndGen::JobPriority priority)
 {
 	// Ensure we are given a valid job
 	if (job == nullptr)
@@ -15,27 +28,69 @@ void AndGen::JobQueue::AddJob(std::shared_ptr<AndGen::Job> job)
 		return;
 	}
 
+	AddJob(JobRecord::Create(std::move(job)), priority);
+}
+
+// Adds a job record to the end of the queue
+void AndGen::JobQueue::AddJob(AndGen::JobRecord* record, AndGen::JobPriority priority)
+{
+	// Ensure we are given a valid job
+	if (record == nullptr)
+	{
+		return;
+	}
+
 	// Acquire lock on queue
 	std::scoped_lock<std::mutex> lock(m_jobQueue_mutex);
-	// Add job to queue
-	m_jobQueue.push_back(job);
+	// Add job to the lane for its priority
+	m_jobQueue[static_cast<size_t>(priority)].push_back(record);
+	m_count.fetch_add(1, std::memory_order_relaxed);
 }
 
-// Adds all jobs for another queue into this queue
-void AndGen::JobQueue::AddJobQueue(const AndGen::JobQueue& jobQueue)
+// Adds multiple job records to the end of the queue, locking the queue once
+void AndGen::JobQueue::AddJobs(AndGen::JobRecord* const* records, size_t count, AndGen::JobPriority priority)
 {
-	// Ignore empty job queues
-	if (jobQueue.Count() <= 0)
+	// Ignore empty batches
+	if (records == nullptr || count == 0)
 	{
 		return;
 	}
 
 	// Acquire lock on queue
 	std::scoped_lock<std::mutex> lock(m_jobQueue_mutex);
-	// Add given job queue's jobs to this queue
-	for (size_t i = 0; i < jobQueue.Count(); i++)
+	// Add jobs to the lane for their priority
+	std::deque<JobRecord*>& lane = m_jobQueue[static_cast<size_t>(priority)];
+	size_t addedCount = 0;
+	for (size_t i = 0; i < count; i++)
 	{
-		m_jobQueue.push_back(jobQueue.m_jobQueue[i]);
+		if (records[i] != nullptr)
+		{
+			lane.push_back(records[i]);
+			addedCount++;
+		}
+	}
+	m_count.fetch_add(addedCount, std::memory_order_relaxed);
+}
+
+// Adds all jobs for another queue into this queue
+void AndGen::JobQueue::AddJobQueue(const AndGen::JobQueue& jobQueue)
+{
+	// Ignore empty job queues, or adding a queue to itself
+	if (jobQueue.Count() <= 0 || &jobQueue == this)
+	{
+		return;
+	}
+
+	// Acquire lock on both queues
+	std::scoped_lock<std::mutex, std::mutex> lock(m_jobQueue_mutex, jobQueue.m_jobQueue_mutex);
+	// Add copies of given job queue's jobs to this queue, keeping their priorities
+	for (size_t lane = 0; lane < JobPriorityCount; lane++)
+	{
+		for (size_t i = 0; i < jobQueue.m_jobQueue[lane].size(); i++)
+		{
+			m_jobQueue[lane].push_back(JobRecord::Clone(jobQueue.m_jobQueue[lane][i]));
+			m_count.fetch_add(1, std::memory_order_relaxed);
+		}
 	}
 }
 
@@ -43,7 +98,7 @@ void AndGen::JobQueue::AddJobQueue(const AndGen::JobQueue& jobQueue)
 void AndGen::JobQueue::ExecuteNextJob()
 {
 	// Get next job from the queue
-	std::shared_ptr<Job> nextJob = GetNextJob();
+	JobRecord* nextJob = GetNextJob();
 	// Do nothing if we don't have a job to execute
 	if (nextJob == nullptr)
 	{
@@ -51,34 +106,152 @@ void AndGen::JobQueue::ExecuteNextJob()
 	}
 
 	// Execute job on main thread
-	nextJob->Run();
+	JobRecord::Execute(nextJob);
 }
 
 // Gets next job from the queue, if any
-std::shared_ptr<AndGen::Job> AndGen::JobQueue::GetNextJob()
+AndGen::JobRecord* AndGen::JobQueue::GetNextJob(AndGen::JobPriority lowestPriority)
 {
+	// Avoid locking when there's nothing to take, as threads check each other's queues while stealing
+	if (IsEmpty())
+	{
+		return nullptr;
+	}
+
+	size_t lowestLane = static_cast<size_t>(lowestPriority);
+
+	// Acquire lock on queue
+	std::scoped_lock<std::mutex> lock(m_jobQueue_mutex);
+
+	// Serve the lowest priority lane which has been passed over too many times, if any
+	size_t lane = FindAgedLane(lowestLane);
+	// Otherwise serve the highest priority lane with jobs
+	for (size_t i = 0; lane == JobPriorityCount && i <= lowestLane; i++)
+	{
+		if (!m_jobQueue[i].empty())
+		{
+			lane = i;
+		}
+	}
+
 	// Return null pointer if no jobs are left
-	if (m_jobQueue.size() <= 0)
+	if (lane == JobPriorityCount)
+	{
+		return nullptr;
+	}
+
+	// Age lower priority lanes which were passed over
+	AgeLanes(lane + 1, lowestLane);
+
+	return PopJob(lane);
+}
+
+// Gets the next job from a lane which has been passed over too many times, if any
+AndGen::JobRecord* AndGen::JobQueue::GetAgedJob(AndGen::JobPriority lowestPriority)
+{
+	// Avoid locking when there's nothing to take, as this is checked before each job taken from elsewhere
+	if (IsEmpty())
 	{
-		return static_cast<std::shared_ptr<AndGen::Job>>(nullptr);
+		return nullptr;
 	}
 
 	// Acquire lock on queue
 	std::scoped_lock<std::mutex> lock(m_jobQueue_mutex);
-	// Get pointer to next job and pop it from the queue
-	std::shared_ptr<Job> nextJob = m_jobQueue.front();
-	m_jobQueue.pop_front();
 
-	return nextJob;
+	size_t lane = FindAgedLane(static_cast<size_t>(lowestPriority));
+	return lane != JobPriorityCount ? PopJob(lane) : nullptr;
 }
 
-// Empties the queue
-void AndGen::JobQueue::Clear()
+// Counts lanes holding jobs below a priority as passed over, for a job of that priority taken from elsewhere
+void AndGen::JobQueue::PassOver(AndGen::JobPriority priority, AndGen::JobPriority lowestPriority)
+{
+	// Avoid locking when there's nothing to age
+	if (IsEmpty())
+	{
+		return;
+	}
+
+	// Acquire lock on queue
+	std::scoped_lock<std::mutex> lock(m_jobQueue_mutex);
+
+	AgeLanes(static_cast<size_t>(priority) + 1, static_cast<size_t>(lowestPriority));
+}
+
+// Amount of jobs left in the queue with a given priority
+size_t AndGen::JobQueue::Count(AndGen::JobPriority priority) const
 {
 	// Acquire lock on queue
 	std::scoped_lock<std::mutex> lock(m_jobQueue_mutex);
 
-	// Empty queue
-	std::deque<std::shared_ptr<Job>> emptyQueue;
-	m_jobQueue.swap(emptyQueue);
+	return m_jobQueue[static_cast<size_t>(priority)].size();
+}
+
+// Empties the queue
+size_t AndGen::JobQueue::Clear()
+{
+	// Take queued jobs and empty queue
+	std::array<std::deque<JobRecord*>, JobPriorityCount> discardedJobs;
+	{
+		// Acquire lock on queue
+		std::scoped_lock<std::mutex> lock(m_jobQueue_mutex);
+
+		for (size_t lane = 0; lane < JobPriorityCount; lane++)
+		{
+			m_jobQueue[lane].swap(discardedJobs[lane]);
+			m_passedOverCounts[lane] = 0;
+		}
+		m_count.store(0, std::memory_order_relaxed);
+	}
+
+	// Discard jobs once unlocked, as discarding a job may queue the jobs depending on it
+	size_t discardedCount = 0;
+	for (size_t lane = 0; lane < JobPriorityCount; lane++)
+	{
+		for (size_t i = 0; i < discardedJobs[lane].size(); i++)
+		{
+			JobRecord::Discard(discardedJobs[lane][i]);
+		}
+		discardedCount += discardedJobs[lane].size();
+	}
+
+	return discardedCount;
+}
+
+// Finds the lowest priority lane holding jobs which has been passed over too many times, while locked
+size_t AndGen::JobQueue::FindAgedLane(size_t lowestLane) const
+{
+	for (size_t i = lowestLane; i > 0; i--)
+	{
+		if (!m_jobQueue[i].empty() && m_passedOverCounts[i] >= AgingThreshold)
+		{
+			return i;
+		}
+	}
+
+	return JobPriorityCount;
+}
+
+// Counts lanes holding jobs between two lanes as passed over, while locked
+void AndGen::JobQueue::AgeLanes(size_t firstLane, size_t lowestLane)
+{
+	for (size_t i = firstLane; i <= lowestLane; i++)
+	{
+		if (!m_jobQueue[i].empty())
+		{
+			m_passedOverCounts[i]++;
+		}
+	}
+}
+
+// Takes the next job from a lane holding jobs, while locked
+AndGen::JobRecord* AndGen::JobQueue::PopJob(size_t lane)
+{
+	m_passedOverCounts[lane] = 0;
+
+	// Get pointer to next job and pop it from the queue
+	JobRecord* nextJob = m_jobQueue[lane].front();
+	m_jobQueue[lane].pop_front();
+	m_count.fetch_sub(1, std::memory_order_relaxed);
+
+	return nextJob;
 }
@@ -2,46 +2,75 @@
 #define JOBQUEUE_H
 
 // STL includes
+#include <array>
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <deque>
+// AndGen includes
+#include <AndGen/Engine/Jobs/JobPriority.hpp>
 
 namespace AndGen
 {
 	// Pre-declarations
 	class Job;
+	class JobRecord;
 
 	/// <summary>
 	/// Queue of jobs to be executed on a thread
 	/// </summary>
+	/// <remarks>
+	/// Jobs are held in a separate FIFO lane for each <see cref="JobPriority"/>, and are taken from the highest
+	/// priority lane with jobs waiting. To prevent lower priorities from starving, a lane which has been passed
+	/// over <see cref="AgingThreshold"/> times while holding jobs is served next, ahead of higher priorities.
+	/// </remarks>
 	class JobQueue
 	{
 	public:
+		/// <summary>
+		/// Amount of times a lane holding jobs can be passed over for higher priority lanes,
+		/// before its next job is taken ahead of them
+		/// </summary>
+		static constexpr unsigned int AgingThreshold = 16;
+
 		/// <summary>
 		/// Default constructor
 		/// </summary>
-		JobQueue() = default;
+		JobQueue() : m_count(0), m_passedOverCounts{} {}
 		/// <summary>
 		/// Copy constructor
 		/// </summary>
-		JobQueue(const JobQueue& other)
-		{
-			m_jobQueue = other.m_jobQueue;
-		}
+		/// <exception cref="std::logic_error">Thrown when a queued job can't be copied</exception>
+		JobQueue(const JobQueue& other);
 		/// <summary>
-		/// Default de-constructor
+		/// De-constructor, discarding any jobs left in the queue
 		/// </summary>
-		~JobQueue()	= default;
+		~JobQueue();
 
 		/// <summary>
 		/// Adds a job to the end of the queue
 		/// </summary>
 		/// <param name="job">Pointer to job, which will be added to the queue</param>
-		void AddJob(std::shared_ptr<Job> job);
+		/// <param name="priority">Priority of the job</param>
+		void AddJob(std::shared_ptr<Job> job, JobPriority priority = JobPriority::Frame);
+		/// <summary>
+		/// Adds a job record to the end of the queue
+		/// </summary>
+		/// <param name="record">Job record, which the queue takes ownership of</param>
+		/// <param name="priority">Priority of the job</param>
+		void AddJob(JobRecord* record, JobPriority priority = JobPriority::Frame);
+		/// <summary>
+		/// Adds multiple job records to the end of the queue, locking the queue once
+		/// </summary>
+		/// <param name="records">Job records, which the queue takes ownership of</param>
+		/// <param name="count">Amount of job records</param>
+		/// <param name="priority">Priority of the jobs</param>
+		void AddJobs(JobRecord* const* records, size_t count, JobPriority priority = JobPriority::Frame);
 		/// <summary>
 		/// Adds all jobs for another queue into this queue
 		/// </summary>
 		/// <param name="jobQueue">Job Queue to add jobs from to this queue</param>
+		/// <exception cref="std::logic_error">Thrown when a queued job can't be copied</exception>
 		void AddJobQueue(const JobQueue& jobQueue);
 
 		/// <summary>
@@ -49,38 +78,75 @@ namespace AndGen
 		/// </summary>
 		void ExecuteNextJob();
 		/// <summary>
+		/// Gets next job from the queue, if any
+		/// </summary>
+		/// <param name="lowestPriority">Lowest priority of job to take, lower priority jobs are left queued</param>
+		/// <returns>
+		/// Next job record in queue, which the caller takes ownership of, or null if no jobs left
+		/// </returns>
+		JobRecord* GetNextJob(JobPriority lowestPriority = JobPriority::Idle);
+		/// <summary>
+		/// Gets the next job from a lane which has been passed over too many times, if any
+		/// </summary>
+		/// <remarks>
+		/// Used with <see cref="PassOver"/> by threads taking jobs from elsewhere ahead of this queue, such as
+		/// their own deque, so lower priority jobs here still wait a bounded time.
+		/// </remarks>
+		/// <param name="lowestPriority">Lowest priority of job to take, lower priority jobs are left queued</param>
+		/// <returns>
+		/// Next job record from an aged lane, which the caller takes ownership of, or null if no lane has aged
+		/// </returns>
+		JobRecord* GetAgedJob(JobPriority lowestPriority = JobPriority::Idle);
+		/// <summary>
+		/// Counts lanes holding jobs below a priority as passed over, for a job of that priority taken from
+		/// elsewhere instead
+		/// </summary>
+		/// <param name="priority">Priority of the job taken</param>
+		/// <param name="lowestPriority">Lowest priority of lane to age</param>
+		void PassOver(JobPriority priority, JobPriority lowestPriority = JobPriority::Idle);
+		/// <summary>
 		/// Amount of jobs left in the queue
 		/// </summary>
 		inline size_t Count() const
 		{
-			return m_jobQueue.size();
+			return m_count.load(std::memory_order_relaxed);
 		}
 		/// <summary>
+		/// Amount of jobs left in the queue with a given priority
+		/// </summary>
+		/// <param name="priority">Priority of jobs to count</param>
+		size_t Count(JobPriority priority) const;
+		/// <summary>
 		/// Has the queue got no jobs?
 		/// </summary>
 		inline bool IsEmpty() const
 		{
-			return m_jobQueue.empty();
+			return Count() == 0;
 		}
 
 		/// <summary>
-		/// Empties the queue
+		/// Empties the queue, discarding its jobs with <see cref="JobRecord::Discard"/>
 		/// </summary>
-		void Clear();
+		/// <returns>Amount of jobs discarded</returns>
+		size_t Clear();
 
 	private:
-		// Queue of jobs to execute
-		std::deque<std::shared_ptr<Job>> m_jobQueue;
+		// Queue of jobs to execute for each priority, from highest to lowest priority
+		std::array<std::deque<JobRecord*>, JobPriorityCount> m_jobQueue;
+		// Amount of jobs within all lanes, readable without locking
+		std::atomic<size_t> m_count;
+		// Amount of times each lane has been passed over for a higher priority lane, since last served
+		std::array<unsigned int, JobPriorityCount> m_passedOverCounts;
 		// Mutex to ensure thread safety when accessing m_jobQueue
-		std::mutex m_jobQueue_mutex;
+		mutable std::mutex m_jobQueue_mutex;
 
-		/// <summary>
-		/// Gets next job from the queue, if any
-		/// </summary>
-		/// <returns>
-		/// Next job in queue, or null if no jobs left
-		/// </returns>
-		std::shared_ptr<Job> GetNextJob();
+		// Finds the lowest priority lane holding jobs which has been passed over too many times, while locked,
+		// returning JobPriorityCount if there's none
+		size_t FindAgedLane(size_t lowestLane) const;
+		// Counts lanes holding jobs between two lanes as passed over, while locked
+		void AgeLanes(size_t firstLane, size_t lowestLane);
+		// Takes the next job from a lane holding jobs, while locked
+		JobRecord* PopJob(size_t lane);
 	};
 }
 
@@ -0,0 +1,176 @@
+#include "JobRecord.hpp"
+
+// STL includes
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace AndGen
+{
+	/// <summary>
+	/// Recycled pool of job records, shared between all threads
+	/// </summary>
+	/// <remarks>
+	/// Each thread keeps a cache of free records, so allocating and releasing records only
+	/// locks the shared pool when moving batches of records in or out of a thread's cache.
+	/// </remarks>
+	class JobRecordPool
+	{
+	public:
+		/// <summary>
+		/// Records allocated at once when the pool is empty
+		/// </summary>
+		static constexpr size_t BlockSize	= 256;
+		/// <summary>
+		/// Records moved between a thread's cache and the shared pool at once
+		/// </summary>
+		static constexpr size_t BatchSize	= 64;
+
+		/// <summary>
+		/// Allocates a record, from the calling thread's cache if possible
+		/// </summary>
+		static JobRecord* Allocate()
+		{
+			ThreadCache& cache = GetThreadCache();
+			if (cache.freeList == nullptr)
+			{
+				GetSharedPool().Refill(cache);
+			}
+
+			JobRecord* record	= cache.freeList;
+			cache.freeList		= record->m_nextFree;
+			cache.count--;
+
+			return record;
+		}
+
+		/// <summary>
+		/// Returns a record to the calling thread's cache
+		/// </summary>
+		static void Release(JobRecord* record)
+		{
+			ThreadCache& cache	= GetThreadCache();
+			record->m_manager	= nullptr;
+			record->m_nextFree	= cache.freeList;
+			cache.freeList		= record;
+			cache.count++;
+
+			// Return a batch to the shared pool if this thread is only releasing records,
+			// such as a thread executing jobs queued by another thread
+			if (cache.count >= BatchSize * 2)
+			{
+				GetSharedPool().Drain(cache, BatchSize);
+			}
+		}
+
+	private:
+		/// <summary>
+		/// Free records cached by a single thread
+		/// </summary>
+		struct ThreadCache
+		{
+			JobRecord* freeList = nullptr;
+			size_t count		= 0;
+
+			~ThreadCache()
+			{
+				GetSharedPool().Drain(*this, count);
+			}
+		};
+
+		// Free records available to all threads
+		JobRecord* m_freeList = nullptr;
+		// Blocks of records allocated by the pool
+		std::vector<std::unique_ptr<JobRecord[]>> m_blocks;
+		// Mutex to ensure thread safety when accessing the free list
+		std::mutex m_mutex;
+
+		static JobRecordPool& GetSharedPool()
+		{
+			static JobRecordPool sharedPool;
+			return sharedPool;
+		}
+
+		static ThreadCache& GetThreadCache()
+		{
+			// Ensure shared pool outlives all thread caches
+			GetSharedPool();
+
+			static thread_local ThreadCache cache;
+			return cache;
+		}
+
+		// Moves a batch of free records into a thread's cache, allocating a new block if none are free
+		void Refill(ThreadCache& cache)
+		{
+			std::scoped_lock<std::mutex> lock(m_mutex);
+
+			if (m_freeList == nullptr)
+			{
+				m_blocks.push_back(std::make_unique<JobRecord[]>(BlockSize));
+				JobRecord* block = m_blocks.back().get();
+				for (size_t i = 0; i < BlockSize; i++)
+				{
+					block[i].m_nextFree = m_freeList;
+					m_freeList			= &block[i];
+				}
+			}
+
+			for (size_t i = 0; i < BatchSize && m_freeList != nullptr; i++)
+			{
+				JobRecord* record	= m_freeList;
+				m_freeList			= record->m_nextFree;
+				record->m_nextFree	= cache.freeList;
+				cache.freeList		= record;
+				cache.count++;
+			}
+		}
+
+		// Moves records out of a thread's cache back into the shared pool
+		void Drain(ThreadCache& cache, size_t count)
+		{
+			std::scoped_lock<std::mutex> lock(m_mutex);
+
+			for (size_t i = 0; i < count && cache.freeList != nullptr; i++)
+			{
+				JobRecord* record	= cache.freeList;
+				cache.freeList		= record->m_nextFree;
+				record->m_nextFree	= m_freeList;
+				m_freeList			= record;
+				cache.count--;
+			}
+		}
+	};
+}
+
+// Creates a copy of a record
+AndGen::JobRecord* AndGen::JobRecord::Clone(const AndGen::JobRecord* record)
+{
+	JobRecord* copy = Allocate();
+	try
+	{
+		record->m_manager(Operation::Clone, *copy, record);
+	}
+	catch (...)
+	{
+		Release(copy);
+		throw;
+	}
+
+	copy->m_manager = record->m_manager;
+	copy->m_counter = record->m_counter;
+
+	return copy;
+}
+
+// Allocates an empty record from the pool
+AndGen::JobRecord* AndGen::JobRecord::Allocate()
+{
+	return JobRecordPool::Allocate();
+}
+
+// Returns a record to the pool
+void AndGen::JobRecord::Release(AndGen::JobRecord* record)
+{
+	JobRecordPool::Release(record);
+}
@@ -0,0 +1,229 @@
+#ifndef JOBRECORD_H
+#define JOBRECORD_H
+
+// STL includes
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+// AndGen includes
+#include <AndGen/Engine/Jobs/Job.hpp>
+#include <AndGen/Engine/Jobs/JobCounter.hpp>
+#include "HardwareCounters.hpp"
+#include "JobProfiler.hpp"
+
+namespace AndGen
+{
+	/// <summary>
+	/// Compact record of work queued within the job system
+	/// </summary>
+	/// <remarks>
+	/// <para>Job records occupy a single cache line, holding a function pointer, a counter to decrement
+	/// once executed, and a small inline buffer storing the work itself. Work is either a callable object
+	/// small enough to fit within the buffer, or a <see cref="Job"/>.</para>
+	/// <para>Records are allocated from a recycled pool with per-thread caches, so queueing work doesn't
+	/// allocate once the pool has warmed up. Records must be returned to the pool with
+	/// <see cref="Release"/> after being executed or discarded.</para>
+	/// </remarks>
+	class alignas(64) JobRecord
+	{
+	public:
+		/// <summary>
+		/// Size in bytes of the inline buffer storing work
+		/// </summary>
+		static constexpr size_t PayloadSize = 48;
+
+		JobRecord() : m_manager(nullptr), m_counter(nullptr) {}
+		JobRecord(const JobRecord&)				= delete;
+		JobRecord& operator=(const JobRecord&)	= delete;
+
+		/// <summary>
+		/// Creates a record executing a callable object
+		/// </summary>
+		/// <param name="function">Callable object, taking no arguments</param>
+		/// <param name="counter">Counter to decrement once executed, if any</param>
+		/// <typeparam name="Function">Type of callable object</typeparam>
+		/// <returns>Record allocated from the pool</returns>
+		template<class Function>
+		static JobRecord* Create(Function&& function, JobCounter* counter = nullptr)
+		{
+			using FunctionType = std::decay_t<Function>;
+			static_assert(sizeof(FunctionType) <= PayloadSize,
+				"Function is too large to be stored within a job record, capture less state or use a Job");
+			static_assert(alignof(FunctionType) <= alignof(std::max_align_t),
+				"Function is over-aligned for a job record");
+
+			JobRecord* record = Allocate();
+			new (record->m_payload) FunctionType(std::forward<Function>(function));
+			record->m_manager	= &Manage<FunctionType>;
+			record->m_counter	= counter;
+
+			return record;
+		}
+
+		/// <summary>
+		/// Creates a record executing a job
+		/// </summary>
+		/// <remarks>
+		/// The job's own counter is used rather than the record's, as jobs may be executed directly.
+		/// </remarks>
+		/// <param name="job">Job to execute</param>
+		/// <returns>Record allocated from the pool</returns>
+		static JobRecord* Create(std::shared_ptr<Job> job)
+		{
+			return Create(JobInvoker{ std::move(job) });
+		}
+
+		/// <summary>
+		/// Executes and releases a record
+		/// </summary>
+		/// <param name="record">Record to execute</param>
+		static inline void Execute(JobRecord* record)
+		{
+			ANDGEN_PROFILER_RECORD(JobBegin, record, 0);
+			record->m_manager(Operation::Execute, *record, nullptr);
+			if (record->m_counter != nullptr)
+			{
+				record->m_counter->Decrement();
+			}
+
+			ANDGEN_PROFILER_RECORD(JobEnd, record, 0);
+			Release(record);
+		}
+
+		/// <summary>
+		/// Releases a record without executing it
+		/// </summary>
+		/// <remarks>
+		/// The record's counter is still decremented, and jobs are completed as cancelled, cancelling the jobs
+		/// depending on them, so nothing waiting on discarded work waits forever. Counts the record was queued
+		/// with elsewhere, such as by a thread pool, must be released by whatever discards it.
+		/// </remarks>
+		/// <param name="record">Record to discard</param>
+		static inline void Discard(JobRecord* record)
+		{
+			record->m_manager(Operation::Discard, *record, nullptr);
+			if (record->m_counter != nullptr)
+			{
+				record->m_counter->Decrement();
+			}
+
+			Release(record);
+		}
+
+		/// <summary>
+		/// Creates a copy of a record
+		/// </summary>
+		/// <param name="record">Record to copy</param>
+		/// <returns>Record allocated from the pool</returns>
+		/// <exception cref="std::logic_error">Thrown when the recorded work can't be copied</exception>
+		static JobRecord* Clone(const JobRecord* record);
+
+		/// <summary>
+		/// Allocates an empty record from the pool
+		/// </summary>
+		static JobRecord* Allocate();
+
+		/// <summary>
+		/// Returns a record to the pool
+		/// </summary>
+		/// <param name="record">Record to return, which must not hold any work</param>
+		static void Release(JobRecord* record);
+
+	private:
+		friend class JobRecordPool;
+
+		/// <summary>
+		/// Operations performed by a record's manager on its work
+		/// </summary>
+		enum class Operation
+		{
+			// Executes and then destroys the work
+			Execute,
+			// Destroys the work without executing it, completing jobs as cancelled
+			Discard,
+			// Copies the work from another record
+			Clone
+		};
+
+		// Function performing operations on the work stored within the record
+		using Manager = void(*)(Operation operation, JobRecord& record, const JobRecord* source);
+
+		/// <summary>
+		/// Callable object executing a job
+		/// </summary>
+		struct JobInvoker
+		{
+			std::shared_ptr<Job> job;
+
+			inline void operator()()
+			{
+#if defined(ANDGEN_JOB_PROFILER)
+				if (job->GetName() != nullptr)
+				{
+					JobProfiler::Record(JobProfiler::EventType::Name, job->GetName());
+				}
+#endif
+#if defined(ANDGEN_HARDWARE_COUNTERS)
+				HardwareCounters::JobScope counters(job->GetName());
+#endif
+				job->Run();
+			}
+
+			inline void Discard()
+			{
+				job->Internal_Discard();
+			}
+		};
+
+		// Function performing operations on the stored work
+		Manager m_manager;
+		union
+		{
+			// Counter to decrement once executed, while the record is in use
+			JobCounter* m_counter;
+			// Next free record, while the record is within the pool
+			JobRecord* m_nextFree;
+		};
+		// Inline storage of work
+		alignas(std::max_align_t) unsigned char m_payload[PayloadSize];
+
+		// Performs operations on work of a given type
+		template<class FunctionType>
+		static void Manage(Operation operation, JobRecord& record, const JobRecord* source)
+		{
+			FunctionType* function = std::launder(reinterpret_cast<FunctionType*>(record.m_payload));
+			switch (operation)
+			{
+				case Operation::Execute:
+					(*function)();
+					function->~FunctionType();
+					break;
+				case Operation::Discard:
+					if constexpr (std::is_same<FunctionType, JobInvoker>::value)
+					{
+						function->Discard();
+					}
+					function->~FunctionType();
+					break;
+				case Operation::Clone:
+					if constexpr (std::is_copy_constructible<FunctionType>::value)
+					{
+						new (record.m_payload) FunctionType(
+							*std::launder(reinterpret_cast<const FunctionType*>(source->m_payload)));
+					}
+					else
+					{
+						throw std::logic_error("Job record holds work which can't be copied");
+					}
+					break;
+			}
+		}
+	};
+
+	static_assert(sizeof(JobRecord) == 64, "Job records should occupy a single cache line");
+}
+
+#endif
@@ -0,0 +1,228 @@
+#include "LockFreeJobQueue.hpp"
+
+// AndGen includes
+#include <AndGen/Engine/Jobs/Job.hpp>
+#include "JobRecord.hpp"
+
+// Constructs a new queue
+AndGen::LockFreeJobQueue::LockFreeJobQueue(size_t laneCapacity) : m_count(0)
+{
+	for (size_t lane = 0; lane < JobPriorityCount; lane++)
+	{
+		m_lanes[lane] = std::make_unique<Lane>(laneCapacity);
+	}
+}
+
+// De-constructor, discarding any jobs left in the queue
+AndGen::LockFreeJobQueue::~LockFreeJobQueue()
+{
+	Clear();
+}
+
+// Adds a job to the end of the queue
+void AndGen::LockFreeJobQueue::AddJob(std::shared_ptr<AndGen::Job> job, AndGen::JobPriority priority)
+{
+	// Ensure we are given a valid job
+	if (job == nullptr)
+	{
+		return;
+	}
+
+	AddJob(JobRecord::Create(std::move(job)), priority);
+}
+
+// Adds a job record to the end of the queue
+void AndGen::LockFreeJobQueue::AddJob(AndGen::JobRecord* record, AndGen::JobPriority priority)
+{
+	// Ensure we are given a valid job
+	if (record == nullptr)
+	{
+		return;
+	}
+
+	// Count before adding, so the count is never lower than the amount of jobs which can be taken
+	m_count.fetch_add(1, std::memory_order_relaxed);
+	Push(*m_lanes[static_cast<size_t>(priority)], record);
+}
+
+// Adds multiple job records to the end of the queue
+void AndGen::LockFreeJobQueue::AddJobs(AndGen::JobRecord* const* records, size_t count, AndGen::JobPriority priority)
+{
+	// Ignore empty batches
+	if (records == nullptr || count == 0)
+	{
+		return;
+	}
+
+	Lane& lane = *m_lanes[static_cast<size_t>(priority)];
+	for (size_t i = 0; i < count; i++)
+	{
+		if (records[i] != nullptr)
+		{
+			m_count.fetch_add(1, std::memory_order_relaxed);
+			Push(lane, records[i]);
+		}
+	}
+}
+
+// Executes the next job
+void AndGen::LockFreeJobQueue::ExecuteNextJob()
+{
+	// Get next job from the queue
+	JobRecord* nextJob = GetNextJob();
+	// Do nothing if we don't have a job to execute
+	if (nextJob == nullptr)
+	{
+		return;
+	}
+
+	JobRecord::Execute(nextJob);
+}
+
+// Gets next job from the queue, if any
+AndGen::JobRecord* AndGen::LockFreeJobQueue::GetNextJob(AndGen::JobPriority lowestPriority)
+{
+	// Avoid touching the lanes when there's nothing to take, as threads check each other's queues while stealing
+	if (IsEmpty())
+	{
+		return nullptr;
+	}
+
+	// Serve the lowest priority lane which has been passed over too many times, if any
+	JobRecord* record = GetAgedJob(lowestPriority);
+	if (record != nullptr)
+	{
+		return record;
+	}
+	size_t lowestLane = static_cast<size_t>(lowestPriority);
+
+	// Otherwise serve the highest priority lane with jobs
+	for (size_t i = 0; i <= lowestLane; i++)
+	{
+		if (!TryTake(*m_lanes[i], record))
+		{
+			continue;
+		}
+
+		// Age lower priority lanes which were passed over
+		AgeLanes(i + 1, lowestLane);
+		m_lanes[i]->passedOverCount.store(0, std::memory_order_relaxed);
+		m_count.fetch_sub(1, std::memory_order_relaxed);
+
+		return record;
+	}
+
+	return nullptr;
+}
+
+// Gets the next job from a lane which has been passed over too many times, if any
+AndGen::JobRecord* AndGen::LockFreeJobQueue::GetAgedJob(AndGen::JobPriority lowestPriority)
+{
+	if (IsEmpty())
+	{
+		return nullptr;
+	}
+
+	JobRecord* record = nullptr;
+	for (size_t i = static_cast<size_t>(lowestPriority); i > 0; i--)
+	{
+		Lane& lane = *m_lanes[i];
+		if (lane.passedOverCount.load(std::memory_order_relaxed) >= AgingThreshold && TryTake(lane, record))
+		{
+			lane.passedOverCount.store(0, std::memory_order_relaxed);
+			m_count.fetch_sub(1, std::memory_order_relaxed);
+
+			return record;
+		}
+	}
+
+	return nullptr;
+}
+
+// Counts lanes holding jobs below a priority as passed over, for a job of that priority taken from elsewhere
+void AndGen::LockFreeJobQueue::PassOver(AndGen::JobPriority priority, AndGen::JobPriority lowestPriority)
+{
+	if (IsEmpty())
+	{
+		return;
+	}
+
+	AgeLanes(static_cast<size_t>(priority) + 1, static_cast<size_t>(lowestPriority));
+}
+
+// Approximate amount of jobs left in the queue with a given priority
+size_t AndGen::LockFreeJobQueue::Count(AndGen::JobPriority priority) const
+{
+	return m_lanes[static_cast<size_t>(priority)]->Count();
+}
+
+// Empties the queue
+size_t AndGen::LockFreeJobQueue::Clear()
+{
+	size_t discardedCount	= 0;
+	JobRecord* record		= nullptr;
+	for (size_t lane = 0; lane < JobPriorityCount; lane++)
+	{
+		while (TryTake(*m_lanes[lane], record))
+		{
+			m_count.fetch_sub(1, std::memory_order_relaxed);
+			JobRecord::Discard(record);
+			discardedCount++;
+		}
+		m_lanes[lane]->passedOverCount.store(0, std::memory_order_relaxed);
+	}
+
+	return discardedCount;
+}
+
+// Adds a job record to the end of a lane, which must have already been counted
+void AndGen::LockFreeJobQueue::Push(AndGen::LockFreeJobQueue::Lane& lane, AndGen::JobRecord* record)
+{
+	// Keep adding to the overflow until it's drained, so jobs stay in order
+	if (lane.overflowCount.load(std::memory_order_acquire) == 0 && lane.ring.TryPush(record))
+	{
+		return;
+	}
+
+	std::scoped_lock<std::mutex> lock(lane.overflowMutex);
+	lane.overflow.push_back(record);
+	lane.overflowCount.fetch_add(1, std::memory_order_release);
+}
+
+// Takes the job record at the front of a lane, if any, without uncounting it
+bool AndGen::LockFreeJobQueue::TryTake(AndGen::LockFreeJobQueue::Lane& lane, AndGen::JobRecord*& record)
+{
+	// Jobs in the ring were added before any overflowing jobs
+	if (lane.ring.TryPop(record))
+	{
+		return true;
+	}
+	if (lane.overflowCount.load(std::memory_order_acquire) == 0)
+	{
+		return false;
+	}
+
+	std::scoped_lock<std::mutex> lock(lane.overflowMutex);
+	if (lane.overflow.empty())
+	{
+		return false;
+	}
+
+	record = lane.overflow.front();
+	lane.overflow.pop_front();
+	lane.overflowCount.fetch_sub(1, std::memory_order_release);
+
+	return true;
+}
+
+// Counts lanes holding jobs between two lanes as passed over
+void AndGen::LockFreeJobQueue::AgeLanes(size_t firstLane, size_t lowestLane)
+{
+	for (size_t i = firstLane; i <= lowestLane; i++)
+	{
+		if (m_lanes[i]->Count() > 0)
+		{
+			m_lanes[i]->passedOverCount.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+}
@@ -0,0 +1,180 @@
+#ifndef LOCKFREEJOBQUEUE_H
+#define LOCKFREEJOBQUEUE_H
+
+// STL includes
+#include <array>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+// AndGen includes
+#include <AndGen/Engine/Jobs/JobPriority.hpp>
+#include "JobQueue.hpp"
+#include "../Parallelism/BoundedMpmcQueue.hpp"
+
+namespace AndGen
+{
+	// Pre-declarations
+	class Job;
+	class JobRecord;
+
+	/// <summary>
+	/// Queue of jobs to be executed on a thread, which producers and consumers access without locking
+	/// </summary>
+	/// <remarks>
+	/// <para>A drop-in replacement for <see cref="JobQueue"/>, selected for pooled threads by building with the
+	/// <c>ANDGEN_LOCK_FREE_JOB_QUEUE</c> option. Each <see cref="JobPriority"/> lane is a
+	/// <see cref="BoundedMpmcQueue"/>, so many threads queueing jobs with a thread don't contend on a mutex.
+	/// Lanes are aged the same way as <see cref="JobQueue"/>, although counts of passed over lanes are
+	/// approximate while several threads take jobs at once.</para>
+	/// <para>Jobs queued while a lane's ring is full are added to a locked overflow list, which is only
+	/// taken from once the ring is empty. Jobs within a lane are taken in the order they were added,
+	/// except briefly when the lane first overflows.</para>
+	/// <para>Queues can't be copied, as their jobs can't be read without taking them.</para>
+	/// </remarks>
+	class LockFreeJobQueue
+	{
+	public:
+		/// <summary>
+		/// Amount of times a lane holding jobs can be passed over for higher priority lanes,
+		/// before its next job is taken ahead of them
+		/// </summary>
+		static constexpr unsigned int AgingThreshold = JobQueue::AgingThreshold;
+
+		/// <summary>
+		/// Constructs a new queue
+		/// </summary>
+		/// <param name="laneCapacity">Jobs each lane holds before overflowing, rounded up to a power of two</param>
+		explicit LockFreeJobQueue(size_t laneCapacity = 1024);
+		LockFreeJobQueue(const LockFreeJobQueue&)				= delete;
+		LockFreeJobQueue& operator=(const LockFreeJobQueue&)	= delete;
+		/// <summary>
+		/// De-constructor, discarding any jobs left in the queue
+		/// </summary>
+		~LockFreeJobQueue();
+
+		/// <summary>
+		/// Adds a job to the end of the queue
+		/// </summary>
+		/// <param name="job">Pointer to job, which will be added to the queue</param>
+		/// <param name="priority">Priority of the job</param>
+		void AddJob(std::shared_ptr<Job> job, JobPriority priority = JobPriority::Frame);
+		/// <summary>
+		/// Adds a job record to the end of the queue
+		/// </summary>
+		/// <param name="record">Job record, which the queue takes ownership of</param>
+		/// <param name="priority">Priority of the job</param>
+		void AddJob(JobRecord* record, JobPriority priority = JobPriority::Frame);
+		/// <summary>
+		/// Adds multiple job records to the end of the queue
+		/// </summary>
+		/// <param name="records">Job records, which the queue takes ownership of</param>
+		/// <param name="count">Amount of job records</param>
+		/// <param name="priority">Priority of the jobs</param>
+		void AddJobs(JobRecord* const* records, size_t count, JobPriority priority = JobPriority::Frame);
+
+		/// <summary>
+		/// Executes the next job in the queue
+		/// </summary>
+		void ExecuteNextJob();
+		/// <summary>
+		/// Gets next job from the queue, if any
+		/// </summary>
+		/// <param name="lowestPriority">Lowest priority of job to take, lower priority jobs are left queued</param>
+		/// <returns>
+		/// Next job record in queue, which the caller takes ownership of, or null if no jobs left
+		/// </returns>
+		JobRecord* GetNextJob(JobPriority lowestPriority = JobPriority::Idle);
+		/// <summary>
+		/// Gets the next job from a lane which has been passed over too many times, if any
+		/// </summary>
+		/// <remarks>
+		/// Used with <see cref="PassOver"/> by threads taking jobs from elsewhere ahead of this queue, such as
+		/// their own deque, so lower priority jobs here still wait a bounded time.
+		/// </remarks>
+		/// <param name="lowestPriority">Lowest priority of job to take, lower priority jobs are left queued</param>
+		/// <returns>
+		/// Next job record from an aged lane, which the caller takes ownership of, or null if no lane has aged
+		/// </returns>
+		JobRecord* GetAgedJob(JobPriority lowestPriority = JobPriority::Idle);
+		/// <summary>
+		/// Counts lanes holding jobs below a priority as passed over, for a job of that priority taken from
+		/// elsewhere instead
+		/// </summary>
+		/// <param name="priority">Priority of the job taken</param>
+		/// <param name="lowestPriority">Lowest priority of lane to age</param>
+		void PassOver(JobPriority priority, JobPriority lowestPriority = JobPriority::Idle);
+		/// <summary>
+		/// Approximate amount of jobs left in the queue
+		/// </summary>
+		/// <remarks>
+		/// Jobs are counted before they're added, and uncounted after they're taken,
+		/// so the count may briefly be too high but never too low.
+		/// </remarks>
+		inline size_t Count() const
+		{
+			return m_count.load(std::memory_order_relaxed);
+		}
+		/// <summary>
+		/// Approximate amount of jobs left in the queue with a given priority
+		/// </summary>
+		/// <param name="priority">Priority of jobs to count</param>
+		size_t Count(JobPriority priority) const;
+		/// <summary>
+		/// Has the queue (approximately) got no jobs?
+		/// </summary>
+		inline bool IsEmpty() const
+		{
+			return Count() == 0;
+		}
+
+		/// <summary>
+		/// Empties the queue, discarding its jobs with <see cref="JobRecord::Discard"/>
+		/// </summary>
+		/// <remarks>
+		/// Jobs added by other threads while clearing may be left in the queue.
+		/// </remarks>
+		/// <returns>Amount of jobs discarded</returns>
+		size_t Clear();
+
+	private:
+		/// <summary>
+		/// Jobs of a single priority
+		/// </summary>
+		struct Lane
+		{
+			explicit Lane(size_t capacity) : ring(capacity), overflowCount(0), passedOverCount(0) {}
+
+			// Jobs taken without locking
+			BoundedMpmcQueue<JobRecord*> ring;
+			// Jobs added while the ring was full
+			std::deque<JobRecord*> overflow;
+			// Mutex to ensure thread safety when accessing overflow
+			std::mutex overflowMutex;
+			// Amount of jobs within overflow, readable without locking
+			std::atomic<size_t> overflowCount;
+			// Amount of times the lane has been passed over for a higher priority lane, since last served
+			std::atomic<unsigned int> passedOverCount;
+
+			// Amount of jobs within the lane
+			inline size_t Count() const
+			{
+				return ring.Count() + overflowCount.load(std::memory_order_relaxed);
+			}
+		};
+
+		// Lanes of jobs to execute for each priority, from highest to lowest priority
+		std::array<std::unique_ptr<Lane>, JobPriorityCount> m_lanes;
+		// Amount of jobs within all lanes, readable without locking
+		std::atomic<size_t> m_count;
+
+		// Adds a job record to the end of a lane, which must have already been counted
+		void Push(Lane& lane, JobRecord* record);
+		// Takes the job record at the front of a lane, if any, without uncounting it
+		bool TryTake(Lane& lane, JobRecord*& record);
+		// Counts lanes holding jobs between two lanes as passed over
+		void AgeLanes(size_t firstLane, size_t lowestLane);
+	};
+}
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef POOLEDALLOCATOR_H
+#define POOLEDALLOCATOR_H
+
+// STL includes
+#include <cstddef>
+// AndGen includes
+#include "TaskFrameAllocator.hpp"
+
+namespace AndGen
+{
+	/// <summary>
+	/// Standard allocator drawing from the recycled pools of <see cref="TaskFrameAllocator"/>
+	/// </summary>
+	/// <remarks>
+	/// Used with <c>std::allocate_shared</c> for objects created with each job, such as the jobs of a
+	/// <see cref="JobFuture"/>, so they don't allocate from the global heap once the pools have warmed up.
+	/// </remarks>
+	/// <typeparam name="T">Type of object allocated</typeparam>
+	template<class T>
+	class PooledAllocator
+	{
+	public:
+		using value_type = T;
+
+		static_assert(alignof(T) <= TaskFrameAllocator::Alignment, "Type is over-aligned for pooled allocation");
+
+		PooledAllocator() = default;
+		template<class U>
+		PooledAllocator(const PooledAllocator<U>&) {}
+
+		/// <summary>
+		/// Allocates memory for objects
+		/// </summary>
+		/// <param name="count">Amount of objects</param>
+		inline T* allocate(size_t count)
+		{
+			return static_cast<T*>(TaskFrameAllocator::Allocate(count * sizeof(T)));
+		}
+
+		/// <summary>
+		/// Returns memory for objects
+		/// </summary>
+		/// <param name="objects">Memory returned by <see cref="allocate"/></param>
+		/// <param name="count">Amount of objects given to <see cref="allocate"/></param>
+		inline void deallocate(T* objects, size_t count)
+		{
+			TaskFrameAllocator::Deallocate(objects, count * sizeof(T));
+		}
+
+		template<class U>
+		inline bool operator==(const PooledAllocator<U>&) const
+		{
+			return true;
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,552 @@
+#ifndef TASK_H
+#define TASK_H
+
+// STL includes
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+// AndGen includes
+#include <AndGen/Engine/Jobs/JobCounter.hpp>
+#include <AndGen/Engine/Jobs/JobPriority.hpp>
+#include "../Parallelism/ThreadPool.hpp"
+#include "TaskFrameAllocator.hpp"
+
+namespace AndGen
+{
+	// Pre-declarations
+	template<class ValueType>
+	class Task;
+
+	/// <summary>
+	/// State shared by all promises of coroutines executing a <see cref="Task"/>
+	/// </summary>
+	class TaskPromiseBase
+	{
+	public:
+		/// <summary>
+		/// Resumes the coroutine awaiting a task once it has completed, if any
+		/// </summary>
+		struct FinalAwaiter
+		{
+			inline bool await_ready() const noexcept
+			{
+				return false;
+			}
+
+			template<class PromiseType>
+			std::coroutine_handle<> await_suspend(std::coroutine_handle<PromiseType> handle) const noexcept
+			{
+				std::coroutine_handle<> continuation = handle.promise().m_continuation;
+				return continuation ? continuation : std::noop_coroutine();
+			}
+
+			inline void await_resume() const noexcept {}
+		};
+
+		static void* operator new(size_t size)
+		{
+			return TaskFrameAllocator::Allocate(size);
+		}
+		static void operator delete(void* frame, size_t size)
+		{
+			TaskFrameAllocator::Deallocate(frame, size);
+		}
+
+		inline std::suspend_always initial_suspend() const noexcept
+		{
+			return {};
+		}
+		inline FinalAwaiter final_suspend() const noexcept
+		{
+			return {};
+		}
+		inline void unhandled_exception() noexcept
+		{
+			m_exception = std::current_exception();
+		}
+
+		/// <summary>
+		/// Sets the coroutine to resume once the task has completed
+		/// </summary>
+		inline void SetContinuation(std::coroutine_handle<> continuation)
+		{
+			m_continuation = continuation;
+		}
+
+	protected:
+		// Coroutine to resume once the task has completed, if any
+		std::coroutine_handle<> m_continuation;
+		// Exception thrown by the task, if any
+		std::exception_ptr m_exception;
+
+		// Rethrows the exception thrown by the task, if any
+		inline void RethrowException() const
+		{
+			if (m_exception != nullptr)
+			{
+				std::rethrow_exception(m_exception);
+			}
+		}
+	};
+
+	/// <summary>
+	/// Promise of a coroutine executing a <see cref="Task"/> returning a value
+	/// </summary>
+	template<class ValueType>
+	class TaskPromise : public TaskPromiseBase
+	{
+	public:
+		Task<ValueType> get_return_object() noexcept;
+
+		template<class Value>
+		void return_value(Value&& value)
+		{
+			m_value.emplace(std::forward<Value>(value));
+		}
+
+		/// <summary>
+		/// Takes the value returned by the task, or rethrows the exception it threw
+		/// </summary>
+		ValueType TakeResult()
+		{
+			RethrowException();
+			return std::move(*m_value);
+		}
+
+	private:
+		// Value returned by the task
+		std::optional<ValueType> m_value;
+	};
+
+	/// <summary>
+	/// Promise of a coroutine executing a <see cref="Task"/> returning no value
+	/// </summary>
+	template<>
+	class TaskPromise<void> : public TaskPromiseBase
+	{
+	public:
+		Task<void> get_return_object() noexcept;
+
+		inline void return_void() const noexcept {}
+
+		/// <summary>
+		/// Rethrows the exception thrown by the task, if any
+		/// </summary>
+		inline void TakeResult() const
+		{
+			RethrowException();
+		}
+	};
+
+	/// <summary>
+	/// Coroutine which may be awaited, and may suspend itself to await other tasks or move between threads
+	/// </summary>
+	/// <remarks>
+	/// <para>Tasks begin executing once awaited with co_await, on the awaiting thread, and resume the awaiting
+	/// coroutine once they complete. Awaiting <see cref="ResumeOn"/> moves a task to one of a thread pool's
+	/// threads, and awaiting <see cref="WhenAll"/> executes several tasks in parallel. Code outside of
+	/// coroutines can execute a task with <see cref="WaitForTask"/>.</para>
+	/// <para>Coroutine frames are allocated by <see cref="TaskFrameAllocator"/> rather than the global heap.</para>
+	/// </remarks>
+	/// <typeparam name="ValueType">Type of value returned by the task</typeparam>
+	template<class ValueType = void>
+	class Task
+	{
+	public:
+		using promise_type = TaskPromise<ValueType>;
+
+		/// <summary>
+		/// Awaits a task, executing it and resuming the awaiting coroutine once it completes
+		/// </summary>
+		struct Awaiter
+		{
+			std::coroutine_handle<promise_type> handle;
+
+			inline bool await_ready() const noexcept
+			{
+				return !handle || handle.done();
+			}
+
+			inline std::coroutine_handle<> await_suspend(std::coroutine_handle<> continuation) const noexcept
+			{
+				handle.promise().SetContinuation(continuation);
+				return handle;
+			}
+
+			inline ValueType await_resume() const
+			{
+				return handle.promise().TakeResult();
+			}
+		};
+
+		Task(const Task&)				= delete;
+		Task& operator=(const Task&)	= delete;
+		Task(Task&& other) noexcept : m_handle(std::exchange(other.m_handle, nullptr)) {}
+		Task& operator=(Task&& other) noexcept
+		{
+			if (this != &other)
+			{
+				Destroy();
+				m_handle = std::exchange(other.m_handle, nullptr);
+			}
+
+			return *this;
+		}
+		/// <summary>
+		/// Destroys this task's coroutine frame
+		/// </summary>
+		~Task()
+		{
+			Destroy();
+		}
+
+		/// <summary>
+		/// Has this task completed?
+		/// </summary>
+		inline bool IsCompleted() const
+		{
+			return !m_handle || m_handle.done();
+		}
+
+		inline Awaiter operator co_await() const noexcept
+		{
+			return Awaiter{ m_handle };
+		}
+
+	private:
+		friend class TaskPromise<ValueType>;
+
+		// Coroutine executing this task
+		std::coroutine_handle<promise_type> m_handle;
+
+		explicit Task(std::coroutine_handle<promise_type> handle) : m_handle(handle) {}
+
+		inline void Destroy()
+		{
+			if (m_handle)
+			{
+				m_handle.destroy();
+				m_handle = nullptr;
+			}
+		}
+	};
+
+	template<class ValueType>
+	Task<ValueType> TaskPromise<ValueType>::get_return_object() noexcept
+	{
+		return Task<ValueType>(std::coroutine_handle<TaskPromise<ValueType>>::from_promise(*this));
+	}
+	inline Task<void> TaskPromise<void>::get_return_object() noexcept
+	{
+		return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+	}
+
+	/// <summary>
+	/// State shared between tasks joined by <see cref="WhenAll"/> or <see cref="WaitForTask"/>
+	/// </summary>
+	struct TaskJoinState
+	{
+		TaskJoinState(size_t count) : remaining(count), counter(nullptr), hasException(false) {}
+
+		// Amount of tasks which haven't completed yet
+		std::atomic<size_t> remaining;
+		// Coroutine to resume once all tasks have completed, if any
+		std::coroutine_handle<> continuation;
+		// Counter to decrement once all tasks have completed, if any
+		JobCounter* counter;
+		// First exception thrown by any task
+		std::exception_ptr exception;
+		// Has an exception been stored?
+		std::atomic_bool hasException;
+	};
+
+	/// <summary>
+	/// Coroutine awaiting a task on behalf of <see cref="WhenAll"/> or <see cref="WaitForTask"/>
+	/// </summary>
+	class TaskJoin
+	{
+	public:
+		struct promise_type : public TaskPromiseBase
+		{
+			/// <summary>
+			/// Resumes the joining coroutine once the last task has completed
+			/// </summary>
+			struct FinalAwaiter
+			{
+				inline bool await_ready() const noexcept
+				{
+					return false;
+				}
+
+				inline std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) const noexcept
+				{
+					// Read state before completing, as this coroutine may be destroyed once the last task completes
+					TaskJoinState* state = handle.promise().state;
+					if (state->remaining.fetch_sub(1, std::memory_order_acq_rel) != 1)
+					{
+						return std::noop_coroutine();
+					}
+
+					if (state->counter != nullptr)
+					{
+						state->counter->Decrement();
+						return std::noop_coroutine();
+					}
+
+					return state->continuation;
+				}
+
+				inline void await_resume() const noexcept {}
+			};
+
+			// State shared with other joined tasks
+			TaskJoinState* state = nullptr;
+
+			inline TaskJoin get_return_object() noexcept
+			{
+				return TaskJoin(std::coroutine_handle<promise_type>::from_promise(*this));
+			}
+			inline FinalAwaiter final_suspend() const noexcept
+			{
+				return {};
+			}
+			inline void unhandled_exception() noexcept
+			{
+				if (!state->hasException.exchange(true, std::memory_order_acq_rel))
+				{
+					state->exception = std::current_exception();
+				}
+			}
+			inline void return_void() const noexcept {}
+		};
+
+		TaskJoin(const TaskJoin&)				= delete;
+		TaskJoin& operator=(const TaskJoin&)	= delete;
+		TaskJoin(TaskJoin&& other) noexcept : m_handle(std::exchange(other.m_handle, nullptr)) {}
+		~TaskJoin()
+		{
+			if (m_handle)
+			{
+				m_handle.destroy();
+			}
+		}
+
+		/// <summary>
+		/// Queues this coroutine with a thread pool, to await its task
+		/// </summary>
+		void Start(ThreadPool& threadPool, TaskJoinState& state, JobPriority priority)
+		{
+			m_handle.promise().state = &state;
+
+			std::coroutine_handle<promise_type> handle = m_handle;
+			threadPool.QueueJob([handle] { handle.resume(); }, nullptr, priority);
+		}
+
+	private:
+		// Coroutine awaiting a task
+		std::coroutine_handle<promise_type> m_handle;
+
+		explicit TaskJoin(std::coroutine_handle<promise_type> handle) : m_handle(handle) {}
+	};
+
+	// Awaits a task returning a value, storing its value
+	template<class ValueType>
+	TaskJoin JoinTask(Task<ValueType>& task, std::optional<ValueType>& value)
+	{
+		value.emplace(co_await task);
+	}
+	// Awaits a task returning no value
+	inline TaskJoin JoinTask(Task<void>& task)
+	{
+		co_await task;
+	}
+
+	/// <summary>
+	/// Awaitable moving the awaiting coroutine to a thread pool
+	/// </summary>
+	struct ThreadPoolAwaiter
+	{
+		ThreadPool& threadPool;
+		JobPriority priority;
+
+		inline bool await_ready() const noexcept
+		{
+			return false;
+		}
+
+		inline void await_suspend(std::coroutine_handle<> handle) const
+		{
+			threadPool.QueueJob([handle] { handle.resume(); }, nullptr, priority);
+		}
+
+		inline void await_resume() const noexcept {}
+	};
+
+	/// <summary>
+	/// Suspends the awaiting coroutine, and resumes it on one of a thread pool's threads
+	/// </summary>
+	/// <remarks>
+	/// When awaited from one of the pool's threads, the coroutine is pushed onto that thread's deque with
+	/// the same rules as <see cref="ThreadPool::QueueJob"/>, so it resumes on the same thread unless stolen.
+	/// </remarks>
+	/// <param name="threadPool">Thread pool to resume on</param>
+	/// <param name="priority">Priority to resume with</param>
+	inline ThreadPoolAwaiter ResumeOn(ThreadPool& threadPool, JobPriority priority = JobPriority::Frame)
+	{
+		return ThreadPoolAwaiter{ threadPool, priority };
+	}
+
+	/// <summary>
+	/// Awaitable executing several tasks in parallel
+	/// </summary>
+	/// <typeparam name="ValueType">Type of value returned by the tasks</typeparam>
+	template<class ValueType>
+	class WhenAllAwaiter
+	{
+	public:
+		WhenAllAwaiter(ThreadPool& threadPool, std::vector<Task<ValueType>> tasks, JobPriority priority) :
+			m_threadPool(threadPool), m_tasks(std::move(tasks)), m_priority(priority), m_state(m_tasks.size() + 1) {}
+		WhenAllAwaiter(const WhenAllAwaiter&)				= delete;
+		WhenAllAwaiter& operator=(const WhenAllAwaiter&)	= delete;
+
+		inline bool await_ready() const noexcept
+		{
+			return m_tasks.empty();
+		}
+
+		bool await_suspend(std::coroutine_handle<> continuation)
+		{
+			m_state.continuation = continuation;
+
+			// Queue every task, the last task to complete resumes the awaiting coroutine
+			m_joins.reserve(m_tasks.size());
+			if constexpr (!std::is_void<ValueType>::value)
+			{
+				m_values.resize(m_tasks.size());
+			}
+			for (size_t i = 0; i < m_tasks.size(); i++)
+			{
+				if constexpr (std::is_void<ValueType>::value)
+				{
+					m_joins.push_back(JoinTask(m_tasks[i]));
+				}
+				else
+				{
+					m_joins.push_back(JoinTask(m_tasks[i], m_values[i]));
+				}
+			}
+			for (size_t i = 0; i < m_joins.size(); i++)
+			{
+				m_joins[i].Start(m_threadPool, m_state, m_priority);
+			}
+
+			// Release the count held while queueing, and don't suspend if all tasks have already completed
+			return m_state.remaining.fetch_sub(1, std::memory_order_acq_rel) != 1;
+		}
+
+		auto await_resume()
+		{
+			if (m_state.exception != nullptr)
+			{
+				std::rethrow_exception(m_state.exception);
+			}
+
+			if constexpr (!std::is_void<ValueType>::value)
+			{
+				std::vector<ValueType> values;
+				values.reserve(m_values.size());
+				for (size_t i = 0; i < m_values.size(); i++)
+				{
+					values.push_back(std::move(*m_values[i]));
+				}
+
+				return values;
+			}
+		}
+
+	private:
+		// Thread pool executing tasks
+		ThreadPool& m_threadPool;
+		// Tasks to execute
+		std::vector<Task<ValueType>> m_tasks;
+		// Priority to execute tasks with
+		JobPriority m_priority;
+		// State shared between tasks
+		TaskJoinState m_state;
+		// Coroutines awaiting each task
+		std::vector<TaskJoin> m_joins;
+		// Values returned by each task
+		std::conditional_t<std::is_void<ValueType>::value, char, std::vector<std::optional<ValueType>>> m_values;
+	};
+
+	/// <summary>
+	/// Executes several tasks in parallel on a thread pool, and resumes the awaiting coroutine once all complete
+	/// </summary>
+	/// <remarks>
+	/// The awaiting coroutine is resumed on the thread completing the last task. If any task throws, the first
+	/// exception thrown is rethrown once all tasks have completed.
+	/// </remarks>
+	/// <param name="threadPool">Thread pool to execute tasks on</param>
+	/// <param name="tasks">Tasks to execute</param>
+	/// <param name="priority">Priority to execute tasks with</param>
+	/// <typeparam name="ValueType">Type of value returned by the tasks</typeparam>
+	/// <returns>Awaitable returning the values returned by each task in order, unless they return no value</returns>
+	template<class ValueType>
+	WhenAllAwaiter<ValueType> WhenAll(ThreadPool& threadPool, std::vector<Task<ValueType>> tasks,
+		JobPriority priority = JobPriority::Frame)
+	{
+		return WhenAllAwaiter<ValueType>(threadPool, std::move(tasks), priority);
+	}
+
+	/// <summary>
+	/// Executes a task on a thread pool, and waits for it to complete
+	/// </summary>
+	/// <remarks>
+	/// The calling thread executes queued jobs while waiting, as with <see cref="ThreadPool::Wait"/>.
+	/// </remarks>
+	/// <param name="threadPool">Thread pool to execute the task on</param>
+	/// <param name="task">Task to execute</param>
+	/// <param name="priority">Priority to execute the task with</param>
+	/// <typeparam name="ValueType">Type of value returned by the task</typeparam>
+	/// <returns>Value returned by the task</returns>
+	template<class ValueType>
+	ValueType WaitForTask(ThreadPool& threadPool, Task<ValueType> task, JobPriority priority = JobPriority::Frame)
+	{
+		JobCounter counter;
+		counter.Increment();
+		TaskJoinState state(1);
+		state.counter = &counter;
+
+		if constexpr (std::is_void<ValueType>::value)
+		{
+			TaskJoin join = JoinTask(task);
+			join.Start(threadPool, state, priority);
+			threadPool.Wait(counter);
+
+			if (state.exception != nullptr)
+			{
+				std::rethrow_exception(state.exception);
+			}
+		}
+		else
+		{
+			std::optional<ValueType> value;
+			TaskJoin join = JoinTask(task, value);
+			join.Start(threadPool, state, priority);
+			threadPool.Wait(counter);
+
+			if (state.exception != nullptr)
+			{
+				std::rethrow_exception(state.exception);
+			}
+
+			return std::move(*value);
+		}
+	}
+}
+
+#endif
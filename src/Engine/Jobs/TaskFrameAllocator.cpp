@@ -0,0 +1,255 @@
+#include "TaskFrameAllocator.hpp"
+
+// STL includes
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace AndGen
+{
+	/// <summary>
+	/// Recycled pool of coroutine frames for each size class, shared between all threads
+	/// </summary>
+	/// <remarks>
+	/// Each thread keeps a cache of free frames for each size class, so allocating and releasing frames only
+	/// locks the shared pool when moving batches of frames in or out of a thread's cache.
+	/// </remarks>
+	class TaskFramePool
+	{
+	public:
+		/// <summary>
+		/// Amount of size classes, each double the size of the last
+		/// </summary>
+		static constexpr size_t SizeClassCount	= 6;
+		/// <summary>
+		/// Size in bytes of memory allocated at once when a size class has no free frames
+		/// </summary>
+		static constexpr size_t ChunkSize		= 64 * 1024;
+		/// <summary>
+		/// Frames moved between a thread's cache and the shared pool at once
+		/// </summary>
+		static constexpr size_t BatchSize		= 32;
+
+		static_assert((TaskFrameAllocator::MinPooledSize << (SizeClassCount - 1)) == TaskFrameAllocator::MaxPooledSize,
+			"Size classes should span from the smallest to the largest pooled size");
+		static_assert(TaskFrameAllocator::MinPooledSize % TaskFrameAllocator::Alignment == 0,
+			"Frames carved from an aligned chunk should all be aligned");
+
+		/// <summary>
+		/// Size class for a frame size, which must be at most the largest pooled size
+		/// </summary>
+		static size_t GetSizeClass(size_t size)
+		{
+			size_t sizeClass = 0;
+			while ((TaskFrameAllocator::MinPooledSize << sizeClass) < size)
+			{
+				sizeClass++;
+			}
+
+			return sizeClass;
+		}
+
+		/// <summary>
+		/// Allocates a frame of a size class, from the calling thread's cache if possible
+		/// </summary>
+		static void* Allocate(size_t sizeClass)
+		{
+			ThreadCache& cache = GetThreadCache();
+			if (cache.freeLists[sizeClass] == nullptr)
+			{
+				GetSharedPool().Refill(cache, sizeClass);
+			}
+
+			FreeFrame* frame				= cache.freeLists[sizeClass];
+			cache.freeLists[sizeClass]		= frame->next;
+			cache.counts[sizeClass]--;
+			cache.pooledAllocationsCount++;
+
+			return frame;
+		}
+
+		/// <summary>
+		/// Records an allocation from the heap by the calling thread, of a frame too large to pool
+		/// </summary>
+		static void CountHeapAllocation()
+		{
+			GetThreadCache().heapAllocationsCount++;
+		}
+
+		/// <summary>
+		/// Amount of frames the calling thread has allocated from its cache
+		/// </summary>
+		static size_t PooledAllocationsCount()
+		{
+			return GetThreadCache().pooledAllocationsCount;
+		}
+
+		/// <summary>
+		/// Amount of times the calling thread has allocated from the heap
+		/// </summary>
+		static size_t HeapAllocationsCount()
+		{
+			return GetThreadCache().heapAllocationsCount;
+		}
+
+		/// <summary>
+		/// Returns a frame of a size class to the calling thread's cache
+		/// </summary>
+		static void Release(void* memory, size_t sizeClass)
+		{
+			ThreadCache& cache			= GetThreadCache();
+			FreeFrame* frame			= static_cast<FreeFrame*>(memory);
+			frame->next					= cache.freeLists[sizeClass];
+			cache.freeLists[sizeClass]	= frame;
+			cache.counts[sizeClass]++;
+
+			// Return a batch to the shared pool if this thread is only releasing frames,
+			// such as a thread completing tasks started by another thread
+			if (cache.counts[sizeClass] >= BatchSize * 2)
+			{
+				GetSharedPool().Drain(cache, sizeClass, BatchSize);
+			}
+		}
+
+	private:
+		/// <summary>
+		/// Free frame, linked to the next free frame of the same size class
+		/// </summary>
+		struct FreeFrame
+		{
+			FreeFrame* next;
+		};
+
+		/// <summary>
+		/// Aligned block of memory, which chunks are allocated as
+		/// </summary>
+		struct alignas(TaskFrameAllocator::Alignment) Block
+		{
+			unsigned char bytes[TaskFrameAllocator::Alignment];
+		};
+
+		/// <summary>
+		/// Free frames cached by a single thread
+		/// </summary>
+		struct ThreadCache
+		{
+			std::array<FreeFrame*, SizeClassCount> freeLists{};
+			std::array<size_t, SizeClassCount> counts{};
+			size_t pooledAllocationsCount	= 0;
+			size_t heapAllocationsCount		= 0;
+
+			~ThreadCache()
+			{
+				for (size_t i = 0; i < SizeClassCount; i++)
+				{
+					GetSharedPool().Drain(*this, i, counts[i]);
+				}
+			}
+		};
+
+		// Free frames available to all threads, for each size class
+		std::array<FreeFrame*, SizeClassCount> m_freeLists{};
+		// Chunks of memory allocated by the pool
+		std::vector<std::unique_ptr<Block[]>> m_chunks;
+		// Mutex to ensure thread safety when accessing the free lists
+		std::mutex m_mutex;
+
+		static TaskFramePool& GetSharedPool()
+		{
+			static TaskFramePool sharedPool;
+			return sharedPool;
+		}
+
+		static ThreadCache& GetThreadCache()
+		{
+			// Ensure shared pool outlives all thread caches
+			GetSharedPool();
+
+			static thread_local ThreadCache cache;
+			return cache;
+		}
+
+		// Moves a batch of free frames into a thread's cache, carving a new chunk if none are free
+		void Refill(ThreadCache& cache, size_t sizeClass)
+		{
+			std::scoped_lock<std::mutex> lock(m_mutex);
+
+			size_t frameSize = TaskFrameAllocator::MinPooledSize << sizeClass;
+			if (m_freeLists[sizeClass] == nullptr)
+			{
+				m_chunks.push_back(std::make_unique<Block[]>(ChunkSize / sizeof(Block)));
+				cache.heapAllocationsCount++;
+				unsigned char* chunk = reinterpret_cast<unsigned char*>(m_chunks.back().get());
+				for (size_t offset = 0; offset + frameSize <= ChunkSize; offset += frameSize)
+				{
+					FreeFrame* frame		= reinterpret_cast<FreeFrame*>(chunk + offset);
+					frame->next				= m_freeLists[sizeClass];
+					m_freeLists[sizeClass]	= frame;
+				}
+			}
+
+			for (size_t i = 0; i < BatchSize && m_freeLists[sizeClass] != nullptr; i++)
+			{
+				FreeFrame* frame			= m_freeLists[sizeClass];
+				m_freeLists[sizeClass]		= frame->next;
+				frame->next					= cache.freeLists[sizeClass];
+				cache.freeLists[sizeClass]	= frame;
+				cache.counts[sizeClass]++;
+			}
+		}
+
+		// Moves frames out of a thread's cache back into the shared pool
+		void Drain(ThreadCache& cache, size_t sizeClass, size_t count)
+		{
+			std::scoped_lock<std::mutex> lock(m_mutex);
+
+			for (size_t i = 0; i < count && cache.freeLists[sizeClass] != nullptr; i++)
+			{
+				FreeFrame* frame			= cache.freeLists[sizeClass];
+				cache.freeLists[sizeClass]	= frame->next;
+				frame->next					= m_freeLists[sizeClass];
+				m_freeLists[sizeClass]		= frame;
+				cache.counts[sizeClass]--;
+			}
+		}
+	};
+}
+
+// Allocates memory for a coroutine frame
+void* AndGen::TaskFrameAllocator::Allocate(size_t size)
+{
+	if (size > MaxPooledSize)
+	{
+		TaskFramePool::CountHeapAllocation();
+		return ::operator new(size, std::align_val_t(Alignment));
+	}
+
+	return TaskFramePool::Allocate(TaskFramePool::GetSizeClass(size));
+}
+
+// Returns memory for a coroutine frame
+void AndGen::TaskFrameAllocator::Deallocate(void* frame, size_t size)
+{
+	if (size > MaxPooledSize)
+	{
+		::operator delete(frame, std::align_val_t(Alignment));
+		return;
+	}
+
+	TaskFramePool::Release(frame, TaskFramePool::GetSizeClass(size));
+}
+
+// Amount of frames the calling thread has allocated from the recycled pools
+size_t AndGen::TaskFrameAllocator::PooledAllocationsCount()
+{
+	return TaskFramePool::PooledAllocationsCount();
+}
+
+// Amount of times the calling thread has allocated from the heap
+size_t AndGen::TaskFrameAllocator::HeapAllocationsCount()
+{
+	return TaskFramePool::HeapAllocationsCount();
+}
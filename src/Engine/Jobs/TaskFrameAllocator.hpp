@@ -0,0 +1,66 @@
+#ifndef TASKFRAMEALLOCATOR_H
+#define TASKFRAMEALLOCATOR_H
+
+// STL includes
+#include <cstddef>
+
+namespace AndGen
+{
+	/// <summary>
+	/// Allocates coroutine frames for <see cref="Task"/>, and other small objects created for each job
+	/// </summary>
+	/// <remarks>
+	/// <para>Frames are rounded up to a size class and allocated from recycled free lists, with a cache of free
+	/// frames per thread for each size class, so creating tasks doesn't allocate once the allocator has warmed
+	/// up. Frames larger than <see cref="MaxPooledSize"/> are allocated directly.</para>
+	/// <para>The jobs created by <see cref="JobFuture"/>, through <see cref="PooledAllocator"/>, and the nodes
+	/// linking jobs to the jobs depending on them are allocated here too.</para>
+	/// </remarks>
+	class TaskFrameAllocator
+	{
+	public:
+		/// <summary>
+		/// Size in bytes of the smallest size class
+		/// </summary>
+		static constexpr size_t MinPooledSize = 128;
+		/// <summary>
+		/// Size in bytes of the largest size class
+		/// </summary>
+		static constexpr size_t MaxPooledSize = 4096;
+		/// <summary>
+		/// Alignment in bytes of all memory allocated, which is a cache line
+		/// </summary>
+		static constexpr size_t Alignment = 64;
+
+		TaskFrameAllocator() = delete;
+
+		/// <summary>
+		/// Allocates memory for a coroutine frame
+		/// </summary>
+		/// <param name="size">Size of frame in bytes</param>
+		/// <returns>Memory aligned to <see cref="Alignment"/></returns>
+		static void* Allocate(size_t size);
+
+		/// <summary>
+		/// Returns memory for a coroutine frame
+		/// </summary>
+		/// <param name="frame">Memory returned by <see cref="Allocate"/></param>
+		/// <param name="size">Size given to <see cref="Allocate"/></param>
+		static void Deallocate(void* frame, size_t size);
+
+		/// <summary>
+		/// Amount of frames the calling thread has allocated from the recycled pools
+		/// </summary>
+		static size_t PooledAllocationsCount();
+		/// <summary>
+		/// Amount of times the calling thread has allocated from the heap, for a new chunk of frames or a frame
+		/// too large to pool
+		/// </summary>
+		/// <remarks>
+		/// Once the pools have warmed up, this should only grow occasionally while allocating pooled frames.
+		/// </remarks>
+		static size_t HeapAllocationsCount();
+	};
+}
+
+#endif
@@ -0,0 +1,59 @@
+#include "Barrier.hpp"
+
+// STL includes
+#include <stdexcept>
+// AndGen includes
+#include "Futex.hpp"
+#include "SpinWait.hpp"
+
+// Constructs a new barrier
+AndGen::Barrier::Barrier(std::uint32_t threadCount) :
+	m_threadCount(threadCount), m_arrivedCount(0), m_phase(0), m_waitingCount(0)
+{
+	if (threadCount == 0)
+	{
+		throw std::invalid_argument("A barrier must wait for at least one thread");
+	}
+}
+
+// Arrives at the barrier, and blocks until all threads have arrived for the current phase
+bool AndGen::Barrier::ArriveAndWait()
+{
+	// Read the phase before arriving, as the last thread moves to the next phase once all have arrived
+	std::uint32_t phase = m_phase.load(std::memory_order_acquire);
+	if (m_arrivedCount.fetch_add(1, std::memory_order_acq_rel) + 1 == m_threadCount)
+	{
+		// Reset arrivals before releasing threads, which may arrive again for the next phase straight away
+		m_arrivedCount.store(0, std::memory_order_relaxed);
+		m_phase.store(phase + 1, std::memory_order_seq_cst);
+
+		if (m_waitingCount.load(std::memory_order_seq_cst) > 0)
+		{
+			Futex::WakeAll(m_phase);
+		}
+
+		return true;
+	}
+
+	// Spin briefly, as the last threads are often about to arrive
+	SpinBackoff backoff;
+	while (!backoff.ShouldBlock())
+	{
+		if (m_phase.load(std::memory_order_acquire) != phase)
+		{
+			return false;
+		}
+
+		backoff.Pause();
+	}
+
+	// Count this thread as waiting before checking the phase again, pairing with the last thread to arrive
+	m_waitingCount.fetch_add(1, std::memory_order_seq_cst);
+	while (m_phase.load(std::memory_order_seq_cst) == phase)
+	{
+		Futex::Wait(m_phase, phase);
+	}
+	m_waitingCount.fetch_sub(1, std::memory_order_relaxed);
+
+	return false;
+}
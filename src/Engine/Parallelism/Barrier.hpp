@@ -0,0 +1,66 @@
+#ifndef BARRIER_H
+#define BARRIER_H
+
+// STL includes
+#include <atomic>
+#include <cstdint>
+
+namespace AndGen
+{
+	/// <summary>
+	/// Reusable barrier, which blocks a set amount of threads until all of them have arrived
+	/// </summary>
+	/// <remarks>
+	/// <para>Once the last thread arrives the barrier moves to its next phase and is immediately ready for
+	/// reuse, so threads can synchronise on the same barrier once per frame without any setup.</para>
+	/// <para>Waiting spins briefly before blocking on a futex, and the last thread to arrive only makes
+	/// a system call when threads are blocked. The arrival count and phase are kept on their own cache line.</para>
+	/// </remarks>
+	class alignas(64) Barrier
+	{
+	public:
+		/// <summary>
+		/// Constructs a new barrier
+		/// </summary>
+		/// <param name="threadCount">Amount of threads which must arrive for each phase to complete</param>
+		/// <exception cref="std::invalid_argument">Thrown when the thread count is zero</exception>
+		explicit Barrier(std::uint32_t threadCount);
+		Barrier(const Barrier&)				= delete;
+		Barrier& operator=(const Barrier&)	= delete;
+		~Barrier()							= default;
+
+		/// <summary>
+		/// Amount of threads which must arrive for each phase to complete
+		/// </summary>
+		inline std::uint32_t ThreadCount() const
+		{
+			return m_threadCount;
+		}
+
+		/// <summary>
+		/// Amount of phases which have completed
+		/// </summary>
+		inline std::uint32_t Phase() const
+		{
+			return m_phase.load(std::memory_order_acquire);
+		}
+
+		/// <summary>
+		/// Arrives at the barrier, and blocks until all threads have arrived for the current phase
+		/// </summary>
+		/// <returns>True for the last thread to arrive, which completed the phase, otherwise false</returns>
+		bool ArriveAndWait();
+
+	private:
+		// Amount of threads which must arrive for each phase to complete
+		const std::uint32_t m_threadCount;
+		// Amount of threads which have arrived for the current phase
+		std::atomic<std::uint32_t> m_arrivedCount;
+		// Amount of phases which have completed, waited on by threads which have arrived
+		std::atomic<std::uint32_t> m_phase;
+		// Amount of threads blocked, or about to block, waiting for the current phase
+		std::atomic<std::uint32_t> m_waitingCount;
+	};
+}
+
+#endif
@@ -0,0 +1,35 @@
+#include "BlockingRegion.hpp"
+
+// AndGen includes
+#include "PooledThread.hpp"
+#include "ThreadPool.hpp"
+
+// Marks the calling thread as blocked
+AndGen::BlockingRegion::BlockingRegion() : m_threadPool(nullptr)
+{
+	// Only count the outermost region on each pooled thread
+	PooledThread* currentThread = PooledThread::GetCurrent();
+	if (currentThread == nullptr || currentThread->GetThreadPool() == nullptr ||
+		currentThread->m_blockingDepth++ > 0)
+	{
+		return;
+	}
+
+	m_threadPool = currentThread->GetThreadPool();
+	m_threadPool->BeginBlocking();
+}
+
+// Marks the calling thread as no longer blocked
+AndGen::BlockingRegion::~BlockingRegion()
+{
+	PooledThread* currentThread = PooledThread::GetCurrent();
+	if (currentThread != nullptr && currentThread->GetThreadPool() != nullptr)
+	{
+		currentThread->m_blockingDepth--;
+	}
+
+	if (m_threadPool != nullptr)
+	{
+		m_threadPool->EndBlocking();
+	}
+}
@@ -0,0 +1,39 @@
+#ifndef BLOCKINGREGION_H
+#define BLOCKINGREGION_H
+
+namespace AndGen
+{
+	// Pre-declarations
+	class ThreadPool;
+
+	/// <summary>
+	/// Marks the calling thread as blocked for the lifetime of the region, such as while waiting on file I/O
+	/// </summary>
+	/// <remarks>
+	/// <para>Jobs which block should construct a region around the blocking call, so an elastic
+	/// <see cref="ThreadPool"/> can start a temporary thread to keep its cores busy meanwhile.
+	/// See <see cref="ElasticPolicy"/> for when threads are added and retired.</para>
+	/// <para>Regions constructed outside of a pooled thread do nothing, and regions nested within another region
+	/// on the same thread are only counted once.</para>
+	/// </remarks>
+	class BlockingRegion
+	{
+	public:
+		/// <summary>
+		/// Marks the calling thread as blocked
+		/// </summary>
+		BlockingRegion();
+		BlockingRegion(const BlockingRegion&)				= delete;
+		BlockingRegion& operator=(const BlockingRegion&)	= delete;
+		/// <summary>
+		/// Marks the calling thread as no longer blocked
+		/// </summary>
+		~BlockingRegion();
+
+	private:
+		// Thread pool the calling thread belongs to, if the region was counted
+		ThreadPool* m_threadPool;
+	};
+}
+
+#endif
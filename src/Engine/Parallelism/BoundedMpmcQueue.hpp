@@ -0,0 +1,194 @@
+#ifndef BOUNDEDMPMCQUEUE_H
+#define BOUNDEDMPMCQUEUE_H
+
+// STL includes
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+namespace AndGen
+{
+	/// <summary>
+	/// Lock-free bounded multi-producer multi-consumer FIFO queue
+	/// </summary>
+	/// <remarks>
+	/// <para>Based on Dmitry Vyukov's bounded MPMC queue. Each slot of a fixed size ring holds a sequence number,
+	/// which tells producers and consumers whether the slot is free to write or ready to read for their lap of
+	/// the ring. Producers and consumers each claim a position with a single compare-exchange, and never wait
+	/// on each other unless the queue is full or empty.</para>
+	/// <para>Pushing fails rather than growing once the queue is full, so callers must handle a full queue.</para>
+	/// </remarks>
+	/// <typeparam name="ItemType">Type of item stored, which must be trivially copyable</typeparam>
+	template<class ItemType>
+	class BoundedMpmcQueue
+	{
+		static_assert(std::is_trivially_copyable<ItemType>::value,
+			"BoundedMpmcQueue items must be trivially copyable");
+
+	public:
+		/// <summary>
+		/// Constructs a new bounded queue
+		/// </summary>
+		/// <param name="capacity">Most items the queue holds, rounded up to a power of two of at least 2</param>
+		explicit BoundedMpmcQueue(size_t capacity = 1024) : m_enqueuePosition(0), m_dequeuePosition(0)
+		{
+			size_t roundedCapacity = 2;
+			while (roundedCapacity < capacity)
+			{
+				roundedCapacity <<= 1;
+			}
+
+			m_mask	= roundedCapacity - 1;
+			m_slots	= std::make_unique<Slot[]>(roundedCapacity);
+			for (size_t i = 0; i < roundedCapacity; i++)
+			{
+				m_slots[i].sequence.store(i, std::memory_order_relaxed);
+			}
+		}
+		BoundedMpmcQueue(const BoundedMpmcQueue&)				= delete;
+		BoundedMpmcQueue& operator=(const BoundedMpmcQueue&)	= delete;
+
+		/// <summary>
+		/// Pushes an item onto the back of the queue
+		/// </summary>
+		/// <remarks>
+		/// May be called from any thread
+		/// </remarks>
+		/// <param name="item">Item to push</param>
+		/// <returns>True if the item was pushed, otherwise false if the queue was full</returns>
+		bool TryPush(ItemType item)
+		{
+			size_t position = m_enqueuePosition.load(std::memory_order_relaxed);
+			for (;;)
+			{
+				Slot& slot					= m_slots[position & m_mask];
+				size_t sequence				= slot.sequence.load(std::memory_order_acquire);
+				std::intptr_t difference	= static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+
+				// Slot is free for this lap, so claim it
+				if (difference == 0)
+				{
+					if (m_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+					{
+						slot.item = item;
+						// Publish item to consumers of this lap
+						slot.sequence.store(position + 1, std::memory_order_release);
+						return true;
+					}
+				}
+				// Slot still holds an item from the previous lap, so the queue is full
+				else if (difference < 0)
+				{
+					return false;
+				}
+				// Another producer claimed the slot, try again from the latest position
+				else
+				{
+					position = m_enqueuePosition.load(std::memory_order_relaxed);
+				}
+			}
+		}
+
+		/// <summary>
+		/// Pops an item from the front of the queue
+		/// </summary>
+		/// <remarks>
+		/// May be called from any thread
+		/// </remarks>
+		/// <param name="item">Set to the popped item, if successful</param>
+		/// <returns>True if an item was popped, otherwise false if the queue was empty</returns>
+		bool TryPop(ItemType& item)
+		{
+			size_t position = m_dequeuePosition.load(std::memory_order_relaxed);
+			for (;;)
+			{
+				Slot& slot					= m_slots[position & m_mask];
+				size_t sequence				= slot.sequence.load(std::memory_order_acquire);
+				std::intptr_t difference	= static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position + 1);
+
+				// Slot holds an item for this lap, so claim it
+				if (difference == 0)
+				{
+					if (m_dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+					{
+						item = slot.item;
+						// Free the slot for producers of the next lap
+						slot.sequence.store(position + m_mask + 1, std::memory_order_release);
+						return true;
+					}
+				}
+				// Slot hasn't been written for this lap, so the queue is empty
+				else if (difference < 0)
+				{
+					return false;
+				}
+				// Another consumer claimed the slot, try again from the latest position
+				else
+				{
+					position = m_dequeuePosition.load(std::memory_order_relaxed);
+				}
+			}
+		}
+
+		/// <summary>
+		/// Approximate amount of items within the queue
+		/// </summary>
+		/// <remarks>
+		/// Positions are read without synchronising with producers and consumers, so the count may be stale,
+		/// but is always between zero and the queue's capacity.
+		/// </remarks>
+		inline size_t Count() const
+		{
+			size_t dequeuePosition = m_dequeuePosition.load(std::memory_order_relaxed);
+			size_t enqueuePosition = m_enqueuePosition.load(std::memory_order_relaxed);
+			if (enqueuePosition <= dequeuePosition)
+			{
+				return 0;
+			}
+
+			size_t count = enqueuePosition - dequeuePosition;
+			return count < Capacity() ? count : Capacity();
+		}
+
+		/// <summary>
+		/// Is the queue (approximately) empty?
+		/// </summary>
+		inline bool IsEmpty() const
+		{
+			return Count() == 0;
+		}
+
+		/// <summary>
+		/// Most items the queue holds
+		/// </summary>
+		inline size_t Capacity() const
+		{
+			return m_mask + 1;
+		}
+
+	private:
+		/// <summary>
+		/// Slot of the ring, holding an item and the lap it's ready for
+		/// </summary>
+		struct Slot
+		{
+			// Position the slot is next free to be written at, or one past the position it was written at
+			std::atomic<size_t> sequence;
+			// Item stored within the slot
+			ItemType item;
+		};
+
+		// Mask used to wrap positions into the ring
+		size_t m_mask;
+		// Slots of the ring
+		std::unique_ptr<Slot[]> m_slots;
+		// Position of the next slot for producers to write
+		alignas(64) std::atomic<size_t> m_enqueuePosition;
+		// Position of the next slot for consumers to read
+		alignas(64) std::atomic<size_t> m_dequeuePosition;
+	};
+}
+
+#endif
@@ -0,0 +1,352 @@
+#include "CpuTopology.hpp"
+
+// STL includes
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <thread>
+#include <tuple>
+
+#if defined(__linux__)
+// Linux includes
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// Reads the first line of a file, returning false if it couldn't be read
+static bool ReadLine(const std::string& path, std::string& line)
+{
+	std::ifstream file(path);
+	return static_cast<bool>(std::getline(file, line));
+}
+
+// Reads an unsigned integer from a file, returning false if it couldn't be read
+static bool ReadUnsigned(const std::string& path, unsigned int& value)
+{
+	std::string line;
+	if (!ReadLine(path, line))
+	{
+		return false;
+	}
+
+	std::istringstream stream(line);
+	return static_cast<bool>(stream >> value);
+}
+
+// Parses a sysfs CPU list, such as "0-3,8-11"
+static std::vector<unsigned int> ParseCpuList(const std::string& list)
+{
+	std::vector<unsigned int> cpus;
+	std::istringstream stream(list);
+	std::string range;
+	while (std::getline(stream, range, ','))
+	{
+		unsigned int first	= 0;
+		unsigned int last	= 0;
+		char separator		= '\0';
+		std::istringstream rangeStream(range);
+		if (!(rangeStream >> first))
+		{
+			continue;
+		}
+		last = first;
+		if (rangeStream >> separator && separator == '-')
+		{
+			rangeStream >> last;
+		}
+
+		for (unsigned int cpu = first; cpu <= last; cpu++)
+		{
+			cpus.push_back(cpu);
+		}
+	}
+
+	return cpus;
+}
+
+// Reads the lowest CPU identifier within a sysfs CPU list file, returning false if it couldn't be read
+static bool ReadFirstCpu(const std::string& path, unsigned int& cpu)
+{
+	std::string line;
+	if (!ReadLine(path, line))
+	{
+		return false;
+	}
+
+	std::vector<unsigned int> cpus = ParseCpuList(line);
+	if (cpus.empty())
+	{
+		return false;
+	}
+
+	cpu = *std::min_element(cpus.begin(), cpus.end());
+	return true;
+}
+
+// Reads the topology of the CPUs available to the process
+AndGen::CpuTopology::CpuTopology()
+{
+	Read("/sys/devices/system/cpu", true);
+}
+
+// Reads the topology of CPUs from a sysfs CPU directory
+AndGen::CpuTopology::CpuTopology(const std::string& sysfsPath)
+{
+	Read(sysfsPath, false);
+}
+
+// Topology of the CPUs available to the process, read once
+const AndGen::CpuTopology& AndGen::CpuTopology::Get()
+{
+	static const CpuTopology topology;
+	return topology;
+}
+
+// Amount of physical cores
+size_t AndGen::CpuTopology::PhysicalCoreCount() const
+{
+	std::vector<unsigned int> cores;
+	for (size_t i = 0; i < m_cpus.size(); i++)
+	{
+		if (std::find(cores.begin(), cores.end(), m_cpus[i].core) == cores.end())
+		{
+			cores.push_back(m_cpus[i].core);
+		}
+	}
+
+	return cores.size();
+}
+
+// How closely two logical CPUs share hardware
+AndGen::CpuTopology::Distance AndGen::CpuTopology::GetDistance(unsigned int first, unsigned int second) const
+{
+	const Cpu* firstCpu		= FindCpu(first);
+	const Cpu* secondCpu	= FindCpu(second);
+	if (firstCpu == nullptr || secondCpu == nullptr)
+	{
+		return Distance::Remote;
+	}
+
+	if (firstCpu->id == secondCpu->id)
+	{
+		return Distance::SameCpu;
+	}
+	if (firstCpu->core == secondCpu->core)
+	{
+		return Distance::SameCore;
+	}
+	if (firstCpu->l2Group == secondCpu->l2Group)
+	{
+		return Distance::SameL2;
+	}
+	if (firstCpu->l3Group == secondCpu->l3Group)
+	{
+		return Distance::SameL3;
+	}
+	if (firstCpu->package == secondCpu->package)
+	{
+		return Distance::SamePackage;
+	}
+
+	return Distance::Remote;
+}
+
+// Selects logical CPUs to place threads on, spreading them across physical cores
+std::vector<unsigned int> AndGen::CpuTopology::SelectCpus(size_t count, int reservedCpu) const
+{
+	if (m_cpus.empty() || count == 0)
+	{
+		return {};
+	}
+
+	// Group hardware threads by core
+	std::map<unsigned int, std::vector<const Cpu*>> coreThreads;
+	for (size_t i = 0; i < m_cpus.size(); i++)
+	{
+		coreThreads[m_cpus[i].core].push_back(&m_cpus[i]);
+	}
+
+	// Order cores by capacity, then so cores sharing caches are next to each other
+	std::vector<const std::vector<const Cpu*>*> cores;
+	for (const std::pair<const unsigned int, std::vector<const Cpu*>>& core : coreThreads)
+	{
+		cores.push_back(&core.second);
+	}
+	std::stable_sort(cores.begin(), cores.end(),
+		[](const std::vector<const Cpu*>* first, const std::vector<const Cpu*>* second)
+		{
+			const Cpu& a = *first->front();
+			const Cpu& b = *second->front();
+			return std::make_tuple(b.capacity, a.package, a.l3Group, a.l2Group, a.core) <
+				std::make_tuple(a.capacity, b.package, b.l3Group, b.l2Group, b.core);
+		});
+
+	// Move the reserved core to the end, so its hardware threads are only used once all others are
+	const Cpu* reserved = reservedCpu >= 0 ? FindCpu(static_cast<unsigned int>(reservedCpu)) : nullptr;
+	const std::vector<const Cpu*>* reservedCore = nullptr;
+	if (reserved != nullptr && cores.size() > 1)
+	{
+		std::vector<const std::vector<const Cpu*>*>::iterator core = std::find(cores.begin(), cores.end(),
+			&coreThreads[reserved->core]);
+		reservedCore = *core;
+		cores.erase(core);
+	}
+
+	// Give each core its first hardware thread, then each core its second, and so on
+	std::vector<unsigned int> order;
+	order.reserve(m_cpus.size());
+	for (size_t thread = 0; order.size() < m_cpus.size() - (reservedCore != nullptr ? reservedCore->size() : 0);
+		thread++)
+	{
+		for (size_t i = 0; i < cores.size(); i++)
+		{
+			if (thread < cores[i]->size())
+			{
+				order.push_back((*cores[i])[thread]->id);
+			}
+		}
+	}
+	if (reservedCore != nullptr)
+	{
+		for (size_t i = 0; i < reservedCore->size(); i++)
+		{
+			order.push_back((*reservedCore)[i]->id);
+		}
+	}
+
+	// Reuse CPUs in the same order once each has a thread
+	std::vector<unsigned int> cpus(count);
+	for (size_t i = 0; i < count; i++)
+	{
+		cpus[i] = order[i % order.size()];
+	}
+
+	return cpus;
+}
+
+#if defined(__linux__)
+
+// Identifier of the logical CPU the calling thread is currently executing on
+int AndGen::CpuTopology::GetCurrentCpu()
+{
+	return sched_getcpu();
+}
+
+// Restricts the calling thread to execute only on a single logical CPU
+bool AndGen::CpuTopology::PinCurrentThread(unsigned int cpu)
+{
+	if (cpu >= CPU_SETSIZE)
+	{
+		return false;
+	}
+
+	cpu_set_t cpuSet;
+	CPU_ZERO(&cpuSet);
+	CPU_SET(cpu, &cpuSet);
+
+	return pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet) == 0;
+}
+
+#else
+
+// Identifier of the logical CPU the calling thread is currently executing on
+int AndGen::CpuTopology::GetCurrentCpu()
+{
+	return -1;
+}
+
+// Restricts the calling thread to execute only on a single logical CPU
+bool AndGen::CpuTopology::PinCurrentThread(unsigned int)
+{
+	return false;
+}
+
+#endif
+
+// Reads CPUs from a sysfs CPU directory, optionally restricted to the process's affinity mask
+void AndGen::CpuTopology::Read(const std::string& sysfsPath, bool useAffinity)
+{
+	std::string onlineList;
+	std::vector<unsigned int> ids;
+	if (ReadLine(sysfsPath + "/online", onlineList))
+	{
+		ids = ParseCpuList(onlineList);
+	}
+
+#if defined(__linux__)
+	if (useAffinity)
+	{
+		cpu_set_t cpuSet;
+		CPU_ZERO(&cpuSet);
+		if (sched_getaffinity(0, sizeof(cpuSet), &cpuSet) == 0)
+		{
+			ids.erase(std::remove_if(ids.begin(), ids.end(),
+				[&cpuSet](unsigned int id) { return id >= CPU_SETSIZE || !CPU_ISSET(id, &cpuSet); }), ids.end());
+		}
+	}
+#endif
+
+	for (size_t i = 0; i < ids.size(); i++)
+	{
+		std::string cpuPath = sysfsPath + "/cpu" + std::to_string(ids[i]);
+
+		Cpu cpu = { ids[i], ids[i], 0, ids[i], 0, 0 };
+		ReadFirstCpu(cpuPath + "/topology/thread_siblings_list", cpu.core);
+		ReadUnsigned(cpuPath + "/topology/physical_package_id", cpu.package);
+		cpu.l2Group = cpu.core;
+		cpu.l3Group = UINT32_MAX - cpu.package;
+
+		// Find the CPUs sharing each unified or data cache
+		for (unsigned int index = 0; ; index++)
+		{
+			std::string cachePath = cpuPath + "/cache/index" + std::to_string(index);
+			unsigned int level = 0;
+			std::string type;
+			if (!ReadUnsigned(cachePath + "/level", level))
+			{
+				break;
+			}
+			if (!ReadLine(cachePath + "/type", type) || type == "Instruction")
+			{
+				continue;
+			}
+
+			if (level == 2)
+			{
+				ReadFirstCpu(cachePath + "/shared_cpu_list", cpu.l2Group);
+			}
+			else if (level == 3)
+			{
+				ReadFirstCpu(cachePath + "/shared_cpu_list", cpu.l3Group);
+			}
+		}
+
+		// Prefer the scheduler's capacity, otherwise the highest frequency, to tell core types apart
+		if (!ReadUnsigned(cpuPath + "/cpu_capacity", cpu.capacity))
+		{
+			ReadUnsigned(cpuPath + "/cpufreq/cpuinfo_max_freq", cpu.capacity);
+		}
+
+		m_cpus.push_back(cpu);
+	}
+
+	// Treat each hardware thread as its own core when sysfs couldn't be read
+	if (m_cpus.empty())
+	{
+		unsigned int cpuCount = std::max(1u, std::thread::hardware_concurrency());
+		for (unsigned int id = 0; id < cpuCount; id++)
+		{
+			m_cpus.push_back({ id, id, 0, id, id, 0 });
+		}
+	}
+}
+
+// Finds a CPU by identifier
+const AndGen::CpuTopology::Cpu* AndGen::CpuTopology::FindCpu(unsigned int id) const
+{
+	std::vector<Cpu>::const_iterator cpu = std::lower_bound(m_cpus.begin(), m_cpus.end(), id,
+		[](const Cpu& cpu, unsigned int id) { return cpu.id < id; });
+
+	return cpu != m_cpus.end() && cpu->id == id ? &*cpu : nullptr;
+}
@@ -0,0 +1,149 @@
+#ifndef CPUTOPOLOGY_H
+#define CPUTOPOLOGY_H
+
+// STL includes
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace AndGen
+{
+	/// <summary>
+	/// Layout of the logical CPUs available to the process, and the cores and caches they share
+	/// </summary>
+	/// <remarks>
+	/// On Linux the topology is read from sysfs, including each CPU's core, package and the CPUs sharing its
+	/// L2 and L3 caches, along with its capacity to tell performance and efficiency cores apart on hybrid
+	/// processors. Only CPUs within the process's affinity mask are included. On other platforms, or when sysfs
+	/// can't be read, each hardware thread is treated as its own core with no shared caches.
+	/// </remarks>
+	class CpuTopology
+	{
+	public:
+		/// <summary>
+		/// How closely two logical CPUs share hardware, from closest to furthest
+		/// </summary>
+		enum class Distance
+		{
+			/// <summary>
+			/// The same logical CPU
+			/// </summary>
+			SameCpu,
+			/// <summary>
+			/// Hardware threads of the same physical core
+			/// </summary>
+			SameCore,
+			/// <summary>
+			/// Different cores sharing an L2 cache
+			/// </summary>
+			SameL2,
+			/// <summary>
+			/// Different cores sharing an L3 cache, such as within a single CCX
+			/// </summary>
+			SameL3,
+			/// <summary>
+			/// Different cores within the same package, which share no cache
+			/// </summary>
+			SamePackage,
+			/// <summary>
+			/// Cores within different packages
+			/// </summary>
+			Remote
+		};
+
+		/// <summary>
+		/// Logical CPU, such as a single hardware thread of a core
+		/// </summary>
+		struct Cpu
+		{
+			// Identifier of the CPU, as used by the operating system
+			unsigned int id;
+			// Identifier of the physical core, which is the lowest CPU identifier among its hardware threads
+			unsigned int core;
+			// Identifier of the physical package
+			unsigned int package;
+			// Lowest CPU identifier sharing this CPU's L2 cache, or this CPU's core when unknown
+			unsigned int l2Group;
+			// Lowest CPU identifier sharing this CPU's L3 cache, or a value shared only within its package when unknown
+			unsigned int l3Group;
+			// Relative performance of the CPU, higher for performance cores, or zero when unknown
+			unsigned int capacity;
+		};
+
+		/// <summary>
+		/// Reads the topology of the CPUs available to the process
+		/// </summary>
+		CpuTopology();
+		/// <summary>
+		/// Reads the topology of CPUs from a sysfs CPU directory, such as a copy of /sys/devices/system/cpu
+		/// </summary>
+		/// <remarks>
+		/// All online CPUs are included, regardless of the process's affinity mask.
+		/// </remarks>
+		/// <param name="sysfsPath">Path to the sysfs CPU directory</param>
+		explicit CpuTopology(const std::string& sysfsPath);
+
+		/// <summary>
+		/// Topology of the CPUs available to the process, read once
+		/// </summary>
+		static const CpuTopology& Get();
+
+		/// <summary>
+		/// Logical CPUs, ordered by identifier
+		/// </summary>
+		inline const std::vector<Cpu>& GetCpus() const
+		{
+			return m_cpus;
+		}
+
+		/// <summary>
+		/// Amount of physical cores, counting each core once however many hardware threads it has
+		/// </summary>
+		size_t PhysicalCoreCount() const;
+
+		/// <summary>
+		/// How closely two logical CPUs share hardware
+		/// </summary>
+		/// <param name="first">Identifier of the first CPU</param>
+		/// <param name="second">Identifier of the second CPU</param>
+		/// <returns>Distance between the CPUs, or <see cref="Distance::Remote"/> if either isn't known</returns>
+		Distance GetDistance(unsigned int first, unsigned int second) const;
+
+		/// <summary>
+		/// Selects logical CPUs to place threads on, spreading them across physical cores
+		/// </summary>
+		/// <remarks>
+		/// Each physical core is given one thread before any core is given a second, with the highest capacity
+		/// cores first and cores sharing caches next to each other. The reserved CPU's core is only used once every
+		/// other CPU has a thread, and CPUs are reused in the same order once every CPU has a thread.
+		/// </remarks>
+		/// <param name="count">Amount of threads to place</param>
+		/// <param name="reservedCpu">CPU whose core is kept free for another thread if possible, if any</param>
+		/// <returns>Identifier of the CPU for each thread, or empty if no CPUs are known</returns>
+		std::vector<unsigned int> SelectCpus(size_t count, int reservedCpu = -1) const;
+
+		/// <summary>
+		/// Identifier of the logical CPU the calling thread is currently executing on
+		/// </summary>
+		/// <returns>Identifier of the CPU, or -1 if unknown</returns>
+		static int GetCurrentCpu();
+
+		/// <summary>
+		/// Restricts the calling thread to execute only on a single logical CPU
+		/// </summary>
+		/// <param name="cpu">Identifier of the CPU</param>
+		/// <returns>True if the thread was pinned, otherwise false</returns>
+		static bool PinCurrentThread(unsigned int cpu);
+
+	private:
+		// Logical CPUs, ordered by identifier
+		std::vector<Cpu> m_cpus;
+
+		// Reads CPUs from a sysfs CPU directory, optionally restricted to the process's affinity mask
+		void Read(const std::string& sysfsPath, bool useAffinity);
+		// Finds a CPU by identifier
+		const Cpu* FindCpu(unsigned int id) const;
+	};
+}
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef ELASTICPOLICY_H
+#define ELASTICPOLICY_H
+
+// STL includes
+#include <chrono>
+
+namespace AndGen
+{
+	/// <summary>
+	/// Controls how a thread pool adds and retires threads as its load changes
+	/// </summary>
+	/// <remarks>
+	/// <para>A pool starts with the amount of threads it's constructed with, and tries to keep that many threads
+	/// executing jobs. When a thread enters a <see cref="BlockingRegion"/> while no thread is sleeping,
+	/// the pool starts a temporary thread to make up for it, up to <see cref="maxThreadCount"/> threads.</para>
+	/// <para>Threads beyond <see cref="minThreadCount"/> retire once they have slept without jobs for
+	/// <see cref="retireTimeout"/>, or once they finish a job while more threads are executing than needed.
+	/// Only the first <see cref="minThreadCount"/> threads are given jobs queued from outside the pool,
+	/// the rest steal their jobs.</para>
+	/// </remarks>
+	struct ElasticPolicy
+	{
+		/// <summary>
+		/// Amount of threads which never retire, or zero to never retire any of the pool's initial threads
+		/// </summary>
+		unsigned int minThreadCount					= 0;
+		/// <summary>
+		/// Most threads the pool runs at once, or zero to never add temporary threads
+		/// </summary>
+		unsigned int maxThreadCount					= 0;
+		/// <summary>
+		/// Time a thread which may retire sleeps without jobs before retiring
+		/// </summary>
+		std::chrono::milliseconds retireTimeout		= std::chrono::milliseconds(500);
+
+		/// <summary>
+		/// Policy keeping the pool's threads fixed at the amount it's constructed with
+		/// </summary>
+		static ElasticPolicy Fixed()
+		{
+			return ElasticPolicy();
+		}
+
+		/// <summary>
+		/// Policy growing and shrinking the pool between a minimum and maximum amount of threads
+		/// </summary>
+		/// <param name="minThreadCount">Amount of threads which never retire, at least one</param>
+		/// <param name="maxThreadCount">Most threads the pool runs at once</param>
+		/// <param name="retireTimeout">Time a thread which may retire sleeps without jobs before retiring</param>
+		static ElasticPolicy Elastic(unsigned int minThreadCount, unsigned int maxThreadCount,
+			std::chrono::milliseconds retireTimeout = std::chrono::milliseconds(500))
+		{
+			return ElasticPolicy{ minThreadCount > 0 ? minThreadCount : 1, maxThreadCount, retireTimeout };
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,286 @@
+#include "Fiber.hpp"
+
+// STL includes
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <vector>
+// AndGen includes
+#include <AndGen/Exceptions/NotImplementedException.hpp>
+
+#if ANDGEN_FIBERS_SUPPORTED
+// Linux includes
+#include <sys/mman.h>
+#include <unistd.h>
+
+// Saves the calling context's registers and stack pointer, then restores another context's
+extern "C" void AndGen_SwitchFiberContext(void** fromStackPointer, void* toStackPointer);
+// First function entered by a new fiber, calling its entry function with its argument
+extern "C" void AndGen_FiberTrampoline();
+
+#if defined(__x86_64__)
+// System V x86-64: preserves rbp, rbx, r12-r15, and the x87 and SSE control words.
+// New fibers hold their argument in r12 and entry function in r13.
+asm(R"(
+	.text
+	.globl	AndGen_SwitchFiberContext
+	.hidden	AndGen_SwitchFiberContext
+	.type	AndGen_SwitchFiberContext, @function
+	.p2align	4
+AndGen_SwitchFiberContext:
+	pushq	%rbp
+	pushq	%rbx
+	pushq	%r12
+	pushq	%r13
+	pushq	%r14
+	pushq	%r15
+	subq	$16, %rsp
+	stmxcsr	8(%rsp)
+	fnstcw	(%rsp)
+	movq	%rsp, (%rdi)
+	movq	%rsi, %rsp
+	fldcw	(%rsp)
+	ldmxcsr	8(%rsp)
+	addq	$16, %rsp
+	popq	%r15
+	popq	%r14
+	popq	%r13
+	popq	%r12
+	popq	%rbx
+	popq	%rbp
+	ret
+	.size	AndGen_SwitchFiberContext, .-AndGen_SwitchFiberContext
+
+	.globl	AndGen_FiberTrampoline
+	.hidden	AndGen_FiberTrampoline
+	.type	AndGen_FiberTrampoline, @function
+	.p2align	4
+AndGen_FiberTrampoline:
+	movq	%r12, %rdi
+	callq	*%r13
+	ud2
+	.size	AndGen_FiberTrampoline, .-AndGen_FiberTrampoline
+)");
+#elif defined(__aarch64__)
+// AAPCS64: preserves x19-x28, the frame pointer, the link register and d8-d15.
+// New fibers hold their argument in x19 and entry function in x20.
+asm(R"(
+	.text
+	.globl	AndGen_SwitchFiberContext
+	.hidden	AndGen_SwitchFiberContext
+	.type	AndGen_SwitchFiberContext, %function
+	.p2align	4
+AndGen_SwitchFiberContext:
+	sub	sp, sp, #160
+	stp	x19, x20, [sp, #0]
+	stp	x21, x22, [sp, #16]
+	stp	x23, x24, [sp, #32]
+	stp	x25, x26, [sp, #48]
+	stp	x27, x28, [sp, #64]
+	stp	x29, x30, [sp, #80]
+	stp	d8, d9, [sp, #96]
+	stp	d10, d11, [sp, #112]
+	stp	d12, d13, [sp, #128]
+	stp	d14, d15, [sp, #144]
+	mov	x2, sp
+	str	x2, [x0]
+	mov	sp, x1
+	ldp	x19, x20, [sp, #0]
+	ldp	x21, x22, [sp, #16]
+	ldp	x23, x24, [sp, #32]
+	ldp	x25, x26, [sp, #48]
+	ldp	x27, x28, [sp, #64]
+	ldp	x29, x30, [sp, #80]
+	ldp	d8, d9, [sp, #96]
+	ldp	d10, d11, [sp, #112]
+	ldp	d12, d13, [sp, #128]
+	ldp	d14, d15, [sp, #144]
+	add	sp, sp, #160
+	ret
+	.size	AndGen_SwitchFiberContext, .-AndGen_SwitchFiberContext
+
+	.globl	AndGen_FiberTrampoline
+	.hidden	AndGen_FiberTrampoline
+	.type	AndGen_FiberTrampoline, %function
+	.p2align	4
+AndGen_FiberTrampoline:
+	mov	x0, x19
+	blr	x20
+	brk	#0
+	.size	AndGen_FiberTrampoline, .-AndGen_FiberTrampoline
+)");
+#endif
+
+namespace AndGen
+{
+	/// <summary>
+	/// Recycled pool of fiber stacks, shared between all threads
+	/// </summary>
+	/// <remarks>
+	/// Stacks are mapped with a guard page below them, and are kept mapped once released
+	/// so creating fibers doesn't need to map memory once the pool has warmed up.
+	/// </remarks>
+	class FiberStackPool
+	{
+	public:
+		/// <summary>
+		/// Size in bytes of the guard page below each stack
+		/// </summary>
+		static size_t GuardSize()
+		{
+			static const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+			return pageSize;
+		}
+
+		/// <summary>
+		/// Allocates a stack, including its guard page
+		/// </summary>
+		static void* Allocate()
+		{
+			FiberStackPool& pool = GetSharedPool();
+			{
+				std::scoped_lock<std::mutex> lock(pool.m_mutex);
+				if (!pool.m_freeStacks.empty())
+				{
+					void* stack = pool.m_freeStacks.back();
+					pool.m_freeStacks.pop_back();
+
+					return stack;
+				}
+			}
+
+			// Map a new stack, with its lowest page inaccessible as stacks grow down
+			void* stack = mmap(nullptr, GuardSize() + Fiber::StackSize, PROT_READ | PROT_WRITE,
+				MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK, -1, 0);
+			if (stack == MAP_FAILED)
+			{
+				throw std::bad_alloc();
+			}
+			if (mprotect(stack, GuardSize(), PROT_NONE) != 0)
+			{
+				munmap(stack, GuardSize() + Fiber::StackSize);
+				throw std::bad_alloc();
+			}
+
+			return stack;
+		}
+
+		/// <summary>
+		/// Returns a stack to the pool
+		/// </summary>
+		static void Release(void* stack)
+		{
+			FiberStackPool& pool = GetSharedPool();
+			std::scoped_lock<std::mutex> lock(pool.m_mutex);
+			pool.m_freeStacks.push_back(stack);
+		}
+
+	private:
+		// Stacks available to be reused
+		std::vector<void*> m_freeStacks;
+		// Mutex to ensure thread safety when accessing m_freeStacks
+		std::mutex m_mutex;
+
+		~FiberStackPool()
+		{
+			for (size_t i = 0; i < m_freeStacks.size(); i++)
+			{
+				munmap(m_freeStacks[i], GuardSize() + Fiber::StackSize);
+			}
+		}
+
+		static FiberStackPool& GetSharedPool()
+		{
+			static FiberStackPool sharedPool;
+			return sharedPool;
+		}
+	};
+}
+
+// Constructs a fiber representing the calling thread's own stack
+AndGen::Fiber::Fiber() : m_stackPointer(nullptr), m_stack(nullptr)
+{
+}
+
+// Constructs a new fiber with its own stack
+AndGen::Fiber::Fiber(AndGen::Fiber::EntryFunction entry, void* argument) : m_stackPointer(nullptr), m_stack(nullptr)
+{
+	m_stack = FiberStackPool::Allocate();
+
+	// Lay out the stack as if the new fiber had called AndGen_SwitchFiberContext(),
+	// so switching to it "returns" into the trampoline
+	std::uintptr_t stackTop = (reinterpret_cast<std::uintptr_t>(m_stack) + FiberStackPool::GuardSize()
+		+ StackSize) & ~static_cast<std::uintptr_t>(15);
+#if defined(__x86_64__)
+	// Return address, rbp, rbx, r12-r15, then the x87 and SSE control words,
+	// leaving the stack 16 byte aligned once the trampoline is entered
+	void** stack = reinterpret_cast<void**>(stackTop - 16);
+	*--stack = reinterpret_cast<void*>(&AndGen_FiberTrampoline);
+	*--stack = nullptr;
+	*--stack = nullptr;
+	*--stack = argument;
+	*--stack = reinterpret_cast<void*>(entry);
+	*--stack = nullptr;
+	*--stack = nullptr;
+	stack -= 2;
+
+	std::uint32_t* controlWords = reinterpret_cast<std::uint32_t*>(stack);
+	controlWords[0] = 0x037F;
+	controlWords[1] = 0;
+	controlWords[2] = 0x1F80;
+	controlWords[3] = 0;
+#elif defined(__aarch64__)
+	// x19-x28, frame pointer, link register, then d8-d15
+	void** stack = reinterpret_cast<void**>(stackTop - 160);
+	for (size_t i = 0; i < 20; i++)
+	{
+		stack[i] = nullptr;
+	}
+	stack[0]	= argument;
+	stack[1]	= reinterpret_cast<void*>(entry);
+	stack[11]	= reinterpret_cast<void*>(&AndGen_FiberTrampoline);
+#endif
+
+	m_stackPointer = stack;
+}
+
+// Destroys this fiber, returning its stack to the pool
+AndGen::Fiber::~Fiber()
+{
+	if (m_stack != nullptr)
+	{
+		FiberStackPool::Release(m_stack);
+	}
+}
+
+// Suspends this fiber and resumes another
+void AndGen::Fiber::SwitchTo(AndGen::Fiber& fiber)
+{
+	AndGen_SwitchFiberContext(&m_stackPointer, fiber.m_stackPointer);
+}
+
+#else
+
+// Constructs a fiber representing the calling thread's own stack
+AndGen::Fiber::Fiber() : m_stackPointer(nullptr), m_stack(nullptr)
+{
+}
+
+// Constructs a new fiber with its own stack
+AndGen::Fiber::Fiber(AndGen::Fiber::EntryFunction, void*) : m_stackPointer(nullptr), m_stack(nullptr)
+{
+	throw NotImplementedException();
+}
+
+// Destroys this fiber
+AndGen::Fiber::~Fiber()
+{
+}
+
+// Suspends this fiber and resumes another
+void AndGen::Fiber::SwitchTo(AndGen::Fiber&)
+{
+	throw NotImplementedException();
+}
+
+#endif
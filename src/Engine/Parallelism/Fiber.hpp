@@ -0,0 +1,88 @@
+#ifndef FIBER_H
+#define FIBER_H
+
+// STL includes
+#include <cstddef>
+
+// Fibers are only implemented for 64-bit x86 and ARM on Linux
+#if defined(__linux__) && (defined(__x86_64__) || defined(__aarch64__))
+	#define ANDGEN_FIBERS_SUPPORTED 1
+#else
+	#define ANDGEN_FIBERS_SUPPORTED 0
+#endif
+
+namespace AndGen
+{
+	/// <summary>
+	/// Execution context with its own stack, which is switched to cooperatively
+	/// </summary>
+	/// <remarks>
+	/// <para>Fibers are switched with a hand-written context switch, which only saves the registers preserved
+	/// across function calls. Stacks are allocated from a recycled pool, with an inaccessible guard page
+	/// below each stack so overflowing it faults rather than corrupting memory.</para>
+	/// <para>A fiber must only be resumed on the thread which created it.</para>
+	/// </remarks>
+	class Fiber
+	{
+	public:
+		/// <summary>
+		/// Function executed by a fiber, which must never return
+		/// </summary>
+		using EntryFunction = void(*)(void* argument);
+
+		/// <summary>
+		/// Size in bytes of each fiber's stack, excluding its guard page
+		/// </summary>
+		static constexpr size_t StackSize = 256 * 1024;
+
+		/// <summary>
+		/// Constructs a fiber representing the calling thread's own stack
+		/// </summary>
+		/// <remarks>
+		/// The calling thread must switch from this fiber to any other, so it can later be switched back to.
+		/// </remarks>
+		Fiber();
+		/// <summary>
+		/// Constructs a new fiber with its own stack, which begins executing once switched to
+		/// </summary>
+		/// <param name="entry">Function to execute</param>
+		/// <param name="argument">Argument to pass to the function</param>
+		/// <exception cref="NotImplementedException">Thrown when fibers aren't supported on this platform</exception>
+		/// <exception cref="std::bad_alloc">Thrown when a stack couldn't be allocated</exception>
+		Fiber(EntryFunction entry, void* argument);
+		Fiber(const Fiber&)				= delete;
+		Fiber& operator=(const Fiber&)	= delete;
+		/// <summary>
+		/// Destroys this fiber, returning its stack to the pool
+		/// </summary>
+		/// <remarks>
+		/// Objects left on the stack of a suspended fiber aren't destroyed.
+		/// </remarks>
+		~Fiber();
+
+		/// <summary>
+		/// Are fibers supported on this platform?
+		/// </summary>
+		static constexpr bool IsSupported()
+		{
+			return ANDGEN_FIBERS_SUPPORTED != 0;
+		}
+
+		/// <summary>
+		/// Suspends this fiber, which must be currently executing, and resumes another
+		/// </summary>
+		/// <remarks>
+		/// Returns once another fiber switches back to this fiber.
+		/// </remarks>
+		/// <param name="fiber">Fiber to resume</param>
+		void SwitchTo(Fiber& fiber);
+
+	private:
+		// Stack pointer saved while this fiber is suspended
+		void* m_stackPointer;
+		// Stack owned by this fiber, including its guard page, or null for a thread's own stack
+		void* m_stack;
+	};
+}
+
+#endif
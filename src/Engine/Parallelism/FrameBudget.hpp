@@ -0,0 +1,59 @@
+#ifndef FRAMEBUDGET_H
+#define FRAMEBUDGET_H
+
+// STL includes
+#include <chrono>
+
+namespace AndGen
+{
+	/// <summary>
+	/// Time a frame may take, and how a thread pool divides it between frame work and deferrable work
+	/// </summary>
+	/// <remarks>
+	/// <para>Frames are started with <see cref="ThreadPool::BeginFrame"/>. Once less than <see cref="deferMargin"/>
+	/// of the frame is left, the pool's threads stop starting <see cref="JobPriority::Background"/> and
+	/// <see cref="JobPriority::Idle"/> jobs, which stay queued until the next frame begins. Jobs already
+	/// executing aren't interrupted, so the margin should cover the longest deferrable job.</para>
+	/// <para>Jobs queued with a deadline are executed earliest deadline first, ahead of other frame work.
+	/// Once within <see cref="promoteWindow"/> of its deadline, a job is also taken ahead of the jobs
+	/// on a thread's own deque.</para>
+	/// </remarks>
+	struct FrameBudget
+	{
+		/// <summary>
+		/// Time a frame may take, or zero to never defer jobs
+		/// </summary>
+		std::chrono::nanoseconds frameTime		= std::chrono::nanoseconds::zero();
+		/// <summary>
+		/// Time left within the frame at which deferrable jobs stop being started
+		/// </summary>
+		std::chrono::nanoseconds deferMargin	= std::chrono::nanoseconds::zero();
+		/// <summary>
+		/// Time before its deadline at which a job is taken ahead of all but critical jobs
+		/// </summary>
+		std::chrono::nanoseconds promoteWindow	= std::chrono::nanoseconds::zero();
+
+		/// <summary>
+		/// Budget which never defers jobs
+		/// </summary>
+		static FrameBudget Unlimited()
+		{
+			return FrameBudget();
+		}
+
+		/// <summary>
+		/// Budget for frames targeting a given frame time, such as 16.6ms for 60 frames per second
+		/// </summary>
+		/// <remarks>
+		/// Deferrable jobs stop being started with an eighth of the frame left, and deadline jobs are promoted
+		/// within a sixteenth of the frame of their deadline.
+		/// </remarks>
+		/// <param name="frameTime">Time a frame may take</param>
+		static FrameBudget Target(std::chrono::nanoseconds frameTime)
+		{
+			return FrameBudget{ frameTime, frameTime / 8, frameTime / 16 };
+		}
+	};
+}
+
+#endif
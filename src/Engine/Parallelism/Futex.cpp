@@ -0,0 +1,153 @@
+#include "Futex.hpp"
+
+#if defined(__linux__)
+// Linux includes
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+// Blocks the calling thread while an atomic holds an expected value, until woken
+void AndGen::Futex::Wait(std::atomic<std::uint32_t>& value, std::uint32_t expected)
+{
+	static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t),
+		"Futexes require atomics to have the same layout as their value");
+
+	syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&value), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+}
+
+// Blocks the calling thread while an atomic holds an expected value, until woken or a timeout passes
+void AndGen::Futex::WaitFor(std::atomic<std::uint32_t>& value, std::uint32_t expected,
+	std::chrono::nanoseconds timeout)
+{
+	if (timeout <= std::chrono::nanoseconds::zero())
+	{
+		return;
+	}
+
+	// Timeouts of waits are relative
+	timespec time;
+	time.tv_sec		= static_cast<time_t>(timeout.count() / 1000000000);
+	time.tv_nsec	= static_cast<long>(timeout.count() % 1000000000);
+
+	syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&value), FUTEX_WAIT_PRIVATE, expected, &time, nullptr, 0);
+}
+
+// Wakes a single thread waiting on an atomic, if any
+void AndGen::Futex::WakeOne(std::atomic<std::uint32_t>& value)
+{
+	syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&value), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+}
+
+// Wakes all threads waiting on an atomic
+void AndGen::Futex::WakeAll(std::atomic<std::uint32_t>& value)
+{
+	syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&value), FUTEX_WAKE_PRIVATE, INT32_MAX, nullptr, nullptr, 0);
+}
+
+#elif defined(_WIN32)
+// STL includes
+#include <algorithm>
+// Windows includes
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+
+// Blocks the calling thread while an atomic holds an expected value, until woken
+void AndGen::Futex::Wait(std::atomic<std::uint32_t>& value, std::uint32_t expected)
+{
+	WaitOnAddress(&value, &expected, sizeof(expected), INFINITE);
+}
+
+// Blocks the calling thread while an atomic holds an expected value, until woken or a timeout passes
+void AndGen::Futex::WaitFor(std::atomic<std::uint32_t>& value, std::uint32_t expected,
+	std::chrono::nanoseconds timeout)
+{
+	if (timeout <= std::chrono::nanoseconds::zero())
+	{
+		return;
+	}
+
+	// Timeouts are in whole milliseconds, rounded up so threads don't wake before the timeout passes
+	long long milliseconds = std::chrono::ceil<std::chrono::milliseconds>(timeout).count();
+	WaitOnAddress(&value, &expected, sizeof(expected),
+		static_cast<DWORD>(std::min<long long>(milliseconds, INFINITE - 1)));
+}
+
+// Wakes a single thread waiting on an atomic, if any
+void AndGen::Futex::WakeOne(std::atomic<std::uint32_t>& value)
+{
+	WakeByAddressSingle(&value);
+}
+
+// Wakes all threads waiting on an atomic
+void AndGen::Futex::WakeAll(std::atomic<std::uint32_t>& value)
+{
+	WakeByAddressAll(&value);
+}
+
+#else
+// STL includes
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+// Threads waiting on any of the atomics whose addresses share a bucket
+struct WaitBucket
+{
+	// Guards checking the value before blocking, so a wake can't be missed between the two
+	std::mutex mutex;
+	// Blocks threads waiting within the bucket
+	std::condition_variable condition;
+};
+
+// Returns the bucket of threads waiting on an atomic
+static WaitBucket& GetWaitBucket(const void* address)
+{
+	static std::array<WaitBucket, 64> buckets;
+	return buckets[(reinterpret_cast<std::uintptr_t>(address) / 64) % buckets.size()];
+}
+
+// Blocks the calling thread while an atomic holds an expected value, until woken
+void AndGen::Futex::Wait(std::atomic<std::uint32_t>& value, std::uint32_t expected)
+{
+	WaitBucket& bucket = GetWaitBucket(&value);
+	std::unique_lock<std::mutex> lock(bucket.mutex);
+	if (value.load(std::memory_order_acquire) == expected)
+	{
+		bucket.condition.wait(lock);
+	}
+}
+
+// Blocks the calling thread while an atomic holds an expected value, until woken or a timeout passes
+void AndGen::Futex::WaitFor(std::atomic<std::uint32_t>& value, std::uint32_t expected,
+	std::chrono::nanoseconds timeout)
+{
+	WaitBucket& bucket = GetWaitBucket(&value);
+	std::unique_lock<std::mutex> lock(bucket.mutex);
+	if (value.load(std::memory_order_acquire) == expected)
+	{
+		bucket.condition.wait_for(lock, timeout);
+	}
+}
+
+// Wakes a single thread waiting on an atomic, if any
+void AndGen::Futex::WakeOne(std::atomic<std::uint32_t>& value)
+{
+	// Buckets are shared between atomics, so a single wake could reach a thread waiting on another atomic
+	WakeAll(value);
+}
+
+// Wakes all threads waiting on an atomic
+void AndGen::Futex::WakeAll(std::atomic<std::uint32_t>& value)
+{
+	// Lock once, so a thread which checked the value before it changed has blocked before being notified
+	WaitBucket& bucket = GetWaitBucket(&value);
+	{
+		std::lock_guard<std::mutex> lock(bucket.mutex);
+	}
+	bucket.condition.notify_all();
+}
+
+#endif
@@ -0,0 +1,56 @@
+#ifndef FUTEX_H
+#define FUTEX_H
+
+// STL includes
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace AndGen
+{
+	/// <summary>
+	/// Blocks and wakes threads waiting on the value of a 32-bit atomic
+	/// </summary>
+	/// <remarks>
+	/// Uses the futex system call on Linux, which only enters the kernel when a thread must actually block or
+	/// a thread is actually waiting, and <c>WaitOnAddress</c> on Windows. Other platforms block on condition
+	/// variables shared by atomics whose addresses hash together. Every platform blocks for the whole of a
+	/// timed wait, rather than spinning. Threads may wake spuriously, so waiting threads must check the value
+	/// again once woken.
+	/// </remarks>
+	class Futex
+	{
+	public:
+		Futex() = delete;
+
+		/// <summary>
+		/// Blocks the calling thread while an atomic holds an expected value, until woken
+		/// </summary>
+		/// <param name="value">Atomic to wait on</param>
+		/// <param name="expected">Value to block while held</param>
+		static void Wait(std::atomic<std::uint32_t>& value, std::uint32_t expected);
+
+		/// <summary>
+		/// Blocks the calling thread while an atomic holds an expected value, until woken or a timeout passes
+		/// </summary>
+		/// <param name="value">Atomic to wait on</param>
+		/// <param name="expected">Value to block while held</param>
+		/// <param name="timeout">Longest time to block for</param>
+		static void WaitFor(std::atomic<std::uint32_t>& value, std::uint32_t expected,
+			std::chrono::nanoseconds timeout);
+
+		/// <summary>
+		/// Wakes a single thread waiting on an atomic, if any
+		/// </summary>
+		/// <param name="value">Atomic waited on</param>
+		static void WakeOne(std::atomic<std::uint32_t>& value);
+
+		/// <summary>
+		/// Wakes all threads waiting on an atomic
+		/// </summary>
+		/// <param name="value">Atomic waited on</param>
+		static void WakeAll(std::atomic<std::uint32_t>& value);
+	};
+}
+
+#endif
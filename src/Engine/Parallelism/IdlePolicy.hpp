@@ -0,0 +1,51 @@
+#ifndef IDLEPOLICY_H
+#define IDLEPOLICY_H
+
+namespace AndGen
+{
+	/// <summary>
+	/// Controls how long a pooled thread without jobs keeps looking for jobs before sleeping
+	/// </summary>
+	/// <remarks>
+	/// <para>A thread which runs out of jobs first spins, checking for jobs between bursts of pause instructions
+	/// which double in length up to <see cref="MaxPausesPerSpin"/>. It then yields its time slice a number of
+	/// times, and finally sleeps until woken by a thread queueing jobs.</para>
+	/// <para>The amount of spins is adapted per thread within the budget: it halves each time spinning ends in
+	/// sleep, and doubles each time spinning finds a job. Spinning reacts to new jobs within a few hundred
+	/// nanoseconds, but keeps a core busy; sleeping saves power, but waking takes several microseconds.</para>
+	/// </remarks>
+	struct IdlePolicy
+	{
+		/// <summary>
+		/// Most pause instructions executed between checks for jobs while spinning
+		/// </summary>
+		static constexpr unsigned int MaxPausesPerSpin = 64;
+
+		/// <summary>
+		/// Most times a thread checks for jobs while spinning, before yielding
+		/// </summary>
+		unsigned int spinCount	= 64;
+		/// <summary>
+		/// Times a thread yields and checks for jobs, before sleeping
+		/// </summary>
+		unsigned int yieldCount	= 4;
+
+		/// <summary>
+		/// Policy favouring reacting quickly to new jobs, at the cost of keeping cores busy
+		/// </summary>
+		static constexpr IdlePolicy LowLatency()
+		{
+			return IdlePolicy{ 1024, 16 };
+		}
+
+		/// <summary>
+		/// Policy favouring idle cores sleeping, at the cost of waking slowly for new jobs
+		/// </summary>
+		static constexpr IdlePolicy LowPower()
+		{
+			return IdlePolicy{ 0, 0 };
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,45 @@
+#include "Latch.hpp"
+
+// AndGen includes
+#include "Futex.hpp"
+#include "SpinWait.hpp"
+
+// Counts the latch down, releasing waiting threads once it reaches zero
+void AndGen::Latch::CountDown(std::uint32_t count)
+{
+	if (count == 0 || m_count.fetch_sub(count, std::memory_order_seq_cst) != count)
+	{
+		return;
+	}
+
+	if (m_waitingCount.load(std::memory_order_seq_cst) > 0)
+	{
+		Futex::WakeAll(m_count);
+	}
+}
+
+// Blocks the calling thread until the latch has been counted down to zero
+void AndGen::Latch::Wait() const
+{
+	// Spin briefly, as the last threads are often about to count down
+	SpinBackoff backoff;
+	while (!backoff.ShouldBlock())
+	{
+		if (TryWait())
+		{
+			return;
+		}
+
+		backoff.Pause();
+	}
+
+	// Count this thread as waiting before checking the count again, pairing with CountDown()
+	m_waitingCount.fetch_add(1, std::memory_order_seq_cst);
+	std::uint32_t count = m_count.load(std::memory_order_seq_cst);
+	while (count != 0)
+	{
+		Futex::Wait(m_count, count);
+		count = m_count.load(std::memory_order_acquire);
+	}
+	m_waitingCount.fetch_sub(1, std::memory_order_relaxed);
+}
@@ -0,0 +1,65 @@
+#ifndef LATCH_H
+#define LATCH_H
+
+// STL includes
+#include <atomic>
+#include <cstdint>
+
+namespace AndGen
+{
+	/// <summary>
+	/// Single-use counter, which blocks waiting threads until counted down to zero
+	/// </summary>
+	/// <remarks>
+	/// Waiting spins briefly before blocking on a futex, and counting down to zero only makes a system call
+	/// when threads are blocked. The count is kept on its own cache line.
+	/// </remarks>
+	class alignas(64) Latch
+	{
+	public:
+		/// <summary>
+		/// Constructs a new latch
+		/// </summary>
+		/// <param name="count">Count the latch must be counted down by before waiting threads are released</param>
+		explicit Latch(std::uint32_t count) : m_count(count), m_waitingCount(0) {}
+		Latch(const Latch&)				= delete;
+		Latch& operator=(const Latch&)	= delete;
+		~Latch()						= default;
+
+		/// <summary>
+		/// Has the latch been counted down to zero?
+		/// </summary>
+		inline bool TryWait() const
+		{
+			return m_count.load(std::memory_order_acquire) == 0;
+		}
+
+		/// <summary>
+		/// Counts the latch down, releasing waiting threads once it reaches zero
+		/// </summary>
+		/// <param name="count">Amount to count down by, which must not exceed the remaining count</param>
+		void CountDown(std::uint32_t count = 1);
+
+		/// <summary>
+		/// Blocks the calling thread until the latch has been counted down to zero
+		/// </summary>
+		void Wait() const;
+
+		/// <summary>
+		/// Counts the latch down by one, then waits for it to reach zero
+		/// </summary>
+		inline void ArriveAndWait()
+		{
+			CountDown();
+			Wait();
+		}
+
+	private:
+		// Remaining count before waiting threads are released
+		mutable std::atomic<std::uint32_t> m_count;
+		// Amount of threads blocked, or about to block, waiting on the latch
+		mutable std::atomic<std::uint32_t> m_waitingCount;
+	};
+}
+
+#endif
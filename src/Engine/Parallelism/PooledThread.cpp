@@ -1,9 +1,60 @@
 #include "PooledThread.hpp"
-#include "PooledThread.hpp"
 
+// STL includes
+#include <algorithm>
 // AndGen includes
 #include <AndGen/Engine/Jobs/Job.hpp>
 #include <AndGen/Exceptions/NotImplementedException.hpp>
+#include "../Jobs/JobProfiler.hpp"
+#include "CpuTopology.hpp"
+#include "SpinWait.hpp"
+#include "ThreadPool.hpp"
+
+// Pooled thread executing on the current thread, if any
+thread_local AndGen::PooledThread* AndGen::PooledThread::s_currentThread = nullptr;
+
+// Constructs a new pooled thread owned by a thread pool
+AndGen::PooledThread::PooledThread(AndGen::ThreadPool* threadPool, unsigned int index,
+	const AndGen::IdlePolicy& idlePolicy) :
+	m_threadPool(threadPool), m_index(index), m_cpu(-1), m_blockingDepth(0), m_shouldExit(false), m_isRunning(false),
+	m_isExecuting(false), m_isSleeping(false), m_idlePolicy(idlePolicy), m_spinLimit(idlePolicy.spinCount), m_activity(Activity::Stopped),
+	m_activityStart(0), m_currentFiber(nullptr)
+{
+	// Seed random number generator uniquely per thread, xorshift state must be non-zero
+	m_randomState = (index + 1) * 0x9E3779B9u;
+	if (m_randomState == 0)
+	{
+		m_randomState = 1;
+	}
+}
+
+// The pooled thread executing the calling thread, if any
+AndGen::PooledThread* AndGen::PooledThread::GetCurrent()
+{
+	return s_currentThread;
+}
+
+// Snapshot of this thread's counters, read without locking while the thread keeps counting
+AndGen::ThreadStats AndGen::PooledThread::GetStats() const
+{
+	ThreadStats stats;
+	stats.jobsExecuted	= m_counters.jobsExecuted.load(std::memory_order_relaxed);
+	stats.jobsQueued	= m_counters.jobsQueued.load(std::memory_order_relaxed);
+	stats.stealAttempts	= m_counters.stealAttempts.load(std::memory_order_relaxed);
+	stats.steals		= m_counters.steals.load(std::memory_order_relaxed);
+	stats.executingTime	= std::chrono::nanoseconds(
+		m_counters.activityTimes[static_cast<size_t>(Activity::Executing)].load(std::memory_order_relaxed));
+	stats.spinningTime	= std::chrono::nanoseconds(
+		m_counters.activityTimes[static_cast<size_t>(Activity::Spinning)].load(std::memory_order_relaxed));
+	stats.parkedTime	= std::chrono::nanoseconds(
+		m_counters.activityTimes[static_cast<size_t>(Activity::Parked)].load(std::memory_order_relaxed));
+	for (size_t i = 0; i < ThreadStats::QueueDepthBucketCount; i++)
+	{
+		stats.queueDepthHistogram[i] = m_counters.queueDepthHistogram[i].load(std::memory_order_relaxed);
+	}
+
+	return stats;
+}
 
 // Begins thread execution
 void AndGen::PooledThread::Start()
@@ -14,6 +65,12 @@ void AndGen::PooledThread::Start()
 		return;
 	}
 
+	// Release the previous execution thread, which has already exited its execution loop
+	if (m_thread.joinable())
+	{
+		m_thread.join();
+	}
+
 	m_shouldExit = false;
 	// Thread running flag set here, in case threads check immediately if this thread is running
 	// before first line of the internal thread gets to run
@@ -26,15 +83,20 @@ void AndGen::PooledThread::Start()
 // Stops thread execution
 void AndGen::PooledThread::Stop(bool waitForThread)
 {
-	// Ignore call if thread isn't running
+	// Ignore call if thread isn't running, other than releasing a thread which stopped itself
 	if (!m_isRunning)
 	{
+		if (waitForThread && m_thread.joinable())
+		{
+			m_thread.join();
+		}
+
 		return;
 	}
 
 	m_shouldExit = true;
 	// Wake thread, if waiting for jobs to be added
-	m_jobsReadyNotification.Notify();
+	WakeUp();
 
 	// Wait for thread to finish executing
 	if (waitForThread && m_thread.joinable())
@@ -46,40 +108,557 @@ void AndGen::PooledThread::Stop(bool waitForThread)
 // Waits for current queue to be executed by the thread
 void AndGen::PooledThread::WaitForQueue()
 {
-	// Ignore call if queue is empty
-	// or thread isn't running
-	if (m_jobQueue.Count() <= 0 ||
-		!m_isRunning)
+	// Wait until the queue is empty and the thread has finished executing, or the thread has stopped,
+	// as the thread notifies each time it runs out of jobs
+	for (;;)
+	{
+		bool isQueueEmpty = m_jobQueue.Count() == 0;
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if ((isQueueEmpty && !m_isExecuting) || !m_isRunning)
+		{
+			return;
+		}
+
+		m_jobsCompleteNotification.Wait();
+	}
+}
+
+// Removes all jobs from the execution queue
+size_t AndGen::PooledThread::ClearQueue()
+{
+	size_t discardedCount = m_jobQueue.Clear();
+
+	// Discard jobs within the local deque, stealing is used
+	// since this may be called from any thread
+	JobRecord* record = nullptr;
+	while (!m_localJobs.IsEmpty())
+	{
+		if (m_localJobs.Steal(record))
+		{
+			JobRecord::Discard(record);
+			discardedCount++;
+		}
+	}
+
+	// Release the counts the jobs were queued with, as they'll never be executed
+	if (discardedCount > 0 && m_threadPool != nullptr)
+	{
+		m_threadPool->DiscardedJobs(discardedCount);
+	}
+
+	return discardedCount;
+}
+
+// Wakes the thread if it's sleeping, allowing it to steal jobs from other threads
+bool AndGen::PooledThread::WakeUp()
+{
+	// Order jobs added before this with checking if the thread is sleeping, pairing with Sleep()
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (!m_isSleeping.load(std::memory_order_relaxed) || !ClaimWakeUp())
+	{
+		return false;
+	}
+
+	m_parker.Unpark();
+	return true;
+}
+
+// Adds a job record to the queue to be executed by the thread
+void AndGen::PooledThread::QueueJob(AndGen::JobRecord* record, AndGen::JobPriority priority)
+{
+	// Ignore if job is null
+	if (record == nullptr)
+	{
+		return;
+	}
+
+	// Add job to queue
+	m_jobQueue.AddJob(record, priority);
+
+	// Wake internal thread if it's sleeping
+	WakeUp();
+}
+
+// Adds a batch of job records to the queue to be executed by the thread
+void AndGen::PooledThread::QueueJobs(AndGen::JobRecord* const* records, size_t count, AndGen::JobPriority priority)
+{
+	// Ignore empty batches
+	if (records == nullptr || count == 0)
+	{
+		return;
+	}
+
+	// Add jobs to queue
+	m_jobQueue.AddJobs(records, count, priority);
+
+	// Wake internal thread if it's sleeping
+	WakeUp();
+}
+
+// Pushes a job record onto this thread's work-stealing deque
+void AndGen::PooledThread::PushLocalJob(AndGen::JobRecord* record)
+{
+	// Ignore if job is null
+	if (record == nullptr)
+	{
+		return;
+	}
+
+	// Only the thread owning the deque may push onto it
+	if (GetCurrent() != this)
 	{
+		QueueJob(record);
 		return;
 	}
 
-	m_jobsCompleteNotification.Wait();
+	m_localJobs.Push(record);
+}
+
+// Steals a job from this thread, to be executed by another thread
+bool AndGen::PooledThread::StealJob(AndGen::JobRecord*& record, AndGen::JobPriority lowestPriority)
+{
+	// Critical jobs first
+	record = m_jobQueue.GetNextJob(JobPriority::Critical);
+	if (record != nullptr)
+	{
+		return true;
+	}
+
+	// Then the oldest job pushed by this thread
+	if (m_localJobs.Steal(record))
+	{
+		return true;
+	}
+
+	// Otherwise take the next job added by other threads
+	record = m_jobQueue.GetNextJob(lowestPriority);
+	return record != nullptr;
 }
 
 // Executes all jobs in the queue
 // and waits for a job to be added when none are left
 void AndGen::PooledThread::ExecutionLoop()
 {
-	while (!m_shouldExit)
+	s_currentThread = this;
+#if defined(ANDGEN_JOB_PROFILER)
+	JobProfiler::SetThreadName("Pooled thread " + std::to_string(m_index));
+#endif
+
+	// Stay on the CPU selected by the thread pool, keeping this thread's cache warm
+	if (m_cpu >= 0)
+	{
+		CpuTopology::PinCurrentThread(static_cast<unsigned int>(m_cpu));
+	}
+
+	// Jobs are executed on fibers while the thread pool is in fiber mode
+	bool useFibers = m_threadPool != nullptr &&
+		m_threadPool->GetExecutionMode() == ThreadPool::ExecutionMode::Fibers;
+	if (useFibers)
+	{
+		m_threadFiber = std::make_unique<Fiber>();
+	}
+	SetActivity(Activity::Spinning);
+
+	// Suspended fibers are finished before exiting, as their jobs have already begun
+	JobRecord* record		= nullptr;
+	unsigned int idleRound	= 0;
+	while (!m_shouldExit || !m_waitingFibers.empty())
 	{
-		// Execute the next job in the queue if there's any left
-		if (m_jobQueue.Count() > 0)
+		// Resume suspended jobs before beginning new jobs
+		if (useFibers && ResumeReadyFiber())
 		{
-			m_isExecuting = true;
-			m_jobQueue.ExecuteNextJob();
+			SetActivity(Activity::Executing);
+			m_isExecuting	= true;
+			idleRound		= 0;
+			continue;
 		}
 
-		if (m_jobQueue.Count() <= 0)
+		// Execute the next job, from either this thread or another thread in the pool
+		if (FindJob(record))
 		{
-			// Notify external waiting threads that the queue is completed
-			m_jobsCompleteNotification.Notify();
+			// Spinning found a job, so allow spinning for longer before sleeping next time
+			if (idleRound > 0)
+			{
+				m_spinLimit = std::min(std::max(m_spinLimit * 2, 1u), m_idlePolicy.spinCount);
+			}
+			idleRound = 0;
+
+			ExecuteJob(record, useFibers);
+			TryRetire(false);
+			continue;
+		}
 
-			// Wait for jobs to be added to the queue
+		// Suspended fibers may be resumed at any time, so don't wait for new jobs
+		if (!m_waitingFibers.empty())
+		{
+			std::this_thread::yield();
+			continue;
+		}
+
+		// Notify external waiting threads that the queue is completed
+		if (m_isExecuting)
+		{
 			m_isExecuting = false;
-			m_jobsReadyNotification.Wait();
+			m_jobsCompleteNotification.Notify();
+			ANDGEN_PROFILER_RECORD(Idle, nullptr, 0);
+		}
+
+		// Wait for jobs to be added to the queue
+		SetActivity(Activity::Spinning);
+		if (WaitForJob(record, idleRound))
+		{
+			ExecuteJob(record, useFibers);
+			TryRetire(false);
 		}
 	}
 
-	m_isRunning = false;
+	m_freeFibers.clear();
+	m_fibers.clear();
+	m_threadFiber.reset();
+	SetActivity(Activity::Stopped);
+
+	s_currentThread = nullptr;
+	m_isExecuting	= false;
+	m_isRunning		= false;
+
+	// Release external waiting threads, as the queue won't be executed any further
+	m_jobsCompleteNotification.Notify();
+}
+
+// Finds the next job to execute, either from this thread's queues or another thread's
+bool AndGen::PooledThread::FindJob(AndGen::JobRecord*& record)
+{
+	// Count as executing before taking from the queue, so WaitForQueue() never sees an empty queue
+	// while this thread is idle but about to execute its last job
+	if (m_jobQueue.Count() > 0)
+	{
+		m_isExecuting.store(true, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+	}
+
+	// Critical jobs first
+	record = m_jobQueue.GetNextJob(JobPriority::Critical);
+	if (record != nullptr)
+	{
+		return true;
+	}
+
+	// Then jobs close to their deadline
+	if (m_threadPool != nullptr && m_threadPool->TakeDeadlineJob(record, true))
+	{
+		return true;
+	}
+
+	// Then lower priority jobs which have been passed over too many times for local jobs,
+	// leaving deferrable jobs queued once the frame's budget is nearly used
+	JobPriority lowestPriority = m_threadPool != nullptr ? m_threadPool->LowestStartablePriority() : JobPriority::Idle;
+	record = m_jobQueue.GetAgedJob(lowestPriority);
+	if (record != nullptr)
+	{
+		return true;
+	}
+
+	// Then the most recently pushed local job, as its data is most likely to still be in cache,
+	// passing over the lower priority jobs queued
+	if (m_localJobs.Pop(record))
+	{
+		m_jobQueue.PassOver(JobPriority::Frame, lowestPriority);
+		return true;
+	}
+
+	// Then any other jobs with deadlines, earliest first
+	if (m_threadPool != nullptr && m_threadPool->TakeDeadlineJob(record, false))
+	{
+		return true;
+	}
+
+	// Remaining jobs added by other threads, by priority and then in the order they were added
+	record = m_jobQueue.GetNextJob(lowestPriority);
+	if (record != nullptr)
+	{
+		return true;
+	}
+
+	return StealJobFromPool(record, lowestPriority);
+}
+
+// Executes a job, on a fiber if enabled
+void AndGen::PooledThread::ExecuteJob(AndGen::JobRecord* record, bool useFibers)
+{
+	SetActivity(Activity::Executing);
+	CountJobExecuted();
+	m_isExecuting = true;
+	if (useFibers)
+	{
+		ExecuteOnFiber(record);
+		return;
+	}
+
+	JobRecord::Execute(record);
+	if (m_threadPool != nullptr)
+	{
+		m_threadPool->m_queuedJobsCounter.Decrement();
+	}
+}
+
+// Waits for a job while idle, spinning, then yielding, then sleeping until woken
+bool AndGen::PooledThread::WaitForJob(AndGen::JobRecord*& record, unsigned int& idleRound)
+{
+	// Spin, with pauses doubling in length between each check for jobs
+	if (idleRound < m_spinLimit)
+	{
+		unsigned int pauseCount = std::min(1u << std::min(idleRound, 31u), IdlePolicy::MaxPausesPerSpin);
+		for (unsigned int i = 0; i < pauseCount; i++)
+		{
+			CpuPause();
+		}
+
+		idleRound++;
+		return false;
+	}
+
+	// Then allow other threads to run on this core
+	if (idleRound < m_spinLimit + m_idlePolicy.yieldCount)
+	{
+		std::this_thread::yield();
+
+		idleRound++;
+		return false;
+	}
+
+	// Then sleep, spinning for less time next time as spinning didn't find a job
+	m_spinLimit	= std::min(std::max(m_spinLimit / 2, 1u), m_idlePolicy.spinCount);
+	idleRound	= 0;
+
+	return Sleep(record);
+}
+
+// Sleeps until woken, unless a job is found after announcing this thread is sleeping
+bool AndGen::PooledThread::Sleep(AndGen::JobRecord*& record)
+{
+	// Announce this thread is sleeping before checking for jobs a final time, so any thread adding a job
+	// either sees this thread sleeping and wakes it, or added its job before this check, pairing with WakeUp()
+	m_isSleeping.store(true, std::memory_order_relaxed);
+	if (m_threadPool != nullptr)
+	{
+		m_threadPool->m_sleepingCount.fetch_add(1, std::memory_order_relaxed);
+	}
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	bool foundJob = !m_shouldExit && FindJob(record);
+	if (!foundJob)
+	{
+		// Notify external waiting threads, in case the queue was emptied by other threads stealing from it
+		m_isExecuting = false;
+		m_jobsCompleteNotification.Notify();
+
+		// Threads which may retire only sleep until their pool's retire timeout, retiring if nothing woke them
+		SetActivity(Activity::Parked);
+		if (!m_shouldExit && m_threadPool != nullptr && m_threadPool->CanRetire(m_index))
+		{
+			if (!m_parker.ParkFor(m_threadPool->GetElasticPolicy().retireTimeout) && ClaimWakeUp())
+			{
+				TryRetire(true);
+				return false;
+			}
+		}
+		else if (!m_shouldExit)
+		{
+			m_parker.Park();
+		}
+	}
+
+	// Thread may have woken itself by finding a job, otherwise the waking thread has already claimed it
+	ClaimWakeUp();
+	SetActivity(Activity::Spinning);
+	return foundJob;
+}
+
+// Marks this thread as awake, returning true if it was sleeping
+bool AndGen::PooledThread::ClaimWakeUp()
+{
+	if (!m_isSleeping.exchange(false, std::memory_order_acq_rel))
+	{
+		return false;
+	}
+
+	if (m_threadPool != nullptr)
+	{
+		m_threadPool->m_sleepingCount.fetch_sub(1, std::memory_order_relaxed);
+	}
+
+	return true;
+}
+
+// Retires this thread if its elastic thread pool allows it and it has no jobs of its own left
+bool AndGen::PooledThread::TryRetire(bool isIdle)
+{
+	if (m_threadPool == nullptr || !m_threadPool->CanRetire(m_index) || PendingJobsCount() > 0 ||
+		!m_waitingFibers.empty() || !m_threadPool->RetireThread(isIdle))
+	{
+		return false;
+	}
+
+	// Exit the execution loop, the thread pool may start this thread again later
+	m_shouldExit = true;
+	return true;
+}
+
+// Attempts to steal a job from other threads in the pool, closest first, starting with a random thread
+bool AndGen::PooledThread::StealJobFromPool(AndGen::JobRecord*& record, AndGen::JobPriority lowestPriority)
+{
+	// Nothing to steal from if this thread isn't pooled with any others
+	if (m_victims.empty())
+	{
+		return false;
+	}
+	Counters::Add(m_counters.stealAttempts);
+
+	// Select a random victim to start from within each group (xorshift32),
+	// so thieves don't all contend on the same thread
+	m_randomState ^= m_randomState << 13;
+	m_randomState ^= m_randomState >> 17;
+	m_randomState ^= m_randomState << 5;
+
+	size_t groupBegin = 0;
+	for (size_t i = 0; i < m_victimGroupEnds.size(); i++)
+	{
+		size_t groupSize	= m_victimGroupEnds[i] - groupBegin;
+		size_t firstVictim	= m_randomState % groupSize;
+		for (size_t j = 0; j < groupSize; j++)
+		{
+			unsigned int victimIndex	= m_victims[groupBegin + (firstVictim + j) % groupSize];
+			PooledThread& victim		= m_threadPool->GetThread(victimIndex);
+			if (victim.StealJob(record, lowestPriority))
+			{
+				ANDGEN_PROFILER_RECORD(Steal, record, victimIndex);
+				Counters::Add(m_counters.steals);
+				return true;
+			}
+		}
+		groupBegin = m_victimGroupEnds[i];
+	}
+
+	return false;
+}
+
+// Counts a job beginning, and the amount of jobs left waiting on this thread
+void AndGen::PooledThread::CountJobExecuted()
+{
+	Counters::Add(m_counters.jobsExecuted);
+	Counters::Add(m_counters.queueDepthHistogram[ThreadStats::QueueDepthBucket(PendingJobsCount())]);
+}
+
+// Changes what the thread is doing, adding the time spent on its last activity to its counters
+void AndGen::PooledThread::SetActivity(AndGen::PooledThread::Activity activity)
+{
+	if (activity == m_activity)
+	{
+		return;
+	}
+
+	std::int64_t now = ThreadPool::Now();
+	if (m_activity != Activity::Stopped)
+	{
+		Counters::Add(m_counters.activityTimes[static_cast<size_t>(m_activity)],
+			static_cast<std::uint64_t>(now - m_activityStart));
+	}
+
+	// Count threads executing jobs within the pool, so it needn't check each thread
+	if (m_threadPool != nullptr && (activity == Activity::Executing || m_activity == Activity::Executing))
+	{
+		if (activity == Activity::Executing)
+		{
+			m_threadPool->m_executingCount.fetch_add(1, std::memory_order_relaxed);
+		}
+		else
+		{
+			m_threadPool->m_executingCount.fetch_sub(1, std::memory_order_relaxed);
+		}
+	}
+
+	m_activity		= activity;
+	m_activityStart	= now;
+}
+
+// Executes a job on a free fiber, creating a new fiber if none are free
+void AndGen::PooledThread::ExecuteOnFiber(AndGen::JobRecord* record)
+{
+	JobFiber* jobFiber = nullptr;
+	if (!m_freeFibers.empty())
+	{
+		jobFiber = m_freeFibers.back();
+		m_freeFibers.pop_back();
+	}
+	else
+	{
+		m_fibers.push_back(std::make_unique<JobFiber>(this));
+		jobFiber = m_fibers.back().get();
+	}
+
+	jobFiber->record = record;
+	SwitchToFiber(jobFiber);
+}
+
+// Switches to a fiber until it completes its job or is suspended
+void AndGen::PooledThread::SwitchToFiber(AndGen::PooledThread::JobFiber* jobFiber)
+{
+	m_currentFiber = jobFiber;
+	m_threadFiber->SwitchTo(jobFiber->fiber);
+	m_currentFiber = nullptr;
+
+	// Fiber either suspended itself on a counter, or completed its job
+	if (jobFiber->waitingOn != nullptr)
+	{
+		m_waitingFibers.push_back(jobFiber);
+	}
+	else
+	{
+		m_freeFibers.push_back(jobFiber);
+	}
+}
+
+// Resumes a suspended fiber whose counter has completed, if any
+bool AndGen::PooledThread::ResumeReadyFiber()
+{
+	for (size_t i = 0; i < m_waitingFibers.size(); i++)
+	{
+		JobFiber* jobFiber = m_waitingFibers[i];
+		if (jobFiber->waitingOn->IsComplete())
+		{
+			m_waitingFibers[i] = m_waitingFibers.back();
+			m_waitingFibers.pop_back();
+
+			jobFiber->waitingOn = nullptr;
+			SwitchToFiber(jobFiber);
+
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// Suspends the current fiber until a counter completes, executing other jobs meanwhile
+void AndGen::PooledThread::SuspendFiber(const AndGen::JobCounter& counter)
+{
+	JobFiber* jobFiber	= m_currentFiber;
+	jobFiber->waitingOn	= &counter;
+
+	// Switch back to this thread's own stack, which resumes this fiber once the counter completes
+	jobFiber->fiber.SwitchTo(*m_threadFiber);
+}
+
+// Executes jobs given to a fiber, switching back to the thread after each job
+void AndGen::PooledThread::FiberEntry(void* argument)
+{
+	JobFiber* jobFiber = static_cast<JobFiber*>(argument);
+	for (;;)
+	{
+		JobRecord::Execute(jobFiber->record);
+		jobFiber->record = nullptr;
+		jobFiber->thread->m_threadPool->m_queuedJobsCounter.Decrement();
+
+		jobFiber->fiber.SwitchTo(*jobFiber->thread->m_threadFiber);
+	}
 }
@@ -2,19 +2,30 @@
 #define POOLEDTHREAD_H
 
 // STL includes
+#include <array>
 #include <atomic>
+#include <cstdint>
 #include <memory>
 #include <mutex>
 #include <thread>
+#include <vector>
 // AndGen includes
-#include "..\Jobs\JobQueue.hpp"
+#include "../Jobs/JobQueue.hpp"
+#include "../Jobs/JobRecord.hpp"
+#include "../Jobs/LockFreeJobQueue.hpp"
+#include "Fiber.hpp"
+#include "IdlePolicy.hpp"
 #include "ThreadNotifier.hpp"
+#include "ThreadParker.hpp"
+#include "ThreadPoolStats.hpp"
+#include "WorkStealingDeque.hpp"
 #include <AndGen/Exceptions/NotImplementedException.hpp>
 
 namespace AndGen
 {
 	// Pre-declarations
 	class Job;
+	class ThreadPool;
 
 	/// <summary>
 	/// Thread within a <see cref="ThreadPool"/>
@@ -22,6 +33,19 @@ namespace AndGen
 	class PooledThread
 	{
 	public:
+		/// <summary>
+		/// Type of queue holding jobs added to the thread by other threads
+		/// </summary>
+		/// <remarks>
+		/// Building with the <c>ANDGEN_LOCK_FREE_JOB_QUEUE</c> option selects <see cref="LockFreeJobQueue"/>,
+		/// which avoids contention when many threads queue jobs at once. Otherwise <see cref="JobQueue"/> is used.
+		/// </remarks>
+#if defined(ANDGEN_LOCK_FREE_JOB_QUEUE)
+		using QueueType = LockFreeJobQueue;
+#else
+		using QueueType = JobQueue;
+#endif
+
 		/// <summary>
 		/// Constructs a new pooled thread
 		/// </summary>
@@ -30,7 +54,18 @@ namespace AndGen
 		/// and <see cref="Start"/> will need to be called afterwards
 		/// in order for the thread to be executing.
 		/// </remarks>
-		PooledThread() : m_shouldExit(false), m_isRunning(false), m_isExecuting(false) {}
+		PooledThread() : PooledThread(nullptr, 0) {}
+		/// <summary>
+		/// Constructs a new pooled thread owned by a <see cref="ThreadPool"/>
+		/// </summary>
+		/// <remarks>
+		/// Pooled threads owned by a thread pool will steal jobs from other threads within the same pool
+		/// when they have no jobs of their own left to execute.
+		/// </remarks>
+		/// <param name="threadPool">Thread pool owning this thread</param>
+		/// <param name="index">Index of this thread within the thread pool</param>
+		/// <param name="idlePolicy">How long this thread looks for jobs before sleeping</param>
+		PooledThread(ThreadPool* threadPool, unsigned int index, const IdlePolicy& idlePolicy = IdlePolicy());
 		PooledThread(const PooledThread&) = delete;
 		/// <summary>
 		/// Destroys this pooled thread
@@ -44,6 +79,8 @@ namespace AndGen
 			// Wait for internal thread to complete
 			// any currently executing tasks
 			Stop(true);
+			// Release any jobs left within the local deque, which a thread pool has already cleared
+			ClearQueue();
 		}
 
 		/// <summary>
@@ -69,11 +106,50 @@ namespace AndGen
 		/// The currently executing job queue
 		/// </summary>
 		/// <returns>Reference to thread's job queue</returns>
-		inline const JobQueue& GetQueue() const
+		inline const QueueType& GetQueue() const
 		{
 			return m_jobQueue;
 		}
 
+		/// <summary>
+		/// Amount of jobs waiting to be executed by this thread, or stolen from it
+		/// </summary>
+		inline size_t PendingJobsCount() const
+		{
+			return m_jobQueue.Count() + m_localJobs.Count();
+		}
+
+		/// <summary>
+		/// The thread pool owning this thread, if any
+		/// </summary>
+		inline ThreadPool* GetThreadPool() const
+		{
+			return m_threadPool;
+		}
+
+		/// <summary>
+		/// Index of this thread within its owning thread pool
+		/// </summary>
+		inline unsigned int GetIndex() const
+		{
+			return m_index;
+		}
+
+		/// <summary>
+		/// Logical CPU this thread is pinned to
+		/// </summary>
+		/// <returns>Identifier of the CPU, or -1 if the thread isn't pinned</returns>
+		inline int GetCpu() const
+		{
+			return m_cpu;
+		}
+
+		/// <summary>
+		/// The pooled thread executing the calling thread, if any
+		/// </summary>
+		/// <returns>Pointer to current pooled thread, or null if called from any other thread</returns>
+		static PooledThread* GetCurrent();
+
 		/// <summary>
 		/// Is this pooled thread currently executing?
 		/// </summary>
@@ -97,6 +173,27 @@ namespace AndGen
 			}
 		}
 
+		/// <summary>
+		/// Snapshot of this thread's counters, read without locking while the thread keeps counting
+		/// </summary>
+		ThreadStats GetStats() const;
+
+		/// <summary>
+		/// Is this thread sleeping until woken, having found no jobs while spinning?
+		/// </summary>
+		inline bool IsSleeping() const
+		{
+			return m_isSleeping.load(std::memory_order_acquire);
+		}
+
+		/// <summary>
+		/// Is the calling thread executing a job on one of this thread's fibers?
+		/// </summary>
+		inline bool IsOnFiber() const
+		{
+			return m_currentFiber != nullptr;
+		}
+
 		/// <summary>
 		/// Begins thread execution
 		/// </summary>
@@ -115,17 +212,32 @@ namespace AndGen
 		/// <summary>
 		/// Removes all jobs from the execution queue
 		/// </summary>
-		inline void ClearQueue()
-		{
-			m_jobQueue.Clear();
-		}
+		/// <remarks>
+		/// Jobs are discarded without executing, see <see cref="JobRecord::Discard"/>, and are no longer counted
+		/// as queued by the thread pool owning this thread, so waiting on the pool or their counters doesn't wait
+		/// for them. Jobs depending on discarded jobs are cancelled.
+		/// </remarks>
+		/// <returns>Amount of jobs discarded</returns>
+		size_t ClearQueue();
+
+		/// <summary>
+		/// Wakes the thread if it's sleeping, allowing it to steal jobs from other threads
+		/// </summary>
+		/// <remarks>
+		/// Threads which are spinning will find new jobs without being woken, so this only makes a system call
+		/// when the thread is sleeping, or about to sleep.
+		/// </remarks>
+		/// <returns>True if the thread was sleeping, otherwise false</returns>
+		bool WakeUp();
 
 		/// <summary>
 		/// Adds a job to the queue to be executed by the thread
 		/// </summary>
+		/// <param name="job">Job to enqueue</param>
+		/// <param name="priority">Priority of the job</param>
 		/// <typeparam name="JobType">Type of job</typeparam>
 		template<class JobType>
-		void QueueJob(const std::shared_ptr<JobType>& job)
+		void QueueJob(const std::shared_ptr<JobType>& job, JobPriority priority = JobPriority::Frame)
 		{
 			// Ignore if job is null
 			if (job == nullptr)
@@ -133,16 +245,79 @@ namespace AndGen
 				return;
 			}
 
-			// Add job to queue
-			m_jobQueue.AddJob(std::static_pointer_cast<Job>(job));
+			QueueJob(JobRecord::Create(std::static_pointer_cast<Job>(job)), priority);
+		}
+		/// <summary>
+		/// Adds a job record to the queue to be executed by the thread
+		/// </summary>
+		/// <param name="record">Job record, which the thread takes ownership of</param>
+		/// <param name="priority">Priority of the job</param>
+		void QueueJob(JobRecord* record, JobPriority priority = JobPriority::Frame);
+		/// <summary>
+		/// Adds a batch of job records to the queue to be executed by the thread
+		/// </summary>
+		/// <remarks>
+		/// The queue is locked once for the whole batch, and the thread is notified once.
+		/// </remarks>
+		/// <param name="records">Job records, which the thread takes ownership of</param>
+		/// <param name="count">Amount of job records</param>
+		/// <param name="priority">Priority of the jobs</param>
+		void QueueJobs(JobRecord* const* records, size_t count, JobPriority priority = JobPriority::Frame);
 
-			// Notify waiting internal thread there are jobs
-			m_jobsReadyNotification.Notify();
+		/// <summary>
+		/// Pushes a job onto this thread's work-stealing deque
+		/// </summary>
+		/// <remarks>
+		/// Local jobs are executed in LIFO order by this thread, and may be stolen in FIFO order 
+		/// by other threads within the same pool. Only this thread may push local jobs; calls from
+		/// any other thread fall back to <see cref="QueueJob"/>.
+		/// </remarks>
+		/// <typeparam name="JobType">Type of job</typeparam>
+		template<class JobType>
+		void PushLocalJob(const std::shared_ptr<JobType>& job)
+		{
+			// Ignore if job is null
+			if (job == nullptr)
+			{
+				return;
+			}
+
+			PushLocalJob(JobRecord::Create(std::static_pointer_cast<Job>(job)));
 		}
+		/// <summary>
+		/// Pushes a job record onto this thread's work-stealing deque
+		/// </summary>
+		/// <param name="record">Job record, which the thread takes ownership of</param>
+		void PushLocalJob(JobRecord* record);
+
+		/// <summary>
+		/// Steals a job from this thread, to be executed by another thread
+		/// </summary>
+		/// <param name="record">Set to the stolen job record, which the caller takes ownership of</param>
+		/// <param name="lowestPriority">Lowest priority of job to steal, lower priority jobs are left queued</param>
+		/// <returns>True if a job was stolen, otherwise false</returns>
+		bool StealJob(JobRecord*& record, JobPriority lowestPriority = JobPriority::Idle);
 
 	private:
-		// Queue of jobs for this thread to execute
-		AndGen::JobQueue m_jobQueue;
+		// Queue of jobs for this thread to execute, added by other threads
+		QueueType m_jobQueue;
+		// Jobs pushed by this thread, which other threads within the pool may steal
+		AndGen::WorkStealingDeque<JobRecord*> m_localJobs;
+
+		// Thread pool owning this thread, if any
+		ThreadPool* m_threadPool;
+		// Index of this thread within the owning thread pool
+		unsigned int m_index;
+		// State of the random number generator used to select threads to steal from
+		std::uint32_t m_randomState;
+		// Logical CPU the thread pins itself to when started, if any
+		int m_cpu;
+		// Depth of blocking regions the thread is currently within
+		unsigned int m_blockingDepth;
+		// Indices of threads within the pool to steal from, in groups from closest to furthest
+		std::vector<unsigned int> m_victims;
+		// End of each group of victims, within the victims
+		std::vector<size_t> m_victimGroupEnds;
 
 		// Controls execution of the execution loop
 		std::atomic_bool m_shouldExit;
@@ -150,19 +325,132 @@ namespace AndGen
 		std::atomic_bool m_isRunning;
 		// Is the thread currently executing a job?
 		std::atomic_bool m_isExecuting;
+		// Is the thread sleeping, or about to sleep, until woken?
+		std::atomic_bool m_isSleeping;
+
+		// How long the thread looks for jobs before sleeping
+		IdlePolicy m_idlePolicy;
+		// Times the thread currently checks for jobs while spinning, adapted within the idle policy's budget
+		unsigned int m_spinLimit;
 
 		// Blocks internal thread execution when no jobs are to be completed
 		// or application is shutting down, and only currently executing job should be executed
-		AndGen::ThreadNotifier m_jobsReadyNotification;
+		AndGen::ThreadParker m_parker;
 		// Blocks calling threads of WaitForQueue() until all jobs in queue are completed
 		AndGen::ThreadNotifier m_jobsCompleteNotification;
 
 		// Execution thread
 		std::thread m_thread;
 
+		/// <summary>
+		/// What the thread is doing, timed by its counters
+		/// </summary>
+		enum class Activity
+		{
+			Executing,
+			Spinning,
+			Parked,
+			Stopped
+		};
+
+		/// <summary>
+		/// Counters of the thread, on their own cache lines
+		/// </summary>
+		/// <remarks>
+		/// Counters are only written by the thread itself, so are updated with plain loads and stores rather than
+		/// read-modify-writes, and other threads read them without waiting.
+		/// </remarks>
+		struct alignas(64) Counters
+		{
+			std::atomic<std::uint64_t> jobsExecuted		= 0;
+			std::atomic<std::uint64_t> jobsQueued		= 0;
+			std::atomic<std::uint64_t> stealAttempts	= 0;
+			std::atomic<std::uint64_t> steals			= 0;
+			// Nanoseconds spent on each timed activity, excluding Stopped
+			std::array<std::atomic<std::uint64_t>, 3> activityTimes	= {};
+			std::array<std::atomic<std::uint64_t>, ThreadStats::QueueDepthBucketCount> queueDepthHistogram = {};
+
+			// Adds to a counter, only from the thread owning the counters
+			static inline void Add(std::atomic<std::uint64_t>& counter, std::uint64_t amount = 1)
+			{
+				counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+			}
+		};
+
+		// Counters of the thread, read by GetStats()
+		Counters m_counters;
+		// What the thread is currently doing, and since when in nanoseconds since the steady clock's epoch
+		Activity m_activity;
+		std::int64_t m_activityStart;
+
+		/// <summary>
+		/// Fiber executing jobs on this thread, while the thread pool is in fiber mode
+		/// </summary>
+		struct JobFiber
+		{
+			JobFiber(PooledThread* owner) : fiber(&PooledThread::FiberEntry, this), thread(owner),
+				record(nullptr), waitingOn(nullptr) {}
+
+			// Fiber executing jobs
+			Fiber fiber;
+			// Thread owning the fiber, which it must only execute on
+			PooledThread* thread;
+			// Job to execute once switched to
+			JobRecord* record;
+			// Counter the fiber is suspended on, if any
+			const JobCounter* waitingOn;
+		};
+
+		// Context of this thread's own stack, which schedules fibers while in fiber mode
+		std::unique_ptr<Fiber> m_threadFiber;
+		// Fiber currently executing a job, if any
+		JobFiber* m_currentFiber;
+		// All fibers created by this thread
+		std::vector<std::unique_ptr<JobFiber>> m_fibers;
+		// Fibers with no job, ready to be reused
+		std::vector<JobFiber*> m_freeFibers;
+		// Fibers suspended until a counter completes
+		std::vector<JobFiber*> m_waitingFibers;
+
+		friend class BlockingRegion;
+		friend class ThreadPool;
+
+		// Pooled thread executing on the current thread, if any
+		static thread_local PooledThread* s_currentThread;
+
 		// Executes all jobs in the queue
 		// and waits for a job to be added when none are left
 		void ExecutionLoop();
+
+		// Finds the next job to execute, either from this thread's queues or another thread's
+		bool FindJob(JobRecord*& record);
+		// Executes a job, on a fiber if enabled
+		void ExecuteJob(JobRecord* record, bool useFibers);
+		// Waits for a job while idle, spinning, then yielding, then sleeping until woken
+		bool WaitForJob(JobRecord*& record, unsigned int& idleRound);
+		// Sleeps until woken, unless a job is found after announcing this thread is sleeping
+		bool Sleep(JobRecord*& record);
+		// Marks this thread as awake, returning true if it was sleeping
+		bool ClaimWakeUp();
+		// Retires this thread if its elastic thread pool allows it and it has no jobs of its own left
+		bool TryRetire(bool isIdle);
+		// Attempts to steal a job from other threads in the pool, closest first, starting with a random thread
+		bool StealJobFromPool(JobRecord*& record, JobPriority lowestPriority);
+		// Counts a job beginning, and the amount of jobs left waiting on this thread
+		void CountJobExecuted();
+		// Changes what the thread is doing, adding the time spent on its last activity to its counters
+		void SetActivity(Activity activity);
+
+		// Executes a job on a free fiber, creating a new fiber if none are free
+		void ExecuteOnFiber(JobRecord* record);
+		// Switches to a fiber until it completes its job or is suspended
+		void SwitchToFiber(JobFiber* jobFiber);
+		// Resumes a suspended fiber whose counter has completed, if any
+		bool ResumeReadyFiber();
+		// Suspends the current fiber until a counter completes, executing other jobs meanwhile
+		void SuspendFiber(const JobCounter& counter);
+		// Executes jobs given to a fiber, switching back to the thread after each job
+		static void FiberEntry(void* argument);
 	};
 }
 
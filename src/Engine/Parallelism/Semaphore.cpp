@@ -0,0 +1,54 @@
+#include "Semaphore.hpp"
+
+// AndGen includes
+#include "Futex.hpp"
+#include "SpinWait.hpp"
+
+// Decrements the count, blocking while it's zero
+void AndGen::Semaphore::Acquire()
+{
+	// Spin briefly, as the count is often released soon after
+	SpinBackoff backoff;
+	while (!backoff.ShouldBlock())
+	{
+		if (TryAcquire())
+		{
+			return;
+		}
+
+		backoff.Pause();
+	}
+
+	// Count this thread as waiting before checking the count again, so releasing either sees
+	// this thread waiting or this thread sees the released count
+	m_waitingCount.fetch_add(1, std::memory_order_seq_cst);
+	while (!TryAcquire())
+	{
+		Futex::Wait(m_count, 0);
+	}
+	m_waitingCount.fetch_sub(1, std::memory_order_relaxed);
+}
+
+// Increments the count, waking threads blocked acquiring the semaphore
+void AndGen::Semaphore::Release(std::uint32_t count)
+{
+	if (count == 0)
+	{
+		return;
+	}
+
+	m_count.fetch_add(count, std::memory_order_seq_cst);
+	if (m_waitingCount.load(std::memory_order_seq_cst) == 0)
+	{
+		return;
+	}
+
+	if (count == 1)
+	{
+		Futex::WakeOne(m_count);
+	}
+	else
+	{
+		Futex::WakeAll(m_count);
+	}
+}
@@ -0,0 +1,75 @@
+#ifndef SEMAPHORE_H
+#define SEMAPHORE_H
+
+// STL includes
+#include <atomic>
+#include <cstdint>
+
+namespace AndGen
+{
+	/// <summary>
+	/// Counting semaphore, which blocks threads acquiring it while its count is zero
+	/// </summary>
+	/// <remarks>
+	/// Acquiring spins briefly before blocking on a futex, and releasing only makes a system call
+	/// when threads are blocked. The count is kept on its own cache line.
+	/// </remarks>
+	class alignas(64) Semaphore
+	{
+	public:
+		/// <summary>
+		/// Constructs a new semaphore
+		/// </summary>
+		/// <param name="initialCount">Count the semaphore starts with</param>
+		explicit Semaphore(std::uint32_t initialCount = 0) : m_count(initialCount), m_waitingCount(0) {}
+		Semaphore(const Semaphore&)				= delete;
+		Semaphore& operator=(const Semaphore&)	= delete;
+		~Semaphore()							= default;
+
+		/// <summary>
+		/// Current count of the semaphore
+		/// </summary>
+		inline std::uint32_t Count() const
+		{
+			return m_count.load(std::memory_order_acquire);
+		}
+
+		/// <summary>
+		/// Decrements the count if it's above zero, without blocking
+		/// </summary>
+		/// <returns>True if the count was decremented, otherwise false</returns>
+		inline bool TryAcquire()
+		{
+			std::uint32_t count = m_count.load(std::memory_order_relaxed);
+			while (count > 0)
+			{
+				if (m_count.compare_exchange_weak(count, count - 1, std::memory_order_acquire,
+					std::memory_order_relaxed))
+				{
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		/// <summary>
+		/// Decrements the count, blocking while it's zero
+		/// </summary>
+		void Acquire();
+
+		/// <summary>
+		/// Increments the count, waking threads blocked acquiring the semaphore
+		/// </summary>
+		/// <param name="count">Amount to increment by</param>
+		void Release(std::uint32_t count = 1);
+
+	private:
+		// Current count of the semaphore
+		std::atomic<std::uint32_t> m_count;
+		// Amount of threads blocked, or about to block, acquiring the semaphore
+		std::atomic<std::uint32_t> m_waitingCount;
+	};
+}
+
+#endif
@@ -0,0 +1,83 @@
+#ifndef SPINLOCK_H
+#define SPINLOCK_H
+
+// STL includes
+#include <atomic>
+// AndGen includes
+#include "SpinWait.hpp"
+
+namespace AndGen
+{
+	/// <summary>
+	/// Test-and-test-and-set spin lock, for protecting very short critical sections
+	/// </summary>
+	/// <remarks>
+	/// <para>Threads waiting for the lock only read it, with exponential backoff between reads, so the cache
+	/// line isn't written until the lock looks free. Waiting threads never block, so critical sections must
+	/// be short and must not wait on other threads.</para>
+	/// <para>Satisfies the standard Lockable requirements, so can be used with std::scoped_lock.</para>
+	/// </remarks>
+	class alignas(64) SpinLock
+	{
+	public:
+		/// <summary>
+		/// Constructs a new unlocked spin lock
+		/// </summary>
+		SpinLock() : m_isLocked(false) {}
+		SpinLock(const SpinLock&)				= delete;
+		SpinLock& operator=(const SpinLock&)	= delete;
+		~SpinLock()								= default;
+
+		/// <summary>
+		/// Locks the spin lock, spinning until it's available
+		/// </summary>
+		inline void Lock()
+		{
+			SpinBackoff backoff;
+			while (m_isLocked.exchange(true, std::memory_order_acquire))
+			{
+				// Wait for lock to look free before attempting to take it again
+				do
+				{
+					backoff.Pause();
+				} while (m_isLocked.load(std::memory_order_relaxed));
+			}
+		}
+
+		/// <summary>
+		/// Locks the spin lock if it's available, without spinning
+		/// </summary>
+		/// <returns>True if the lock was taken, otherwise false</returns>
+		inline bool TryLock()
+		{
+			return !m_isLocked.load(std::memory_order_relaxed) && !m_isLocked.exchange(true, std::memory_order_acquire);
+		}
+
+		/// <summary>
+		/// Unlocks the spin lock, which must be held by the calling thread
+		/// </summary>
+		inline void Unlock()
+		{
+			m_isLocked.store(false, std::memory_order_release);
+		}
+
+		/// <summary>
+		/// Is the spin lock currently held by any thread?
+		/// </summary>
+		inline bool IsLocked() const
+		{
+			return m_isLocked.load(std::memory_order_relaxed);
+		}
+
+		// Lockable requirements
+		inline void lock()		{ Lock(); }
+		inline bool try_lock()	{ return TryLock(); }
+		inline void unlock()	{ Unlock(); }
+
+	private:
+		// Is the spin lock currently held?
+		std::atomic_bool m_isLocked;
+	};
+}
+
+#endif
@@ -0,0 +1,93 @@
+#ifndef SPINWAIT_H
+#define SPINWAIT_H
+
+namespace AndGen
+{
+	/// <summary>
+	/// Hints to the processor that the calling thread is spinning, reducing its power use
+	/// and its contention with other hardware threads on the same core
+	/// </summary>
+	inline void CpuPause()
+	{
+#if defined(__x86_64__) || defined(__i386__)
+		__builtin_ia32_pause();
+#elif defined(__aarch64__)
+		asm volatile("yield" ::: "memory");
+#endif
+	}
+
+	/// <summary>
+	/// Spins with exponential backoff, for threads waiting a short time on a value changed by another thread
+	/// </summary>
+	/// <remarks>
+	/// Each call to <see cref="Pause"/> executes twice as many pause instructions as the last, up to
+	/// <see cref="MaxPauseCount"/>, so contending threads spread out their accesses to shared cache lines.
+	/// </remarks>
+	class SpinBackoff
+	{
+	public:
+		/// <summary>
+		/// Most pause instructions executed by a single call to <see cref="Pause"/>
+		/// </summary>
+		static constexpr unsigned int MaxPauseCount	= 64;
+		/// <summary>
+		/// Calls to <see cref="Pause"/> after which a thread able to block should stop spinning
+		/// </summary>
+		static constexpr unsigned int SpinLimit		= 16;
+
+		/// <summary>
+		/// Constructs a new backoff, starting with a single pause
+		/// </summary>
+		SpinBackoff() : m_pauseCount(1), m_spinCount(0) {}
+
+		/// <summary>
+		/// Pauses the calling thread, for longer than the last call
+		/// </summary>
+		inline void Pause()
+		{
+			for (unsigned int i = 0; i < m_pauseCount; i++)
+			{
+				CpuPause();
+			}
+
+			if (m_pauseCount < MaxPauseCount)
+			{
+				m_pauseCount *= 2;
+			}
+			m_spinCount++;
+		}
+
+		/// <summary>
+		/// Amount of times <see cref="Pause"/> has been called
+		/// </summary>
+		inline unsigned int SpinCount() const
+		{
+			return m_spinCount;
+		}
+
+		/// <summary>
+		/// Has the thread spun for long enough that it should block instead, if able to?
+		/// </summary>
+		inline bool ShouldBlock() const
+		{
+			return m_spinCount >= SpinLimit;
+		}
+
+		/// <summary>
+		/// Starts again from a single pause
+		/// </summary>
+		inline void Reset()
+		{
+			m_pauseCount	= 1;
+			m_spinCount		= 0;
+		}
+
+	private:
+		// Pause instructions executed by the next pause
+		unsigned int m_pauseCount;
+		// Amount of pauses so far
+		unsigned int m_spinCount;
+	};
+}
+
+#endif
@@ -6,7 +6,19 @@
 // Notifies all waiting threads
 void AndGen::ThreadNotifier::Notify()
 {
-	m_shouldWake = true;
+	{
+		std::scoped_lock<std::mutex> lock(m_mutex);
+
+		// Wake the next thread to wait if there are none waiting now
+		if (m_waitingCount == 0)
+		{
+			m_shouldWake = true;
+			return;
+		}
+
+		m_generation++;
+	}
+
 	m_conditionVariable.notify_all();
 }
 
@@ -14,5 +26,16 @@ void AndGen::ThreadNotifier::Notify()
 void AndGen::ThreadNotifier::Wait()
 {
 	std::unique_lock<std::mutex> lock(m_mutex);
-	m_conditionVariable.wait(lock, [this] { return m_shouldWake.load(); });
+
+	// Consume a notification given while no threads were waiting
+	if (m_shouldWake)
+	{
+		m_shouldWake = false;
+		return;
+	}
+
+	unsigned int generation = m_generation;
+	m_waitingCount++;
+	m_conditionVariable.wait(lock, [this, generation] { return m_generation != generation; });
+	m_waitingCount--;
 }
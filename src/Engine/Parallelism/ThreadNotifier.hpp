@@ -4,6 +4,7 @@
 // STL includes
 #include <mutex>
 #include <atomic>
+#include <condition_variable>
 #include <thread>
 
 namespace AndGen
@@ -17,7 +18,7 @@ namespace AndGen
 		/// <summary>
 		/// Constructs a new Thread Notifier
 		/// </summary>
-		ThreadNotifier() : m_shouldWake(false) {}
+		ThreadNotifier() : m_shouldWake(false), m_generation(0), m_waitingCount(0) {}
 		ThreadNotifier(const ThreadNotifier&)					= delete;
 		/// <summary>
 		/// Destroys this Thread Notifier
@@ -28,16 +29,26 @@ namespace AndGen
 		/// <summary>
 		/// Notifies all waiting threads
 		/// </summary>
+		/// <remarks>
+		/// When no threads are waiting, the next thread to wait is woken immediately instead.
+		/// </remarks>
 		void Notify();
 
 		/// <summary>
 		/// Blocks the calling thread until another thread notifies to wake up
 		/// </summary>
+		/// <remarks>
+		/// Each notification is consumed, so later calls block until notified again.
+		/// </remarks>
 		void Wait();
 
 	private:
-		// Used within condition variable for waiting threads
-		std::atomic_bool m_shouldWake;
+		// Set when notified with no threads waiting, and consumed by the next thread to wait
+		bool m_shouldWake;
+		// Incremented by each notification which wakes waiting threads
+		unsigned int m_generation;
+		// Amount of threads currently waiting
+		unsigned int m_waitingCount;
 		// Used to notify threads when to wake up
 		std::condition_variable m_conditionVariable;
 		// Mutex for editing the condition variable
@@ -0,0 +1,70 @@
+#include "ThreadParker.hpp"
+
+// STL includes
+#include <chrono>
+// AndGen includes
+#include "Futex.hpp"
+
+// Blocks the calling thread until unparked, returning immediately if already unparked
+void AndGen::ThreadParker::Park()
+{
+	// Consume a pending unpark, otherwise move from empty to parked
+	if (m_state.fetch_sub(1, std::memory_order_acquire) == Notified)
+	{
+		return;
+	}
+
+	for (;;)
+	{
+		Futex::Wait(m_state, Parked);
+
+		// Ignore spurious wake-ups
+		std::uint32_t notified = Notified;
+		if (m_state.compare_exchange_strong(notified, Empty, std::memory_order_acquire))
+		{
+			return;
+		}
+	}
+}
+
+// Blocks the calling thread until unparked or a timeout passes, returning immediately if already unparked
+bool AndGen::ThreadParker::ParkFor(std::chrono::nanoseconds timeout)
+{
+	// Consume a pending unpark, otherwise move from empty to parked
+	if (m_state.fetch_sub(1, std::memory_order_acquire) == Notified)
+	{
+		return true;
+	}
+
+	std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + timeout;
+	for (;;)
+	{
+		Futex::WaitFor(m_state, Parked, deadline - std::chrono::steady_clock::now());
+
+		// Ignore spurious wake-ups
+		std::uint32_t notified = Notified;
+		if (m_state.compare_exchange_strong(notified, Empty, std::memory_order_acquire))
+		{
+			return true;
+		}
+
+		// Stop parking once the timeout passes, unless unparked meanwhile
+		if (std::chrono::steady_clock::now() >= deadline)
+		{
+			std::uint32_t parked = Parked;
+			if (m_state.compare_exchange_strong(parked, Empty, std::memory_order_relaxed))
+			{
+				return false;
+			}
+		}
+	}
+}
+
+// Unparks the parked thread, or the next thread to park
+void AndGen::ThreadParker::Unpark()
+{
+	if (m_state.exchange(Notified, std::memory_order_release) == Parked)
+	{
+		Futex::WakeOne(m_state);
+	}
+}
@@ -0,0 +1,66 @@
+#ifndef THREADPARKER_H
+#define THREADPARKER_H
+
+// STL includes
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace AndGen
+{
+	/// <summary>
+	/// Blocks a single thread until another thread unparks it, using a futex
+	/// </summary>
+	/// <remarks>
+	/// Unparking a thread which isn't parked makes its next <see cref="Park"/> return immediately, so a wake-up
+	/// given between a thread deciding to park and actually parking isn't lost. Only unparking a parked thread
+	/// makes a system call.
+	/// </remarks>
+	class ThreadParker
+	{
+	public:
+		/// <summary>
+		/// Constructs a new thread parker, which isn't unparked
+		/// </summary>
+		ThreadParker() : m_state(Empty) {}
+		ThreadParker(const ThreadParker&)				= delete;
+		ThreadParker& operator=(const ThreadParker&)	= delete;
+		~ThreadParker()									= default;
+
+		/// <summary>
+		/// Blocks the calling thread until unparked, returning immediately if already unparked
+		/// </summary>
+		/// <remarks>
+		/// Must only be called by a single thread at a time.
+		/// </remarks>
+		void Park();
+
+		/// <summary>
+		/// Blocks the calling thread until unparked or a timeout passes, returning immediately if already unparked
+		/// </summary>
+		/// <remarks>
+		/// Must only be called by a single thread at a time.
+		/// </remarks>
+		/// <param name="timeout">Longest time to block for</param>
+		/// <returns>True if the thread was unparked, otherwise false if the timeout passed</returns>
+		bool ParkFor(std::chrono::nanoseconds timeout);
+
+		/// <summary>
+		/// Unparks the parked thread, or the next thread to park
+		/// </summary>
+		void Unpark();
+
+	private:
+		// Neither parked nor unparked
+		static constexpr std::uint32_t Empty	= 0;
+		// Unparked, so the next park returns immediately
+		static constexpr std::uint32_t Notified	= 1;
+		// A thread is parked, or about to be
+		static constexpr std::uint32_t Parked	= UINT32_MAX;
+
+		// Current state of the parker
+		std::atomic<std::uint32_t> m_state;
+	};
+}
+
+#endif
@@ -1,34 +1,687 @@
 #include "ThreadPool.hpp"
 
+// STL includes
+#include <algorithm>
+#include <functional>
+#include <thread>
+#include <utility>
+// AndGen includes
+#include "SpinWait.hpp"
+
+// Thread pool the current thread is helping to execute jobs for within Wait(), if it isn't a pooled thread
+thread_local AndGen::ThreadPool* AndGen::ThreadPool::s_helpingPool = nullptr;
+
 // Constructs a new thread pool with a specified amount of threads
-AndGen::ThreadPool::ThreadPool(unsigned int threadCount)
+AndGen::ThreadPool::ThreadPool(unsigned int threadCount, AndGen::ThreadPool::ExecutionMode executionMode,
+	const AndGen::IdlePolicy& idlePolicy, AndGen::ThreadPool::ThreadPlacement placement,
+	const AndGen::ElasticPolicy& elasticPolicy, unsigned int ioThreadCount) :
+	m_executionMode(executionMode), m_idlePolicy(idlePolicy), m_placement(placement), m_reservedCpu(-1),
+	m_elasticPolicy(elasticPolicy), m_targetCount(threadCount), m_permanentCount(threadCount),
+	m_activeCount(threadCount), m_blockingCount(0), m_isDestroying(false), m_nextThread(0), m_sleepingCount(0),
+	m_executingCount(0), m_externalJobsQueued(0), m_externalJobsExecuted(0), m_discardedJobs(0),
+	m_frameStart(Now()), m_deferAfter(NoTime), m_promoteWindow(0), m_nextDeadline(NoTime)
 {
-	m_threads.reserve(threadCount);
+	if (executionMode == ExecutionMode::Fibers && !Fiber::IsSupported())
+	{
+		throw NotImplementedException();
+	}
 
-	// Create threads and start them
-	for (size_t i = 0; i < threadCount; i++)
+	// Elastic pools construct their temporary threads up front, so threads can be read without locking,
+	// pools without threads stay empty
+	unsigned int maxThreadCount = threadCount;
+	if (threadCount > 0)
+	{
+		maxThreadCount = std::max(threadCount, elasticPolicy.maxThreadCount);
+		if (elasticPolicy.minThreadCount > 0)
+		{
+			m_permanentCount = std::min(elasticPolicy.minThreadCount, threadCount);
+		}
+	}
+	m_threads.reserve(maxThreadCount);
+
+	// Create all threads before starting any,
+	// since running threads will steal from each other
+	for (unsigned int i = 0; i < maxThreadCount; i++)
+	{
+		m_threads.push_back(std::make_unique<PooledThread>(this, i, idlePolicy));
+	}
+	if (placement == ThreadPlacement::Pinned)
+	{
+		PlaceThreads();
+	}
+	OrderVictims();
+
+	for (unsigned int i = 0; i < threadCount; i++)
 	{
-		m_threads.push_back(std::make_unique<PooledThread>());
 		m_threads[i]->Start();
 	}
+
+	// I/O threads spend most of their time blocked, so they sleep as soon as they run out of jobs,
+	// and are left for the operating system to place around the pinned threads
+	if (ioThreadCount > 0)
+	{
+		m_ioPool = std::make_unique<ThreadPool>(ioThreadCount, ExecutionMode::Threads, IdlePolicy::LowPower(),
+			ThreadPlacement::Unpinned);
+	}
 }
 
 // De-constructor of the Thread Pool
 AndGen::ThreadPool::~ThreadPool()
 {
+	// Stop I/O threads first, as completing their jobs may queue jobs with this pool's threads
+	m_ioPool.reset();
+
+	// Prevent blocking jobs from starting threads meanwhile
+	{
+		std::lock_guard<std::mutex> lock(m_elasticMutex);
+		m_isDestroying = true;
+	}
+
 	// Wait for threads to finish executing
 	for (size_t i = 0; i < m_threads.size(); i++)
 	{
 		m_threads[i]->Stop(true);
 	}
+
+	// Discard jobs with deadlines which were never taken
+	std::vector<DeadlineRecord> deadlineJobs;
+	deadlineJobs.swap(m_deadlineJobs);
+	for (size_t i = 0; i < deadlineJobs.size(); i++)
+	{
+		JobRecord::Discard(deadlineJobs[i].record);
+	}
+	DiscardedJobs(deadlineJobs.size());
+
+	// Discard jobs left within each thread's queue while the pool's counters remain, repeating as discarding
+	// a job queues the jobs depending on it
+	size_t discardedCount;
+	do
+	{
+		discardedCount = 0;
+		for (size_t i = 0; i < m_threads.size(); i++)
+		{
+			discardedCount += m_threads[i]->ClearQueue();
+		}
+	}
+	while (discardedCount > 0);
 }
 
-// Waits for threads to complete their current tasks and become idle
+// Returns the ideal amount of threads in the pool for maximum performance
+unsigned int AndGen::ThreadPool::GetIdealThreadCount()
+{
+	size_t coreCount = CpuTopology::Get().PhysicalCoreCount();
+	return coreCount > 0 ? static_cast<unsigned int>(coreCount - 1) : 0;
+}
+
+// Pins the calling thread to the CPU reserved for it
+bool AndGen::ThreadPool::PinToReservedCpu() const
+{
+	if (m_reservedCpu < 0)
+	{
+		return false;
+	}
+
+	return CpuTopology::PinCurrentThread(static_cast<unsigned int>(m_reservedCpu));
+}
+
+// Begins a new frame, with a budget for the time it may take
+void AndGen::ThreadPool::BeginFrame(const AndGen::FrameBudget& budget)
+{
+#if defined(ANDGEN_JOB_PROFILER)
+	JobProfiler::MarkFrame();
+#endif
+	std::int64_t frameStart = Now();
+	m_frameStart.store(frameStart, std::memory_order_relaxed);
+	m_promoteWindow.store(budget.promoteWindow.count(), std::memory_order_relaxed);
+	m_deferAfter.store(budget.frameTime > std::chrono::nanoseconds::zero() ?
+		frameStart + (budget.frameTime - budget.deferMargin).count() : NoTime, std::memory_order_relaxed);
+
+	// Wake threads which slept while jobs were deferred, pairing with PooledThread::Sleep()
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	size_t sleepingCount = m_sleepingCount.load(std::memory_order_relaxed);
+	if (sleepingCount == 0)
+	{
+		return;
+	}
+
+	size_t pendingCount = PendingJobsCount();
+	for (size_t i = 0; i < m_threads.size() && pendingCount > 0; i++)
+	{
+		if (m_threads[i]->WakeUp())
+		{
+			pendingCount--;
+		}
+	}
+}
+
+// Counts a thread as retired, if the pool allows it
+bool AndGen::ThreadPool::RetireThread(bool isIdle)
+{
+	unsigned int activeCount = m_activeCount.load(std::memory_order_relaxed);
+	do
+	{
+		// Busy threads only retire while more threads are executing jobs than needed
+		if (!isIdle && activeCount <= m_targetCount + m_blockingCount.load(std::memory_order_relaxed))
+		{
+			return false;
+		}
+	}
+	while (!m_activeCount.compare_exchange_weak(activeCount, activeCount - 1, std::memory_order_acq_rel,
+		std::memory_order_relaxed));
+
+	return true;
+}
+
+// Counts a thread as blocking, starting a temporary thread to make up for it if needed
+void AndGen::ThreadPool::BeginBlocking()
+{
+	unsigned int blockingCount = m_blockingCount.fetch_add(1, std::memory_order_acq_rel) + 1;
+
+	// Sleeping threads can take jobs without starting another thread, as can a pool which is already full
+	if (m_sleepingCount.load(std::memory_order_acquire) > 0 ||
+		m_activeCount.load(std::memory_order_acquire) >= m_threads.size())
+	{
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(m_elasticMutex);
+	unsigned int activeCount = m_activeCount.load(std::memory_order_acquire);
+	if (m_isDestroying || activeCount >= m_threads.size() || activeCount >= m_targetCount + blockingCount)
+	{
+		return;
+	}
+
+	// Start a thread which has fully retired, threads still exiting can't be started again yet
+	for (size_t i = m_permanentCount; i < m_threads.size(); i++)
+	{
+		if (m_threads[i]->GetStatus() == PooledThread::Status::Stopped)
+		{
+			m_activeCount.fetch_add(1, std::memory_order_acq_rel);
+			m_threads[i]->Start();
+
+			return;
+		}
+	}
+}
+
+// Counts a thread as no longer blocking
+void AndGen::ThreadPool::EndBlocking()
+{
+	m_blockingCount.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+// Waits for all jobs counted by a counter to complete
+void AndGen::ThreadPool::Wait(const AndGen::JobCounter& counter)
+{
+	// Suspend jobs executing on fibers, so their thread can execute other jobs
+	PooledThread* currentThread = PooledThread::GetCurrent();
+	if (currentThread != nullptr && currentThread->GetThreadPool() == this && currentThread->IsOnFiber())
+	{
+		if (!counter.IsComplete())
+		{
+			currentThread->SuspendFiber(counter);
+		}
+
+		return;
+	}
+
+	// Jobs executed by a thread outside of the pool spawn their children with the pool,
+	// restoring the pool it was helping even if a job executed here throws
+	struct HelpingPoolScope
+	{
+		ThreadPool* previousPool;
+		~HelpingPoolScope() { s_helpingPool = previousPool; }
+	} helpingPoolScope{ s_helpingPool };
+	bool isPooledThread = currentThread != nullptr && currentThread->GetThreadPool() == this;
+	if (currentThread == nullptr)
+	{
+		s_helpingPool = this;
+	}
+
+	JobRecord* record		= nullptr;
+	unsigned int idleRound	= 0;
+	while (!counter.IsComplete())
+	{
+		// Help execute jobs while waiting, rather than blocking
+		if (TakeJob(record))
+		{
+			CountExecuted(currentThread);
+			JobRecord::Execute(record);
+			m_queuedJobsCounter.Decrement();
+
+			idleRound = 0;
+			continue;
+		}
+
+		// Nothing to execute, jobs counted are either executing or waiting for dependencies,
+		// so spin then yield as the pool's idle threads do, with pauses doubling in length
+		if (idleRound < m_idlePolicy.spinCount)
+		{
+			unsigned int pauseCount = std::min(1u << std::min(idleRound, 31u), IdlePolicy::MaxPausesPerSpin);
+			for (unsigned int i = 0; i < pauseCount; i++)
+			{
+				CpuPause();
+			}
+			idleRound++;
+		}
+		else if (idleRound < m_idlePolicy.spinCount + m_idlePolicy.yieldCount)
+		{
+			std::this_thread::yield();
+			idleRound++;
+		}
+		else if (isPooledThread)
+		{
+			// Jobs queued on a pooled thread don't wake it while it waits, so look for them again periodically
+			counter.Internal_ParkFor(PooledWaitTimeout);
+		}
+		else
+		{
+			// Then block until the last job counted completes
+			counter.Internal_Park();
+		}
+	}
+}
+
+// Waits for all queued jobs to complete
 void AndGen::ThreadPool::WaitForThreads()
 {
-	// Wait for each thread to complete their execution queue
+	// Jobs on either set of threads may queue jobs on the other, so wait until both are complete at once
+	do
+	{
+		Wait(m_queuedJobsCounter);
+		if (m_ioPool != nullptr)
+		{
+			m_ioPool->WaitForThreads();
+		}
+	}
+	while (!m_queuedJobsCounter.IsComplete());
+}
+
+// The amount of Jobs currently queued to be processed
+unsigned int AndGen::ThreadPool::PendingJobsCount() const
+{
+	// Read jobs begun or discarded before jobs queued, as every job begun was queued first
+	std::uint64_t executedCount = m_externalJobsExecuted.load(std::memory_order_acquire) +
+		m_discardedJobs.load(std::memory_order_acquire);
+	for (size_t i = 0; i < m_threads.size(); i++)
+	{
+		executedCount += m_threads[i]->m_counters.jobsExecuted.load(std::memory_order_acquire);
+	}
+
+	std::uint64_t queuedCount = m_externalJobsQueued.load(std::memory_order_acquire);
+	for (size_t i = 0; i < m_threads.size(); i++)
+	{
+		queuedCount += m_threads[i]->m_counters.jobsQueued.load(std::memory_order_acquire);
+	}
+
+	return queuedCount > executedCount ? static_cast<unsigned int>(queuedCount - executedCount) : 0;
+}
+
+// Snapshot of the counters of the pool and each of its threads
+AndGen::ThreadPoolStats AndGen::ThreadPool::GetStats() const
+{
+	ThreadPoolStats stats;
+	stats.threads.reserve(m_threads.size());
+	for (size_t i = 0; i < m_threads.size(); i++)
+	{
+		stats.threads.push_back(m_threads[i]->GetStats());
+	}
+	stats.external.jobsQueued	= m_externalJobsQueued.load(std::memory_order_relaxed);
+	stats.external.jobsExecuted	= m_externalJobsExecuted.load(std::memory_order_relaxed);
+
+	stats.pendingJobs		= PendingJobsCount();
+	stats.runningThreads	= RunningCount();
+	stats.idleThreads		= IdleCount();
+	stats.sleepingThreads	= SleepingCount();
+
+	return stats;
+}
+
+// Should the calling thread split its range within ParallelFor()?
+bool AndGen::ThreadPool::ShouldSplitRange() const
+{
+	PooledThread* currentThread = PooledThread::GetCurrent();
+	if (currentThread == nullptr || currentThread->GetThreadPool() != this)
+	{
+		return true;
+	}
+
+	return currentThread->m_localJobs.IsEmpty();
+}
+
+// Takes a job for the calling thread to execute
+bool AndGen::ThreadPool::TakeJob(AndGen::JobRecord*& record)
+{
+	// Threads within the pool take from their own queues first
+	PooledThread* currentThread = PooledThread::GetCurrent();
+	if (currentThread != nullptr && currentThread->GetThreadPool() == this)
+	{
+		return currentThread->FindJob(record);
+	}
+
+	if (m_threads.empty())
+	{
+		return false;
+	}
+
+	// Jobs with deadlines first
+	if (TakeDeadlineJob(record, false))
+	{
+		return true;
+	}
+
+	// Any other thread steals, starting from a different thread for each waiting thread,
+	// leaving deferrable jobs queued once the frame's budget is nearly used as the pool's threads do
+	static thread_local size_t firstVictim = std::hash<std::thread::id>()(std::this_thread::get_id());
+	firstVictim++;
+	JobPriority lowestPriority = LowestStartablePriority();
+	for (size_t i = 0; i < m_threads.size(); i++)
+	{
+		if (m_threads[(firstVictim + i) % m_threads.size()]->StealJob(record, lowestPriority))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// Pins each thread to a CPU, keeping the calling thread's core free where possible
+void AndGen::ThreadPool::PlaceThreads()
+{
+	const CpuTopology& topology		= CpuTopology::Get();
+	int currentCpu					= CpuTopology::GetCurrentCpu();
+	std::vector<unsigned int> cpus	= topology.SelectCpus(m_threads.size(), currentCpu);
+	if (cpus.empty())
+	{
+		return;
+	}
+
+	// Only reserve the calling thread's CPU if no thread was placed on its core
+	bool isCoreFree = currentCpu >= 0;
+	for (size_t i = 0; i < m_threads.size(); i++)
+	{
+		m_threads[i]->m_cpu = static_cast<int>(cpus[i]);
+		if (isCoreFree && topology.GetDistance(cpus[i], static_cast<unsigned int>(currentCpu)) <=
+			CpuTopology::Distance::SameCore)
+		{
+			isCoreFree = false;
+		}
+	}
+	m_reservedCpu = isCoreFree ? currentCpu : -1;
+}
+
+// Orders the threads each thread steals from, closest first
+void AndGen::ThreadPool::OrderVictims()
+{
+	const CpuTopology& topology = CpuTopology::Get();
 	for (size_t i = 0; i < m_threads.size(); i++)
 	{
-		m_threads[i]->WaitForQueue();
+		PooledThread& thief = *m_threads[i];
+
+		// Find how far each other thread is from this thread, all threads being equally far while unpinned
+		std::vector<std::pair<CpuTopology::Distance, unsigned int>> victims;
+		victims.reserve(m_threads.size() - 1);
+		for (size_t j = 0; j < m_threads.size(); j++)
+		{
+			if (j == i)
+			{
+				continue;
+			}
+
+			CpuTopology::Distance distance = CpuTopology::Distance::Remote;
+			if (thief.m_cpu >= 0 && m_threads[j]->m_cpu >= 0)
+			{
+				distance = topology.GetDistance(static_cast<unsigned int>(thief.m_cpu),
+					static_cast<unsigned int>(m_threads[j]->m_cpu));
+			}
+			victims.emplace_back(distance, static_cast<unsigned int>(j));
+		}
+		std::sort(victims.begin(), victims.end());
+
+		// Group victims which are equally far from this thread
+		thief.m_victims.clear();
+		thief.m_victimGroupEnds.clear();
+		for (size_t j = 0; j < victims.size(); j++)
+		{
+			if (j > 0 && victims[j].first != victims[j - 1].first)
+			{
+				thief.m_victimGroupEnds.push_back(j);
+			}
+			thief.m_victims.push_back(victims[j].second);
+		}
+		if (!victims.empty())
+		{
+			thief.m_victimGroupEnds.push_back(victims.size());
+		}
+	}
+}
+
+// Pushes a spawned job record onto the calling thread's deque, waking a thread to steal it if any are sleeping
+void AndGen::ThreadPool::SpawnRecord(AndGen::PooledThread* currentThread, AndGen::ThreadPool* threadPool,
+	AndGen::JobRecord* record)
+{
+	// Threads helping within Wait() have no deque, so queue with the pool being waited on
+	if (currentThread == nullptr)
+	{
+		threadPool->QueueRecord(record);
+		return;
+	}
+
+	ANDGEN_PROFILER_RECORD(Queue, record, 0);
+	if (threadPool != nullptr)
+	{
+		threadPool->CountQueued(currentThread, 1);
+	}
+	currentThread->m_localJobs.Push(record);
+	if (threadPool != nullptr)
+	{
+		threadPool->WakeIdleThreads(currentThread->GetIndex());
+	}
+}
+
+// Releases the counts of jobs discarded from the pool's queues without executing
+void AndGen::ThreadPool::DiscardedJobs(size_t count)
+{
+	m_discardedJobs.fetch_add(count, std::memory_order_release);
+	m_queuedJobsCounter.Decrement(static_cast<unsigned int>(count));
+}
+
+// Queues a job record to be executed before a deadline, waking a sleeping thread to take it
+void AndGen::ThreadPool::QueueDeadlineRecord(AndGen::JobRecord* record, std::chrono::steady_clock::time_point deadline)
+{
+	DeadlineRecord deadlineRecord = { std::chrono::duration_cast<std::chrono::nanoseconds>(
+		deadline.time_since_epoch()).count(), record };
+	ANDGEN_PROFILER_RECORD(Queue, record, 0);
+	CountQueued(PooledThread::GetCurrent(), 1);
+	{
+		std::scoped_lock<std::mutex> lock(m_deadlineMutex);
+		m_deadlineJobs.push_back(deadlineRecord);
+		std::push_heap(m_deadlineJobs.begin(), m_deadlineJobs.end(), std::greater<DeadlineRecord>());
+		m_nextDeadline.store(m_deadlineJobs.front().deadline, std::memory_order_relaxed);
+	}
+
+	// Order the job with counting sleeping threads, pairing with PooledThread::Sleep()
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (m_sleepingCount.load(std::memory_order_relaxed) == 0)
+	{
+		return;
+	}
+
+	for (size_t i = 0; i < m_threads.size(); i++)
+	{
+		if (m_threads[i]->WakeUp())
+		{
+			return;
+		}
+	}
+}
+
+// Takes the job with the earliest deadline
+bool AndGen::ThreadPool::TakeDeadlineJob(AndGen::JobRecord*& record, bool dueOnly)
+{
+	// Avoid locking when there's nothing to take, or the earliest job isn't due yet
+	std::int64_t dueBefore = dueOnly ? Now() + m_promoteWindow.load(std::memory_order_relaxed) : NoTime;
+	std::int64_t nextDeadline = m_nextDeadline.load(std::memory_order_relaxed);
+	if (nextDeadline == NoTime || nextDeadline > dueBefore)
+	{
+		return false;
+	}
+
+	std::scoped_lock<std::mutex> lock(m_deadlineMutex);
+	if (m_deadlineJobs.empty() || m_deadlineJobs.front().deadline > dueBefore)
+	{
+		return false;
+	}
+
+	std::pop_heap(m_deadlineJobs.begin(), m_deadlineJobs.end(), std::greater<DeadlineRecord>());
+	record = m_deadlineJobs.back().record;
+	m_deadlineJobs.pop_back();
+	m_nextDeadline.store(m_deadlineJobs.empty() ? NoTime : m_deadlineJobs.front().deadline,
+		std::memory_order_relaxed);
+
+	return true;
+}
+
+// Queues a job which has no dependencies left to execute
+void AndGen::ThreadPool::QueueReadyJob(std::shared_ptr<AndGen::Job> job)
+{
+	// Jobs queued with a deadline keep it once their dependencies complete
+	JobPriority priority							= job->m_priority;
+	std::chrono::steady_clock::time_point deadline	= job->m_deadline;
+	if (deadline != std::chrono::steady_clock::time_point::max())
+	{
+		QueueDeadlineRecord(JobRecord::Create(std::move(job)), deadline);
+		return;
+	}
+
+	QueueRecord(JobRecord::Create(std::move(job)), priority);
+}
+
+// Queues a job record with one of the pool's threads
+void AndGen::ThreadPool::QueueRecord(AndGen::JobRecord* record, AndGen::JobPriority priority)
+{
+	// Recorded before the record is visible to other threads, which may execute and recycle it
+	ANDGEN_PROFILER_RECORD(Queue, record, 0);
+
+	// Keep jobs queued by this pool's own threads on the calling thread,
+	// frame jobs are pushed onto its deque and any other priority onto its own queue's lanes
+	PooledThread* currentThread = PooledThread::GetCurrent();
+	CountQueued(currentThread, 1);
+	if (currentThread != nullptr && currentThread->GetThreadPool() == this)
+	{
+		if (priority == JobPriority::Frame)
+		{
+			currentThread->PushLocalJob(record);
+		}
+		else
+		{
+			currentThread->m_jobQueue.AddJob(record, priority);
+		}
+		WakeIdleThreads(currentThread->GetIndex());
+
+		return;
+	}
+
+	// Otherwise hand jobs to each thread in turn
+	size_t threadIndex = m_nextThread.fetch_add(1, std::memory_order_relaxed) % m_permanentCount;
+	m_threads[threadIndex]->QueueJob(record, priority);
+
+	// Allow an idle thread to steal the job if the selected thread is busy
+	if (m_threads[threadIndex]->GetStatus() == PooledThread::Status::ExecutingJobs)
+	{
+		WakeIdleThreads(static_cast<unsigned int>(threadIndex));
+	}
+}
+
+// Queues a batch of job records, split between the pool's threads
+void AndGen::ThreadPool::QueueRecords(AndGen::JobRecord* const* records, size_t count, AndGen::JobPriority priority)
+{
+	if (count == 0)
+	{
+		return;
+	}
+#if defined(ANDGEN_JOB_PROFILER)
+	for (size_t i = 0; i < count; i++)
+	{
+		JobProfiler::Record(JobProfiler::EventType::Queue, records[i]);
+	}
+#endif
+
+	// Keep jobs queued by this pool's own threads on the calling thread
+	PooledThread* currentThread = PooledThread::GetCurrent();
+	CountQueued(currentThread, count);
+	if (currentThread != nullptr && currentThread->GetThreadPool() == this)
+	{
+		if (priority == JobPriority::Frame)
+		{
+			for (size_t i = 0; i < count; i++)
+			{
+				currentThread->PushLocalJob(records[i]);
+			}
+		}
+		else
+		{
+			currentThread->m_jobQueue.AddJobs(records, count, priority);
+		}
+		WakeIdleThreads(currentThread->GetIndex(), count);
+
+		return;
+	}
+
+	// Otherwise split jobs into one contiguous batch per thread, starting with the next thread in turn
+	size_t batchCount	= std::min<size_t>(count, m_permanentCount);
+	size_t firstThread	= m_nextThread.fetch_add(batchCount, std::memory_order_relaxed);
+	size_t batchBegin	= 0;
+	for (size_t i = 0; i < batchCount; i++)
+	{
+		size_t batchSize = count / batchCount + (i < count % batchCount ? 1 : 0);
+		m_threads[(firstThread + i) % m_permanentCount]->QueueJobs(records + batchBegin, batchSize, priority);
+		batchBegin += batchSize;
+	}
+}
+
+// Wakes the first sleeping threads found after a given thread, allowing them to steal jobs
+void AndGen::ThreadPool::WakeIdleThreads(unsigned int busyThreadIndex, size_t count)
+{
+	// Order jobs queued before this with counting sleeping threads, pairing with PooledThread::Sleep()
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (m_sleepingCount.load(std::memory_order_relaxed) == 0)
+	{
+		return;
+	}
+
+	for (size_t i = 1; i < m_threads.size() && count > 0; i++)
+	{
+		if (m_threads[(busyThreadIndex + i) % m_threads.size()]->WakeUp())
+		{
+			count--;
+		}
+	}
+}
+
+// Counts job records queued, with the calling thread's counters if it's one of the pool's threads
+void AndGen::ThreadPool::CountQueued(AndGen::PooledThread* currentThread, size_t count)
+{
+	if (currentThread != nullptr && currentThread->GetThreadPool() == this)
+	{
+		PooledThread::Counters::Add(currentThread->m_counters.jobsQueued, count);
+	}
+	else
+	{
+		m_externalJobsQueued.fetch_add(count, std::memory_order_relaxed);
+	}
+}
+
+// Counts a job record beginning, with the calling thread's counters if it's one of the pool's threads
+void AndGen::ThreadPool::CountExecuted(AndGen::PooledThread* currentThread)
+{
+	if (currentThread != nullptr && currentThread->GetThreadPool() == this)
+	{
+		currentThread->CountJobExecuted();
+	}
+	else
+	{
+		m_externalJobsExecuted.fetch_add(1, std::memory_order_relaxed);
 	}
 }
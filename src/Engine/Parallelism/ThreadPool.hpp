@@ -3,14 +3,29 @@
 
 // STL includes
 #include <algorithm>
-#include <exception>
-#include <limits>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iterator>
 #include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 #include <vector>
 // AndGen includes
 #include <AndGen/Engine/Jobs/Job.hpp>
+#include <AndGen/Engine/Jobs/JobCounter.hpp>
+#include <AndGen/Engine/Jobs/JobLane.hpp>
+#include <AndGen/Engine/Jobs/JobPriority.hpp>
 #include <AndGen/Exceptions/NotImplementedException.hpp>
-#include "..\Parallelism\PooledThread.hpp"
+#include "../Jobs/JobRecord.hpp"
+#include "../Parallelism/CpuTopology.hpp"
+#include "../Parallelism/ElasticPolicy.hpp"
+#include "../Parallelism/FrameBudget.hpp"
+#include "../Parallelism/IdlePolicy.hpp"
+#include "../Parallelism/PooledThread.hpp"
+#include "../Parallelism/ThreadPoolStats.hpp"
 
 namespace AndGen
 {
@@ -20,11 +35,53 @@ namespace AndGen
 	class ThreadPool
 	{
 	public:
+		/// <summary>
+		/// How jobs are executed by the pool's threads
+		/// </summary>
+		enum class ExecutionMode
+		{
+			/// <summary>
+			/// Jobs execute directly on each thread's own stack. Waiting on a counter from within a job
+			/// executes other jobs on top of the waiting job, which can't resume until they complete.
+			/// </summary>
+			Threads,
+			/// <summary>
+			/// Jobs execute on pooled fibers. Waiting on a counter from within a job suspends its fiber,
+			/// and the thread executes other jobs until the counter completes and the fiber is resumed.
+			/// </summary>
+			Fibers
+		};
+
+		/// <summary>
+		/// How the pool's threads are placed on the system's CPUs
+		/// </summary>
+		enum class ThreadPlacement
+		{
+			/// <summary>
+			/// Threads are left for the operating system to place, and may migrate between CPUs
+			/// </summary>
+			Unpinned,
+			/// <summary>
+			/// Each thread is pinned to a CPU selected by <see cref="CpuTopology::SelectCpus"/>, keeping the
+			/// core of the thread constructing the pool free where possible. Threads steal from the threads
+			/// sharing the most cache with them first.
+			/// </summary>
+			Pinned
+		};
+
 		/// <summary>
 		/// Constructs a new thread pool with a specified amount of threads
 		/// </summary>
 		/// <param name="threadCount">Amount of threads to construct within the pool</param>
-		ThreadPool(unsigned int threadCount = GetIdealThreadCount());
+		/// <param name="executionMode">How jobs are executed by the pool's threads</param>
+		/// <param name="idlePolicy">How long the pool's threads look for jobs before sleeping</param>
+		/// <param name="placement">How the pool's threads are placed on the system's CPUs</param>
+		/// <param name="elasticPolicy">How the pool adds and retires threads as its load changes</param>
+		/// <param name="ioThreadCount">Amount of separate threads executing <see cref="JobLane::IO"/> jobs</param>
+		/// <exception cref="NotImplementedException">Thrown when fibers aren't supported on this platform</exception>
+		ThreadPool(unsigned int threadCount = GetIdealThreadCount(), ExecutionMode executionMode = ExecutionMode::Threads,
+			const IdlePolicy& idlePolicy = IdlePolicy(), ThreadPlacement placement = ThreadPlacement::Pinned,
+			const ElasticPolicy& elasticPolicy = ElasticPolicy::Fixed(), unsigned int ioThreadCount = 0);
 		ThreadPool(const ThreadPool&)				= delete;
 		ThreadPool& operator=(const ThreadPool&)	= delete;
 
@@ -39,104 +96,639 @@ namespace AndGen
 		/// </summary>
 		/// <remarks>
 		/// This function returns the ideal amount of threads within the thread pool
-		/// for the best performance. This is should be the same as the amount of cores
-		/// of the executing system minus 1, since the function considers the main thread as well.
+		/// for the best performance. This is the amount of physical cores available to the process
+		/// minus 1, since the function considers the main thread as well. SMT siblings aren't counted,
+		/// as threads sharing a core compete for its execution units and caches.
 		/// On some hardware configurations, this function may return a value of 0, in which case
 		/// the thread pool shouldn't be used, but rather just the main thread for executing jobs.
 		/// </remarks>
-		inline static unsigned int GetIdealThreadCount()
-		{
-			return std::max<unsigned int>(0, std::thread::hardware_concurrency() - 1);
-		}
+		static unsigned int GetIdealThreadCount();
 
 		/// <summary>
 		/// Adds a job to the thread pool to execute
 		/// </summary>
+		/// <remarks>
+		/// <para>Jobs queued from outside of the pool are distributed between threads in turn, while jobs queued
+		/// from within one of the pool's threads are pushed onto that thread's own work-stealing deque.
+		/// Threads without jobs of their own will steal jobs from other threads, so the initial placement
+		/// of a job doesn't determine which thread executes it.</para>
+		/// <para>Jobs with dependencies scheduled through <see cref="Job::Schedule"/> are held until all
+		/// of their dependencies have completed, and are then pushed onto the deque of the thread which
+		/// completed the last dependency. Jobs which have already been queued are ignored.</para>
+		/// <para>Only <see cref="JobPriority::Frame"/> jobs are pushed onto a thread's deque. Jobs of any other
+		/// priority are added to the priority lanes of a thread's queue, with critical jobs taken by threads
+		/// ahead of their own deque, and lower priorities taken once their deque is empty.</para>
+		/// <para><see cref="JobLane::IO"/> jobs are queued with the pool's separate I/O threads, or with its own
+		/// threads if it has none. Jobs depending on an I/O job are queued with the lane they were queued on
+		/// once it completes, so a compute job is handed straight to the compute threads.</para>
+		/// </remarks>
 		/// <param name="job">Job to enqueue</param>
+		/// <param name="counter">Counter to count the job with until it completes, if any</param>
+		/// <param name="priority">Priority of the job</param>
+		/// <param name="lane">Set of threads to execute the job</param>
 		/// <typeparam name="JobType">Type of job</typeparam>
+		/// <exception cref="std::logic_error">Thrown when the thread pool has no threads</exception>
 		template<class JobType>
-		void QueueJob(const std::shared_ptr<JobType> job)
+		void QueueJob(const std::shared_ptr<JobType>& job, JobCounter* counter = nullptr,
+			JobPriority priority = JobPriority::Frame, JobLane lane = JobLane::Compute)
 		{
-			// Find value of thread with least amount of jobs queued
-			size_t lowestQueueCount = std::numeric_limits<size_t>::max();
-			for (size_t i = 0; i < m_threads.size(); i++)
+			// Ignore if job is null
+			if (job == nullptr)
 			{
-				if (m_threads[i]->GetQueue().Count() < lowestQueueCount)
-				{
-					lowestQueueCount = m_threads[i]->GetQueue().Count();
-				}
+				return;
+			}
+
+			if (lane == JobLane::IO && m_ioPool != nullptr)
+			{
+				m_ioPool->QueueJob(job, counter, priority);
+				return;
+			}
+
+			if (m_threads.empty())
+			{
+				throw std::logic_error("Unable to enqueue job - thread pool has no threads");
 			}
 
-			// Queue with a thread which has the least amount of jobs queued
-			for (size_t i = 0; i < m_threads.size(); i++)
+			// Jobs with dependencies left are queued once their last dependency completes
+			if (!job->Internal_Queue(*this, counter, priority))
 			{
-				if (m_threads[i]->GetQueue().Count() <= lowestQueueCount)
+				return;
+			}
+
+			QueueReadyJob(std::static_pointer_cast<Job>(job));
+		}
+		/// <summary>
+		/// Adds a job to the thread pool to execute, with a given priority
+		/// </summary>
+		/// <param name="job">Job to enqueue</param>
+		/// <param name="priority">Priority of the job</param>
+		/// <typeparam name="JobType">Type of job</typeparam>
+		/// <exception cref="std::logic_error">Thrown when the thread pool has no threads</exception>
+		template<class JobType>
+		void QueueJob(const std::shared_ptr<JobType>& job, JobPriority priority)
+		{
+			QueueJob(job, nullptr, priority);
+		}
+		/// <summary>
+		/// Adds a function to the thread pool to execute
+		/// </summary>
+		/// <remarks>
+		/// The function is stored inline within a pooled job record, so queueing it doesn't allocate.
+		/// Functions must fit within <see cref="JobRecord::PayloadSize"/> bytes, which is checked at compile time.
+		/// </remarks>
+		/// <param name="function">Callable object taking no arguments, such as a lambda</param>
+		/// <param name="counter">Counter to count the function with until it completes, if any</param>
+		/// <param name="priority">Priority of the function</param>
+		/// <param name="lane">Set of threads to execute the function</param>
+		/// <typeparam name="Function">Type of callable object</typeparam>
+		/// <exception cref="std::logic_error">Thrown when the thread pool has no threads</exception>
+		template<class Function, class = std::enable_if_t<std::is_invocable<std::decay_t<Function>&>::value>>
+		void QueueJob(Function&& function, JobCounter* counter = nullptr, JobPriority priority = JobPriority::Frame,
+			JobLane lane = JobLane::Compute)
+		{
+			if (lane == JobLane::IO && m_ioPool != nullptr)
+			{
+				m_ioPool->QueueJob(std::forward<Function>(function), counter, priority);
+				return;
+			}
+
+			if (m_threads.empty())
+			{
+				throw std::logic_error("Unable to enqueue job - thread pool has no threads");
+			}
+
+			m_queuedJobsCounter.Increment();
+			if (counter != nullptr)
+			{
+				counter->Increment();
+			}
+
+			QueueRecord(JobRecord::Create(std::forward<Function>(function), counter), priority);
+		}
+		/// <summary>
+		/// Adds a function to the thread pool to execute, with a given priority
+		/// </summary>
+		/// <param name="function">Callable object taking no arguments, such as a lambda</param>
+		/// <param name="priority">Priority of the function</param>
+		/// <typeparam name="Function">Type of callable object</typeparam>
+		/// <exception cref="std::logic_error">Thrown when the thread pool has no threads</exception>
+		template<class Function, class = std::enable_if_t<std::is_invocable<std::decay_t<Function>&>::value>>
+		void QueueJob(Function&& function, JobPriority priority)
+		{
+			QueueJob(std::forward<Function>(function), nullptr, priority);
+		}
+		/// <summary>
+		/// Adds a function to the thread pool to execute, unless cancelled before it's taken by a thread
+		/// </summary>
+		/// <remarks>
+		/// Cancelled functions are skipped, but still counted as completed by the counter given.
+		/// The token is stored alongside the function, leaving 8 fewer bytes for the function's captures.
+		/// </remarks>
+		/// <param name="function">Callable object taking no arguments, such as a lambda</param>
+		/// <param name="token">Token cancelling the function, which must outlive it</param>
+		/// <param name="counter">Counter to count the function with until it completes, if any</param>
+		/// <param name="priority">Priority of the function</param>
+		/// <param name="lane">Set of threads to execute the function</param>
+		/// <typeparam name="Function">Type of callable object</typeparam>
+		/// <exception cref="std::logic_error">Thrown when the thread pool has no threads</exception>
+		template<class Function, class = std::enable_if_t<std::is_invocable<std::decay_t<Function>&>::value>>
+		void QueueJob(Function&& function, const CancellationToken& token, JobCounter* counter = nullptr,
+			JobPriority priority = JobPriority::Frame, JobLane lane = JobLane::Compute)
+		{
+			QueueJob([function = std::forward<Function>(function), token = &token]() mutable
+			{
+				if (!token->IsCancelled())
 				{
-					m_threads[i]->QueueJob(job);
-					return;
+					function();
 				}
+			}, counter, priority, lane);
+		}
+
+		/// <summary>
+		/// Adds a job to the thread pool to execute before a deadline
+		/// </summary>
+		/// <remarks>
+		/// <para>Jobs with deadlines are taken by the pool's threads earliest deadline first, after critical jobs
+		/// and ahead of jobs queued without a deadline. Once within the <see cref="FrameBudget::promoteWindow"/>
+		/// of its deadline, a job is also taken ahead of the jobs on a thread's own deque.</para>
+		/// <para>Deadlines only order work, jobs which miss their deadline are still executed. Jobs with deadlines
+		/// have no priority, as their deadline already orders them ahead of every priority but critical, and
+		/// they're never deferred once a frame's budget is nearly used.</para>
+		/// <para>Jobs with dependencies left are held until their last dependency completes, as with
+		/// <see cref="QueueJob"/>, and then keep their deadline. Jobs which have already been queued are
+		/// ignored. <see cref="JobLane::IO"/> jobs are queued with the pool's I/O threads, if it has any,
+		/// ordered against the other jobs with deadlines queued there.</para>
+		/// </remarks>
+		/// <param name="job">Job to enqueue</param>
+		/// <param name="deadline">Time by which the job should have completed</param>
+		/// <param name="counter">Counter to count the job with until it completes, if any</param>
+		/// <param name="lane">Set of threads to execute the job</param>
+		/// <typeparam name="JobType">Type of job</typeparam>
+		/// <exception cref="std::logic_error">Thrown when the thread pool has no threads</exception>
+		template<class JobType>
+		void QueueJob(const std::shared_ptr<JobType>& job, std::chrono::steady_clock::time_point deadline,
+			JobCounter* counter = nullptr, JobLane lane = JobLane::Compute)
+		{
+			// Ignore if job is null
+			if (job == nullptr)
+			{
+				return;
+			}
+
+			if (lane == JobLane::IO && m_ioPool != nullptr)
+			{
+				m_ioPool->QueueJob(job, deadline, counter);
+				return;
+			}
+
+			if (m_threads.empty())
+			{
+				throw std::logic_error("Unable to enqueue job - thread pool has no threads");
+			}
+
+			// Jobs with dependencies left are queued once their last dependency completes
+			if (!job->Internal_Queue(*this, counter, JobPriority::Frame, deadline))
+			{
+				return;
 			}
 
-			throw std::logic_error("Unknown logic error - unable to enqueue job");
+			QueueReadyJob(std::static_pointer_cast<Job>(job));
+		}
+		/// <summary>
+		/// Adds a function to the thread pool to execute before a deadline
+		/// </summary>
+		/// <remarks>
+		/// Functions are ordered by their deadline as jobs are, see <see cref="QueueJob"/>, so have no priority.
+		/// </remarks>
+		/// <param name="function">Callable object taking no arguments, such as a lambda</param>
+		/// <param name="deadline">Time by which the function should have completed</param>
+		/// <param name="counter">Counter to count the function with until it completes, if any</param>
+		/// <param name="lane">Set of threads to execute the function</param>
+		/// <typeparam name="Function">Type of callable object</typeparam>
+		/// <exception cref="std::logic_error">Thrown when the thread pool has no threads</exception>
+		template<class Function, class = std::enable_if_t<std::is_invocable<std::decay_t<Function>&>::value>>
+		void QueueJob(Function&& function, std::chrono::steady_clock::time_point deadline,
+			JobCounter* counter = nullptr, JobLane lane = JobLane::Compute)
+		{
+			if (lane == JobLane::IO && m_ioPool != nullptr)
+			{
+				m_ioPool->QueueJob(std::forward<Function>(function), deadline, counter);
+				return;
+			}
+
+			if (m_threads.empty())
+			{
+				throw std::logic_error("Unable to enqueue job - thread pool has no threads");
+			}
+
+			m_queuedJobsCounter.Increment();
+			if (counter != nullptr)
+			{
+				counter->Increment();
+			}
+
+			QueueDeadlineRecord(JobRecord::Create(std::forward<Function>(function), counter), deadline);
+		}
+
+		/// <summary>
+		/// Spawns a child job from within a job, onto the deque of the thread executing it
+		/// </summary>
+		/// <remarks>
+		/// <para>The child is pushed onto the calling thread's own work-stealing deque without locking, and is
+		/// executed by the pool owning that thread. The calling thread executes its newest children first,
+		/// while their parent's data is still in its cache, and other threads steal the oldest children.
+		/// This suits recursive divide and conquer jobs, which spawn children and then wait on them.</para>
+		/// <para>Jobs executed by a thread helping within <see cref="Wait"/> have no deque of their own,
+		/// so their children are queued with the pool being waited on instead.</para>
+		/// <para>Children are queued with <see cref="JobPriority::Frame"/> priority.</para>
+		/// </remarks>
+		/// <param name="function">Callable object taking no arguments, such as a lambda</param>
+		/// <param name="counter">Counter to count the child with until it completes, if any</param>
+		/// <typeparam name="Function">Type of callable object</typeparam>
+		/// <exception cref="std::logic_error">Thrown when not called from a job</exception>
+		template<class Function, class = std::enable_if_t<std::is_invocable<std::decay_t<Function>&>::value>>
+		static void Spawn(Function&& function, JobCounter* counter = nullptr)
+		{
+			PooledThread* currentThread	= PooledThread::GetCurrent();
+			ThreadPool* threadPool		= currentThread != nullptr ? currentThread->GetThreadPool() : s_helpingPool;
+			if (currentThread == nullptr && threadPool == nullptr)
+			{
+				throw std::logic_error("Unable to spawn job - not called from a job");
+			}
+
+			if (threadPool != nullptr)
+			{
+				threadPool->m_queuedJobsCounter.Increment();
+			}
+			if (counter != nullptr)
+			{
+				counter->Increment();
+			}
+
+			SpawnRecord(currentThread, threadPool, JobRecord::Create(std::forward<Function>(function), counter));
+		}
+		/// <summary>
+		/// Spawns a child job from within a job, onto the deque of the thread executing it
+		/// </summary>
+		/// <remarks>
+		/// Children with dependencies left are held until their last dependency completes, as with
+		/// <see cref="QueueJob"/>. Jobs which have already been queued are ignored.
+		/// </remarks>
+		/// <param name="job">Job to spawn</param>
+		/// <param name="counter">Counter to count the child with until it completes, if any</param>
+		/// <typeparam name="JobType">Type of job</typeparam>
+		/// <exception cref="std::logic_error">Thrown when not called from a job executed by a thread pool</exception>
+		template<class JobType>
+		static void Spawn(const std::shared_ptr<JobType>& job, JobCounter* counter = nullptr)
+		{
+			// Ignore if job is null
+			if (job == nullptr)
+			{
+				return;
+			}
+
+			PooledThread* currentThread	= PooledThread::GetCurrent();
+			ThreadPool* threadPool		= currentThread != nullptr ? currentThread->GetThreadPool() : s_helpingPool;
+			if (threadPool == nullptr)
+			{
+				throw std::logic_error("Unable to spawn job - not called from a job executed by a thread pool");
+			}
+
+			// Jobs with dependencies left are queued once their last dependency completes
+			if (!job->Internal_Queue(*threadPool, counter, JobPriority::Frame))
+			{
+				return;
+			}
+
+			SpawnRecord(currentThread, threadPool, JobRecord::Create(std::static_pointer_cast<Job>(job)));
 		}
 		
 		/// <summary>
 		/// Adds multiple jobs from a collection to the thread pool to execute
 		/// </summary>
+		/// <remarks>
+		/// Jobs ready to execute are split into one contiguous batch per thread, in a single pass. Each thread's
+		/// queue is locked once for its batch, and only threads given a batch are notified. Jobs queued from
+		/// within one of the pool's threads are pushed onto that thread's deque instead, waking as many idle
+		/// threads as there are jobs to steal.
+		/// </remarks>
 		/// <param name="beginItr">Begin iterator for collection</param>
 		/// <param name="endItr">End iterator for collection</param>
-		/// <typeparam name="JobType">Type of jobs</typeparam>
+		/// <param name="counter">Counter to count the jobs with until they complete, if any</param>
+		/// <param name="priority">Priority of the jobs</param>
+		/// <param name="lane">Set of threads to execute the jobs</param>
+		/// <typeparam name="Iterator">Type of iterator, over shared pointers to jobs</typeparam>
+		/// <exception cref="std::logic_error">Thrown when the thread pool has no threads</exception>
 		template<class Iterator>
-		void QueueJobs(const Iterator beginItr, const Iterator endItr)
+		void QueueJobs(const Iterator beginItr, const Iterator endItr, JobCounter* counter = nullptr,
+			JobPriority priority = JobPriority::Frame, JobLane lane = JobLane::Compute)
 		{
+			if (beginItr == endItr)
+			{
+				return;
+			}
+
+			if (lane == JobLane::IO && m_ioPool != nullptr)
+			{
+				m_ioPool->QueueJobs(beginItr, endItr, counter, priority);
+				return;
+			}
+
+			if (m_threads.empty())
+			{
+				throw std::logic_error("Unable to enqueue job - thread pool has no threads");
+			}
+
+			// Gather jobs which are ready to execute,
+			// jobs with dependencies left are queued once their last dependency completes
+			std::vector<JobRecord*> records;
+			if constexpr (std::is_base_of<std::forward_iterator_tag,
+				typename std::iterator_traits<Iterator>::iterator_category>::value)
+			{
+				records.reserve(static_cast<size_t>(std::distance(beginItr, endItr)));
+			}
 			for (Iterator i = beginItr; i != endItr; i++)
 			{
-				QueueJob(*i);
+				if (*i != nullptr && (*i)->Internal_Queue(*this, counter, priority))
+				{
+					records.push_back(JobRecord::Create(std::static_pointer_cast<Job>(*i)));
+				}
+			}
+
+			QueueRecords(records.data(), records.size(), priority);
+		}
+
+		/// <summary>
+		/// Executes a function for each index within a range, using the pool's threads
+		/// </summary>
+		/// <remarks>
+		/// <para>The range is split lazily: a thread processes its range in chunks of <paramref name="grainSize"/>
+		/// indices, and only splits off the upper half of what remains as a new job when its own deque is empty.
+		/// Chunk sizes therefore adapt to load, with few jobs queued when all threads are busy.</para>
+		/// <para>The calling thread takes part in the loop and returns once every index has been processed.
+		/// This may be called from within a job executing on one of the pool's threads.</para>
+		/// </remarks>
+		/// <param name="begin">First index within the range</param>
+		/// <param name="end">Index past the last index within the range</param>
+		/// <param name="grainSize">Least amount of indices processed by a job before it's split</param>
+		/// <param name="function">Function to execute, taking the index to process</param>
+		/// <typeparam name="Function">Type of function</typeparam>
+		/// <exception cref="std::logic_error">Thrown when the thread pool has no threads</exception>
+		template<class Function>
+		void ParallelFor(size_t begin, size_t end, size_t grainSize, const Function& function)
+		{
+			if (begin >= end)
+			{
+				return;
+			}
+
+			if (m_threads.empty())
+			{
+				throw std::logic_error("Unable to enqueue job - thread pool has no threads");
+			}
+
+			JobCounter counter;
+			Internal_ParallelFor(begin, end, std::max<size_t>(grainSize, 1), &function, &counter);
+			Wait(counter);
+		}
+
+		/// <summary>
+		/// Reduces a range of indices to a single value, using the pool's threads
+		/// </summary>
+		/// <remarks>
+		/// The range is divided into fixed chunks of <paramref name="grainSize"/> indices, which are reduced in
+		/// parallel and then combined in index order. The order in which values are combined therefore doesn't
+		/// depend on how jobs were scheduled, so results are identical between calls, even for operations
+		/// which aren't associative such as floating point addition.
+		/// </remarks>
+		/// <param name="begin">First index within the range</param>
+		/// <param name="end">Index past the last index within the range</param>
+		/// <param name="grainSize">Amount of indices reduced within each chunk</param>
+		/// <param name="identity">Value which leaves other values unchanged when combined</param>
+		/// <param name="map">Function taking an index, and returning its value</param>
+		/// <param name="combine">Function taking two values, and returning them combined</param>
+		/// <typeparam name="ValueType">Type of value reduced</typeparam>
+		/// <typeparam name="MapFunction">Type of function mapping indices to values</typeparam>
+		/// <typeparam name="CombineFunction">Type of function combining values</typeparam>
+		/// <returns>All values within the range combined, or the identity for an empty range</returns>
+		/// <exception cref="std::logic_error">Thrown when the thread pool has no threads</exception>
+		template<class ValueType, class MapFunction, class CombineFunction>
+		ValueType ParallelReduce(size_t begin, size_t end, size_t grainSize, const ValueType& identity,
+			const MapFunction& map, const CombineFunction& combine)
+		{
+			if (begin >= end)
+			{
+				return identity;
+			}
+
+			// Value of each chunk, as a distinct object on its own cache line, so chunks written in parallel
+			// share no memory, even for values packed together such as within a std::vector<bool>
+			struct alignas(64) PartialValue
+			{
+				ValueType value;
+			};
+
+			// Reduce each chunk in parallel
+			grainSize = std::max<size_t>(grainSize, 1);
+			std::vector<PartialValue> partialValues((end - begin + grainSize - 1) / grainSize, PartialValue{ identity });
+			ParallelFor(0, partialValues.size(), 1, [&](size_t chunk)
+			{
+				size_t chunkBegin	= begin + chunk * grainSize;
+				size_t chunkEnd		= std::min(end, chunkBegin + grainSize);
+
+				ValueType partialValue = identity;
+				for (size_t i = chunkBegin; i < chunkEnd; i++)
+				{
+					partialValue = combine(std::move(partialValue), map(i));
+				}
+				partialValues[chunk].value = std::move(partialValue);
+			});
+
+			// Combine chunks in order
+			ValueType value = identity;
+			for (size_t i = 0; i < partialValues.size(); i++)
+			{
+				value = combine(std::move(value), std::move(partialValues[i].value));
 			}
+
+			return value;
 		}
 
 		/// <summary>
-		/// Waits for threads to complete their current tasks and become idle
+		/// Waits for all jobs counted by a counter to complete
 		/// </summary>
+		/// <remarks>
+		/// Rather than blocking, the calling thread executes queued jobs from the pool until the counter
+		/// reaches zero. Once it finds nothing to execute, such as while the jobs counted are executing on
+		/// other threads or waiting on dependencies, it spins and yields as set by the pool's
+		/// <see cref="IdlePolicy"/>, then blocks until the last job counted completes. This may be called from
+		/// within a job executing on one of the pool's threads, in which case a pool in fiber mode suspends the
+		/// job instead, and a pool in thread mode only blocks briefly before looking for jobs again.
+		/// </remarks>
+		/// <param name="counter">Counter to wait on</param>
+		void Wait(const JobCounter& counter);
+
+		/// <summary>
+		/// Waits for all queued jobs to complete
+		/// </summary>
+		/// <remarks>
+		/// The calling thread executes queued jobs until all jobs queued with the pool,
+		/// including those waiting for dependencies and those on the I/O lane, have completed.
+		/// </remarks>
 		void WaitForThreads();
 
+		/// <summary>
+		/// How jobs are executed by the pool's threads
+		/// </summary>
+		inline ExecutionMode GetExecutionMode() const
+		{
+			return m_executionMode;
+		}
+
+		/// <summary>
+		/// How long the pool's threads look for jobs before sleeping
+		/// </summary>
+		inline const IdlePolicy& GetIdlePolicy() const
+		{
+			return m_idlePolicy;
+		}
+
+		/// <summary>
+		/// How the pool adds and retires threads as its load changes
+		/// </summary>
+		inline const ElasticPolicy& GetElasticPolicy() const
+		{
+			return m_elasticPolicy;
+		}
+
+		/// <summary>
+		/// How the pool's threads are placed on the system's CPUs
+		/// </summary>
+		inline ThreadPlacement GetPlacement() const
+		{
+			return m_placement;
+		}
+
+		/// <summary>
+		/// CPU kept free of the pool's threads for the thread which constructed the pool
+		/// </summary>
+		/// <returns>Identifier of the CPU, or -1 if the pool is unpinned or has a thread on every core</returns>
+		inline int GetReservedCpu() const
+		{
+			return m_reservedCpu;
+		}
+
+		/// <summary>
+		/// Pins the calling thread to the CPU reserved for it, keeping it off the cores of the pool's threads
+		/// </summary>
+		/// <remarks>
+		/// Intended to be called by the main thread after constructing the pool, since it may otherwise migrate
+		/// onto a core with one of the pool's threads.
+		/// </remarks>
+		/// <returns>True if the calling thread was pinned, otherwise false</returns>
+		bool PinToReservedCpu() const;
+
+		/// <summary>
+		/// Begins a new frame, with a budget for the time it may take
+		/// </summary>
+		/// <remarks>
+		/// <para>Jobs deferred by the previous frame are resumed, and once the frame has less than the budget's
+		/// <see cref="FrameBudget::deferMargin"/> left, the pool's threads stop starting
+		/// <see cref="JobPriority::Background"/> and <see cref="JobPriority::Idle"/> jobs until the next frame.</para>
+		/// <para>Threads outside of the pool waiting on a counter still execute deferred jobs, so waiting on
+		/// deferred work completes it, while the pool's own threads waiting on deferred work wait until the
+		/// next frame. The budget only applies to this pool's threads, not its I/O threads.</para>
+		/// </remarks>
+		/// <param name="budget">Time the frame may take, and how it's divided</param>
+		void BeginFrame(const FrameBudget& budget);
+
+		/// <summary>
+		/// Time the current frame began, or when the pool was constructed if no frame has begun
+		/// </summary>
+		inline std::chrono::steady_clock::time_point GetFrameStart() const
+		{
+			return std::chrono::steady_clock::time_point(
+				std::chrono::nanoseconds(m_frameStart.load(std::memory_order_relaxed)));
+		}
+
+		/// <summary>
+		/// Time elapsed since the current frame began
+		/// </summary>
+		inline std::chrono::nanoseconds FrameElapsed() const
+		{
+			return std::chrono::steady_clock::now() - GetFrameStart();
+		}
+
+		/// <summary>
+		/// Are deferrable jobs being held until the next frame, as the current frame's budget is nearly used?
+		/// </summary>
+		inline bool IsDeferring() const
+		{
+			std::int64_t deferAfter = m_deferAfter.load(std::memory_order_relaxed);
+			return deferAfter != NoTime && Now() >= deferAfter;
+		}
+
 		/// <summary>
 		/// The amount of threads within the pool
 		/// </summary>
-		inline unsigned int Size()
+		/// <remarks>
+		/// Elastic pools count the threads currently running, including temporary threads.
+		/// </remarks>
+		inline unsigned int Size() const
+		{
+			return m_activeCount.load(std::memory_order_acquire);
+		}
+
+		/// <summary>
+		/// Most threads the pool runs at once
+		/// </summary>
+		inline unsigned int MaxSize() const
 		{
 			return static_cast<unsigned int>(m_threads.size());
 		}
 
 		/// <summary>
-		/// The amount of Jobs currently queued to be processed
+		/// Amount of separate threads executing <see cref="JobLane::IO"/> jobs
 		/// </summary>
-		inline unsigned int PendingJobsCount() const
+		inline unsigned int IOSize() const
 		{
-			unsigned int pendingJobsCount = 0;
-			for (size_t i = 0; i < m_threads.size(); i++)
-			{
-				pendingJobsCount += static_cast<unsigned int>(m_threads[i]->GetQueue().Count());
-			}
+			return m_ioPool != nullptr ? m_ioPool->Size() : 0;
+		}
 
-			return pendingJobsCount;
+		/// <summary>
+		/// Amount of the pool's threads currently within a <see cref="BlockingRegion"/>
+		/// </summary>
+		inline unsigned int BlockingCount() const
+		{
+			return m_blockingCount.load(std::memory_order_acquire);
 		}
 
+		/// <summary>
+		/// The amount of Jobs currently queued to be processed
+		/// </summary>
+		/// <remarks>
+		/// Counted from the jobs each thread has queued and begun, without reading any thread's queues.
+		/// Jobs waiting for their dependencies aren't counted until they're released.
+		/// </remarks>
+		unsigned int PendingJobsCount() const;
+
 		/// <summary>
 		/// Returns the amount of threads currently executing a task
 		/// </summary>
 		inline unsigned int RunningCount() const
 		{
-			unsigned int runningCount = 0;
-			for (size_t i = 0; i < m_threads.size(); i++)
-			{
-				if (m_threads[i]->GetStatus() == PooledThread::Status::ExecutingJobs)
-				{
-					runningCount++;
-				}
-			}
+			return m_executingCount.load(std::memory_order_relaxed);
+		}
 
-			return runningCount;
+		/// <summary>
+		/// Amount of threads currently sleeping until woken for new jobs
+		/// </summary>
+		/// <remarks>
+		/// Idle threads which are still spinning aren't counted.
+		/// </remarks>
+		inline unsigned int SleepingCount() const
+		{
+			return m_sleepingCount.load(std::memory_order_acquire);
 		}
 
 		/// <summary>
@@ -144,20 +736,304 @@ namespace AndGen
 		/// </summary>
 		inline unsigned int IdleCount() const
 		{
-			unsigned int idleCount = 0;
-			for (size_t i = 0; i < m_threads.size(); i++)
+			unsigned int size			= Size();
+			unsigned int runningCount	= RunningCount();
+
+			return size > runningCount ? size - runningCount : 0;
+		}
+
+		/// <summary>
+		/// Snapshot of the counters of the pool and each of its threads, such as to report each frame
+		/// </summary>
+		/// <remarks>
+		/// Each thread keeps its own counters on their own cache lines, which are read without locking or
+		/// waiting on the threads. Counters of the pool's separate I/O threads are taken from their own pool.
+		/// </remarks>
+		ThreadPoolStats GetStats() const;
+
+	private:
+		friend class BlockingRegion;
+		friend class Job;
+		friend class PooledThread;
+
+		// How jobs are executed by the pool's threads
+		ExecutionMode m_executionMode;
+		// How long the pool's threads look for jobs before sleeping
+		IdlePolicy m_idlePolicy;
+		// How the pool's threads are placed on the system's CPUs
+		ThreadPlacement m_placement;
+		// CPU kept free for the thread which constructed the pool, if any
+		int m_reservedCpu;
+		// How the pool adds and retires threads as its load changes
+		ElasticPolicy m_elasticPolicy;
+		// Threads within the pool, including those of an elastic pool which aren't running
+		std::vector<std::unique_ptr<PooledThread>> m_threads;
+		// Amount of threads the pool keeps executing jobs, which is the amount it was constructed with
+		unsigned int m_targetCount;
+		// Amount of threads which never retire, and are given jobs queued from outside the pool
+		unsigned int m_permanentCount;
+		// Amount of threads running, and not retiring
+		std::atomic_uint m_activeCount;
+		// Amount of threads within a blocking region
+		std::atomic_uint m_blockingCount;
+		// Serialises starting threads of an elastic pool, and its destruction
+		std::mutex m_elasticMutex;
+		// Has the pool begun destruction, so no more threads may be started?
+		bool m_isDestroying;
+		// Separate threads executing I/O jobs, if any
+		std::unique_ptr<ThreadPool> m_ioPool;
+		// Index of the next thread to be given a job queued from outside the pool
+		std::atomic<size_t> m_nextThread;
+		// Counts all jobs queued with the pool which haven't completed
+		JobCounter m_queuedJobsCounter;
+		// Amount of threads sleeping, or about to sleep, so queueing jobs only looks for threads to wake when
+		// there are any, kept on its own cache line as it's read whenever jobs are queued
+		alignas(64) std::atomic_uint m_sleepingCount;
+		// Amount of threads executing jobs, kept on its own cache line as it's written as threads begin and
+		// run out of jobs
+		alignas(64) std::atomic_uint m_executingCount;
+		// Jobs queued by threads outside of the pool, and executed by them while waiting,
+		// as the pool's own threads count with their own counters
+		alignas(64) std::atomic<std::uint64_t> m_externalJobsQueued;
+		std::atomic<std::uint64_t> m_externalJobsExecuted;
+		// Jobs discarded from the pool's queues without executing, which are no longer pending
+		std::atomic<std::uint64_t> m_discardedJobs;
+
+		// Thread pool the current thread is helping to execute jobs for within Wait(), if it isn't a pooled thread
+		static thread_local ThreadPool* s_helpingPool;
+
+		/// <summary>
+		/// Job record queued with a deadline
+		/// </summary>
+		struct DeadlineRecord
+		{
+			// Time by which the job should have completed, in nanoseconds since the steady clock's epoch
+			std::int64_t deadline;
+			// Job record to execute
+			JobRecord* record;
+
+			/// <summary>
+			/// Is this record's deadline later than another's, ordering a heap earliest deadline first?
+			/// </summary>
+			inline bool operator>(const DeadlineRecord& other) const
+			{
+				return deadline > other.deadline;
+			}
+		};
+
+		// Represents no time, for deadlines and deferral which aren't set
+		static constexpr std::int64_t NoTime = INT64_MAX;
+		// Longest a pooled thread blocks within Wait() before looking for jobs again, as jobs queued on it
+		// while it waits don't wake it
+		static constexpr std::chrono::microseconds PooledWaitTimeout = std::chrono::microseconds(1000);
+
+		// Time the current frame began, in nanoseconds since the steady clock's epoch
+		std::atomic<std::int64_t> m_frameStart;
+		// Time after which deferrable jobs aren't started in the current frame, if any
+		std::atomic<std::int64_t> m_deferAfter;
+		// Time before its deadline at which a job is taken ahead of a thread's own deque
+		std::atomic<std::int64_t> m_promoteWindow;
+		// Earliest deadline of the jobs queued with deadlines, readable without locking
+		std::atomic<std::int64_t> m_nextDeadline;
+		// Jobs queued with deadlines, as a heap with the earliest deadline first
+		std::vector<DeadlineRecord> m_deadlineJobs;
+		// Mutex to ensure thread safety when accessing m_deadlineJobs
+		std::mutex m_deadlineMutex;
+
+		/// <summary>
+		/// Current time of the steady clock, in nanoseconds since its epoch
+		/// </summary>
+		static inline std::int64_t Now()
+		{
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now().time_since_epoch()).count();
+		}
+
+		/// <summary>
+		/// Lowest priority of job the pool's threads may start, excluding deferrable jobs while deferring
+		/// </summary>
+		inline JobPriority LowestStartablePriority() const
+		{
+			return IsDeferring() ? JobPriority::Frame : JobPriority::Idle;
+		}
+
+		/// <summary>
+		/// Queues a job record to be executed before a deadline, waking a sleeping thread to take it
+		/// </summary>
+		/// <param name="record">Job record, which the pool takes ownership of</param>
+		/// <param name="deadline">Time by which the job should have completed</param>
+		void QueueDeadlineRecord(JobRecord* record, std::chrono::steady_clock::time_point deadline);
+
+		/// <summary>
+		/// Takes the job with the earliest deadline
+		/// </summary>
+		/// <param name="record">Set to the job record taken, which the caller takes ownership of</param>
+		/// <param name="dueOnly">Only take the job if it's within the promotion window of its deadline</param>
+		/// <returns>True if a job was taken, otherwise false</returns>
+		bool TakeDeadlineJob(JobRecord*& record, bool dueOnly);
+
+		/// <summary>
+		/// Gets a thread within the pool by index
+		/// </summary>
+		inline PooledThread& GetThread(unsigned int index) const
+		{
+			return *m_threads[index];
+		}
+
+		/// <summary>
+		/// Pins each thread to a CPU, keeping the calling thread's core free where possible
+		/// </summary>
+		void PlaceThreads();
+
+		/// <summary>
+		/// Orders the threads each thread steals from, closest first
+		/// </summary>
+		/// <remarks>
+		/// Victims are grouped by their <see cref="CpuTopology::Distance"/> from the thief, so a thief tries every
+		/// thread sharing a cache with it before any thread further away. Unpinned threads have a single group.
+		/// </remarks>
+		void OrderVictims();
+
+		/// <summary>
+		/// May a thread retire, as a thread beyond the minimum of an elastic pool?
+		/// </summary>
+		inline bool CanRetire(unsigned int index) const
+		{
+			return index >= m_permanentCount;
+		}
+
+		/// <summary>
+		/// Counts a thread as retired, if the pool allows it
+		/// </summary>
+		/// <remarks>
+		/// Idle threads may always retire, while busy threads only retire while more threads are executing jobs
+		/// than the pool needs.
+		/// </remarks>
+		/// <param name="isIdle">Has the thread slept without jobs for the retire timeout?</param>
+		/// <returns>True if the thread should retire, otherwise false</returns>
+		bool RetireThread(bool isIdle);
+
+		/// <summary>
+		/// Counts a thread as blocking, starting a temporary thread to make up for it if needed
+		/// </summary>
+		void BeginBlocking();
+
+		/// <summary>
+		/// Counts a thread as no longer blocking
+		/// </summary>
+		void EndBlocking();
+
+		/// <summary>
+		/// Pushes a spawned job record onto the calling thread's deque, waking a thread to steal it if any are sleeping
+		/// </summary>
+		/// <param name="currentThread">Pooled thread executing the calling thread, if any</param>
+		/// <param name="threadPool">Thread pool executing the calling thread's job, if any</param>
+		/// <param name="record">Job record to push</param>
+		static void SpawnRecord(PooledThread* currentThread, ThreadPool* threadPool, JobRecord* record);
+		/// <summary>
+		/// Releases the counts of jobs discarded from the pool's queues without executing
+		/// </summary>
+		/// <param name="count">Amount of jobs discarded</param>
+		void DiscardedJobs(size_t count);
+
+		/// <summary>
+		/// Queues a job which has no dependencies left to execute
+		/// </summary>
+		/// <param name="job">Job to enqueue</param>
+		void QueueReadyJob(std::shared_ptr<Job> job);
+
+		/// <summary>
+		/// Queues a job record with one of the pool's threads
+		/// </summary>
+		/// <param name="record">Job record to enqueue</param>
+		/// <param name="priority">Priority of the job</param>
+		void QueueRecord(JobRecord* record, JobPriority priority = JobPriority::Frame);
+
+		/// <summary>
+		/// Processes a range of indices for <see cref="ParallelFor"/>, splitting it while other threads need jobs
+		/// </summary>
+		template<class Function>
+		void Internal_ParallelFor(size_t begin, size_t end, size_t grainSize, const Function* function,
+			JobCounter* counter)
+		{
+			while (end - begin > grainSize)
 			{
-				if (m_threads[i]->GetStatus() == PooledThread::Status::Idle)
+				// Split off upper half of the range as a job, for other threads to steal
+				if (ShouldSplitRange())
 				{
-					idleCount++;
+					size_t middle = begin + (end - begin) / 2;
+					QueueJob([this, middle, end, grainSize, function, counter]
+					{
+						Internal_ParallelFor(middle, end, grainSize, function, counter);
+					}, counter);
+
+					end = middle;
+					continue;
 				}
+
+				// Otherwise process a chunk before checking again
+				for (size_t i = begin; i < begin + grainSize; i++)
+				{
+					(*function)(i);
+				}
+				begin += grainSize;
 			}
 
-			return idleCount;
+			for (size_t i = begin; i < end; i++)
+			{
+				(*function)(i);
+			}
 		}
 
-	private:
-		std::vector<std::unique_ptr<PooledThread>> m_threads;
+		/// <summary>
+		/// Should the calling thread split its range within <see cref="ParallelFor"/>?
+		/// </summary>
+		/// <remarks>
+		/// Threads within the pool split once their deque is empty, as all of their jobs have been stolen.
+		/// Any other thread always splits, as it has no deque for other threads to steal from.
+		/// </remarks>
+		bool ShouldSplitRange() const;
+
+		/// <summary>
+		/// Queues a batch of job records, split between the pool's threads
+		/// </summary>
+		/// <param name="records">Job records to enqueue</param>
+		/// <param name="count">Amount of job records</param>
+		/// <param name="priority">Priority of the jobs</param>
+		void QueueRecords(JobRecord* const* records, size_t count, JobPriority priority);
+		/// <summary>
+		/// Counts job records queued, with the calling thread's counters if it's one of the pool's threads
+		/// </summary>
+		/// <param name="currentThread">Pooled thread executing the calling thread, if any</param>
+		/// <param name="count">Amount of job records queued</param>
+		void CountQueued(PooledThread* currentThread, size_t count);
+		/// <summary>
+		/// Counts a job record beginning, with the calling thread's counters if it's one of the pool's threads
+		/// </summary>
+		/// <param name="currentThread">Pooled thread executing the calling thread, if any</param>
+		void CountExecuted(PooledThread* currentThread);
+
+		/// <summary>
+		/// Takes a job for the calling thread to execute
+		/// </summary>
+		/// <remarks>
+		/// Threads within the pool take jobs from their own queues first, 
+		/// any other thread steals jobs from the pool's threads.
+		/// </remarks>
+		/// <param name="record">Set to the job record taken, if any</param>
+		/// <returns>True if a job was taken, otherwise false</returns>
+		bool TakeJob(JobRecord*& record);
+
+		/// <summary>
+		/// Wakes the first sleeping threads found after a given thread, allowing them to steal jobs
+		/// </summary>
+		/// <remarks>
+		/// Threads which are spinning find new jobs without being woken, so nothing is done while no
+		/// threads are sleeping, and each sleeping thread is only woken by a single call.
+		/// </remarks>
+		/// <param name="busyThreadIndex">Index of the thread which was given new jobs</param>
+		/// <param name="count">Most amount of threads to wake</param>
+		void WakeIdleThreads(unsigned int busyThreadIndex, size_t count = 1);
 	};
 }
 
@@ -0,0 +1,161 @@
+#ifndef THREADPOOLSTATS_H
+#define THREADPOOLSTATS_H
+
+// STL includes
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace AndGen
+{
+	/// <summary>
+	/// Counters of a single thread within a thread pool, since the pool was constructed
+	/// </summary>
+	/// <remarks>
+	/// Times are accumulated as the thread changes between executing, spinning and being parked,
+	/// so exclude the time since the thread's last change.
+	/// </remarks>
+	struct ThreadStats
+	{
+		/// <summary>
+		/// Amount of buckets within a queue depth histogram
+		/// </summary>
+		static constexpr size_t QueueDepthBucketCount = 8;
+
+		/// <summary>
+		/// Jobs begun by the thread, including those stolen and those executed while waiting
+		/// </summary>
+		std::uint64_t jobsExecuted	= 0;
+		/// <summary>
+		/// Jobs queued by the thread, including jobs spawned and jobs released by their dependencies
+		/// </summary>
+		std::uint64_t jobsQueued	= 0;
+		/// <summary>
+		/// Times the thread ran out of jobs of its own and looked for jobs to steal
+		/// </summary>
+		std::uint64_t stealAttempts	= 0;
+		/// <summary>
+		/// Jobs stolen from other threads
+		/// </summary>
+		std::uint64_t steals		= 0;
+
+		/// <summary>
+		/// Time spent executing jobs, and finding the next job between them
+		/// </summary>
+		std::chrono::nanoseconds executingTime	= std::chrono::nanoseconds::zero();
+		/// <summary>
+		/// Time spent spinning and yielding while looking for jobs
+		/// </summary>
+		std::chrono::nanoseconds spinningTime	= std::chrono::nanoseconds::zero();
+		/// <summary>
+		/// Time spent parked until woken for new jobs
+		/// </summary>
+		std::chrono::nanoseconds parkedTime		= std::chrono::nanoseconds::zero();
+
+		/// <summary>
+		/// Amount of jobs waiting on the thread each time it began a job
+		/// </summary>
+		/// <remarks>
+		/// The first bucket counts no jobs waiting, each following bucket counts twice as many as the last,
+		/// so bucket i counts from 2^(i-1) up to 2^i jobs, and the last bucket counts any more than that.
+		/// </remarks>
+		std::array<std::uint64_t, QueueDepthBucketCount> queueDepthHistogram = {};
+
+		/// <summary>
+		/// Bucket within the queue depth histogram counting an amount of jobs waiting
+		/// </summary>
+		/// <param name="depth">Amount of jobs waiting</param>
+		static inline size_t QueueDepthBucket(size_t depth)
+		{
+			size_t bucket = 0;
+			while (depth > 0 && bucket < QueueDepthBucketCount - 1)
+			{
+				depth >>= 1;
+				bucket++;
+			}
+
+			return bucket;
+		}
+
+		/// <summary>
+		/// Adds the counters of another thread to this thread's, such as to total a pool's threads
+		/// </summary>
+		/// <param name="other">Counters to add</param>
+		ThreadStats& operator+=(const ThreadStats& other)
+		{
+			jobsExecuted	+= other.jobsExecuted;
+			jobsQueued		+= other.jobsQueued;
+			stealAttempts	+= other.stealAttempts;
+			steals			+= other.steals;
+			executingTime	+= other.executingTime;
+			spinningTime	+= other.spinningTime;
+			parkedTime		+= other.parkedTime;
+			for (size_t i = 0; i < QueueDepthBucketCount; i++)
+			{
+				queueDepthHistogram[i] += other.queueDepthHistogram[i];
+			}
+
+			return *this;
+		}
+	};
+
+	/// <summary>
+	/// Snapshot of the counters of a thread pool, taken with <see cref="ThreadPool::GetStats"/>
+	/// </summary>
+	/// <remarks>
+	/// Each counter is read without locking while the pool's threads keep counting, so counters within a
+	/// snapshot may have been read a moment apart from each other.
+	/// </remarks>
+	struct ThreadPoolStats
+	{
+		/// <summary>
+		/// Counters of each of the pool's threads, by their index within the pool
+		/// </summary>
+		/// <remarks>
+		/// Elastic pools include each thread they may run, keeping the counters of threads which have retired.
+		/// </remarks>
+		std::vector<ThreadStats> threads;
+		/// <summary>
+		/// Jobs queued by threads outside of the pool, and executed by them while waiting
+		/// </summary>
+		/// <remarks>
+		/// Only <see cref="ThreadStats::jobsQueued"/> and <see cref="ThreadStats::jobsExecuted"/> are counted.
+		/// </remarks>
+		ThreadStats external;
+
+		/// <summary>
+		/// Jobs queued which haven't begun executing, excluding jobs waiting for their dependencies
+		/// </summary>
+		unsigned int pendingJobs	= 0;
+		/// <summary>
+		/// Threads executing jobs
+		/// </summary>
+		unsigned int runningThreads	= 0;
+		/// <summary>
+		/// Threads running but not executing jobs, whether spinning or sleeping
+		/// </summary>
+		unsigned int idleThreads	= 0;
+		/// <summary>
+		/// Threads sleeping until woken for new jobs
+		/// </summary>
+		unsigned int sleepingThreads	= 0;
+
+		/// <summary>
+		/// Counters of all of the pool's threads, and of threads outside of the pool, added together
+		/// </summary>
+		ThreadStats Total() const
+		{
+			ThreadStats total = external;
+			for (const ThreadStats& thread : threads)
+			{
+				total += thread;
+			}
+
+			return total;
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,220 @@
+#ifndef WORKSTEALINGDEQUE_H
+#define WORKSTEALINGDEQUE_H
+
+// STL includes
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace AndGen
+{
+	/// <summary>
+	/// Chase-Lev work-stealing deque
+	/// </summary>
+	/// <remarks>
+	/// <para>A single owning thread pushes and pops items from the bottom of the deque (LIFO),
+	/// while any number of other threads may steal items from the top of the deque (FIFO).</para>
+	/// <para>Based on "Correct and Efficient Work-Stealing for Weak Memory Models" (Lê et al. 2013).
+	/// The internal buffer grows when full, and previous buffers are kept alive until the deque
+	/// is destroyed, as thieves may still be reading from them.</para>
+	/// </remarks>
+	/// <typeparam name="ItemType">Type of item stored, which must be trivially copyable</typeparam>
+	template<class ItemType>
+	class WorkStealingDeque
+	{
+		static_assert(std::is_trivially_copyable<ItemType>::value,
+			"WorkStealingDeque items must be trivially copyable");
+
+	public:
+		/// <summary>
+		/// Constructs a new work-stealing deque
+		/// </summary>
+		/// <param name="capacity">Initial capacity of the deque, rounded up to a power of two</param>
+		explicit WorkStealingDeque(size_t capacity = 256) : m_top(0), m_bottom(0)
+		{
+			size_t roundedCapacity = 1;
+			while (roundedCapacity < capacity)
+			{
+				roundedCapacity <<= 1;
+			}
+
+			m_buffers.push_back(std::make_unique<Buffer>(roundedCapacity));
+			m_buffer.store(m_buffers.back().get(), std::memory_order_relaxed);
+		}
+		WorkStealingDeque(const WorkStealingDeque&)				= delete;
+		WorkStealingDeque& operator=(const WorkStealingDeque&)	= delete;
+		/// <summary>
+		/// Destroys this deque, and all of its internal buffers
+		/// </summary>
+		~WorkStealingDeque() = default;
+
+		/// <summary>
+		/// Pushes an item onto the bottom of the deque
+		/// </summary>
+		/// <remarks>
+		/// Must only be called by the thread owning this deque
+		/// </remarks>
+		/// <param name="item">Item to push</param>
+		void Push(ItemType item)
+		{
+			std::int64_t bottom	= m_bottom.load(std::memory_order_relaxed);
+			std::int64_t top	= m_top.load(std::memory_order_acquire);
+			Buffer* buffer		= m_buffer.load(std::memory_order_relaxed);
+
+			// Grow buffer if full
+			if (bottom - top > static_cast<std::int64_t>(buffer->Capacity()) - 1)
+			{
+				buffer = Grow(buffer, top, bottom);
+			}
+
+			// Publish item to thieves, which acquire bottom before loading it
+			buffer->Store(bottom, item);
+			m_bottom.store(bottom + 1, std::memory_order_release);
+		}
+
+		/// <summary>
+		/// Pops an item from the bottom of the deque
+		/// </summary>
+		/// <remarks>
+		/// Must only be called by the thread owning this deque
+		/// </remarks>
+		/// <param name="item">Set to the popped item, if successful</param>
+		/// <returns>True if an item was popped, otherwise false if the deque was empty</returns>
+		bool Pop(ItemType& item)
+		{
+			std::int64_t bottom	= m_bottom.load(std::memory_order_relaxed) - 1;
+			Buffer* buffer		= m_buffer.load(std::memory_order_relaxed);
+			m_bottom.store(bottom, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			std::int64_t top	= m_top.load(std::memory_order_relaxed);
+
+			// Deque was empty, restore bottom
+			if (top > bottom)
+			{
+				m_bottom.store(bottom + 1, std::memory_order_relaxed);
+				return false;
+			}
+
+			item = buffer->Load(bottom);
+			if (top == bottom)
+			{
+				// Last item in the deque, race thieves for it
+				bool won = m_top.compare_exchange_strong(top, top + 1,
+					std::memory_order_seq_cst, std::memory_order_relaxed);
+				m_bottom.store(bottom + 1, std::memory_order_relaxed);
+
+				return won;
+			}
+
+			return true;
+		}
+
+		/// <summary>
+		/// Steals an item from the top of the deque
+		/// </summary>
+		/// <remarks>
+		/// May be called from any thread
+		/// </remarks>
+		/// <param name="item">Set to the stolen item, if successful</param>
+		/// <returns>
+		/// True if an item was stolen, otherwise false if the deque was empty
+		/// or another thread won the race for the item
+		/// </returns>
+		bool Steal(ItemType& item)
+		{
+			std::int64_t top	= m_top.load(std::memory_order_acquire);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			std::int64_t bottom	= m_bottom.load(std::memory_order_acquire);
+
+			if (top >= bottom)
+			{
+				return false;
+			}
+
+			Buffer* buffer	= m_buffer.load(std::memory_order_acquire);
+			item			= buffer->Load(top);
+
+			return m_top.compare_exchange_strong(top, top + 1,
+				std::memory_order_seq_cst, std::memory_order_relaxed);
+		}
+
+		/// <summary>
+		/// Approximate amount of items within the deque
+		/// </summary>
+		inline size_t Count() const
+		{
+			std::int64_t bottom	= m_bottom.load(std::memory_order_relaxed);
+			std::int64_t top	= m_top.load(std::memory_order_relaxed);
+
+			return bottom > top ? static_cast<size_t>(bottom - top) : 0;
+		}
+
+		/// <summary>
+		/// Is the deque (approximately) empty?
+		/// </summary>
+		inline bool IsEmpty() const
+		{
+			return Count() == 0;
+		}
+
+	private:
+		/// <summary>
+		/// Circular buffer of items
+		/// </summary>
+		class Buffer
+		{
+		public:
+			explicit Buffer(size_t capacity) : m_mask(capacity - 1), m_items(capacity) {}
+
+			inline size_t Capacity() const
+			{
+				return m_items.size();
+			}
+
+			inline ItemType Load(std::int64_t index) const
+			{
+				return m_items[static_cast<size_t>(index) & m_mask].load(std::memory_order_relaxed);
+			}
+
+			inline void Store(std::int64_t index, ItemType item)
+			{
+				m_items[static_cast<size_t>(index) & m_mask].store(item, std::memory_order_relaxed);
+			}
+
+		private:
+			// Mask used to wrap indices into the buffer
+			size_t m_mask;
+			// Storage of items
+			std::vector<std::atomic<ItemType>> m_items;
+		};
+
+		// Index of the next item to be stolen
+		alignas(64) std::atomic<std::int64_t> m_top;
+		// Index of the next free slot for the owning thread
+		alignas(64) std::atomic<std::int64_t> m_bottom;
+		// Current buffer
+		alignas(64) std::atomic<Buffer*> m_buffer;
+		// All buffers allocated by this deque, kept alive for any thieves still reading from them
+		std::vector<std::unique_ptr<Buffer>> m_buffers;
+
+		// Replaces the current buffer with one twice the size
+		Buffer* Grow(Buffer* buffer, std::int64_t top, std::int64_t bottom)
+		{
+			m_buffers.push_back(std::make_unique<Buffer>(buffer->Capacity() * 2));
+			Buffer* newBuffer = m_buffers.back().get();
+
+			for (std::int64_t i = top; i < bottom; i++)
+			{
+				newBuffer->Store(i, buffer->Load(i));
+			}
+
+			m_buffer.store(newBuffer, std::memory_order_release);
+			return newBuffer;
+		}
+	};
+}
+
+#endif
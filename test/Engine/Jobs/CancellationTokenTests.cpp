@@ -0,0 +1,41 @@
+#include <AndGen/Engine/Jobs/CancellationToken.hpp>
+
+// Google Test includes
+#include <gtest/gtest.h>
+
+namespace AndGen::Tests
+{
+	// Normal usage of Cancel() and Reset()
+	TEST(CancellationTokenTests, Cancel)
+	{
+		CancellationToken token;
+		ASSERT_FALSE(token.IsCancelled());
+
+		token.Cancel();
+		ASSERT_TRUE(token.IsCancelled());
+
+		// Ensure token can be reused once reset
+		token.Reset();
+		ASSERT_FALSE(token.IsCancelled());
+	}
+
+	// IsCancelled() with a parent token
+	TEST(CancellationTokenTests, IsCancelled_Parent)
+	{
+		CancellationToken parent;
+		CancellationToken child(&parent);
+		CancellationToken sibling(&parent);
+
+		// Ensure cancelling a child doesn't cancel its parent or siblings
+		child.Cancel();
+		ASSERT_TRUE(child.IsCancelled());
+		ASSERT_FALSE(parent.IsCancelled());
+		ASSERT_FALSE(sibling.IsCancelled());
+
+		// Ensure cancelling the parent cancels every child
+		child.Reset();
+		parent.Cancel();
+		ASSERT_TRUE(child.IsCancelled());
+		ASSERT_TRUE(sibling.IsCancelled());
+	}
+}
@@ -0,0 +1,134 @@
+#include <Engine/Jobs/HardwareCounters.hpp>
+
+// STL includes
+#include <algorithm>
+#include <optional>
+#include <vector>
+// Google Test includes
+#include <gtest/gtest.h>
+
+namespace AndGen::Tests
+{
+	// Finds the totals of a type of job, or returns empty totals if it wasn't sampled
+	static HardwareCounterTotals FindTotals(const std::vector<HardwareCounters::JobTypeTotals>& jobTotals,
+		const JobName* name)
+	{
+		auto found = std::find_if(jobTotals.begin(), jobTotals.end(),
+			[name](const HardwareCounters::JobTypeTotals& job) { return job.name == name; });
+		return found != jobTotals.end() ? found->totals : HardwareCounterTotals();
+	}
+
+	// Normal usage of InstructionsPerCycle() and adding totals
+	TEST(HardwareCountersTests, Totals)
+	{
+		HardwareCounterTotals totals;
+		ASSERT_EQ(totals.InstructionsPerCycle(), 0.0);
+
+		HardwareCounterTotals job;
+		job.jobs			= 1;
+		job.cycles			= 200;
+		job.instructions	= 300;
+		job.branchMisses	= 4;
+		totals += job;
+		totals += job;
+
+		ASSERT_EQ(totals.jobs, 2);
+		ASSERT_EQ(totals.cycles, 400);
+		ASSERT_EQ(totals.branchMisses, 8);
+		ASSERT_DOUBLE_EQ(totals.InstructionsPerCycle(), 1.5);
+	}
+
+	// JobScope doesn't sample jobs while sampling is disabled
+	TEST(HardwareCountersTests, JobScope_Disabled)
+	{
+		const JobName* name = ANDGEN_JOB_NAME("Disabled job");
+		HardwareCounters::Disable();
+		{
+			HardwareCounters::JobScope scope(name);
+		}
+
+		ASSERT_EQ(FindTotals(HardwareCounters::GetJobTotals(), name).jobs, 0);
+	}
+
+	// Normal usage of JobScope, totalling nested jobs by name
+	TEST(HardwareCountersTests, JobScope)
+	{
+		if (!HardwareCounters::IsAvailable())
+		{
+			GTEST_SKIP() << "Hardware counters can't be opened on this system";
+		}
+
+		const JobName* outerName = ANDGEN_JOB_NAME("Outer job");
+		const JobName* innerName = ANDGEN_JOB_NAME("Inner job");
+		HardwareCounters::ResetJobTotals();
+		HardwareCounters::Enable();
+		{
+			HardwareCounters::JobScope outer(outerName);
+			volatile int sum = 0;
+			for (int i = 0; i < 3; i++)
+			{
+				HardwareCounters::JobScope inner(innerName);
+				for (int j = 0; j < 10000; j++)
+				{
+					sum = sum + j;
+				}
+			}
+		}
+		HardwareCounters::Disable();
+
+		std::vector<HardwareCounters::JobTypeTotals> jobTotals = HardwareCounters::GetJobTotals();
+		HardwareCounterTotals outer = FindTotals(jobTotals, outerName);
+		HardwareCounterTotals inner = FindTotals(jobTotals, innerName);
+
+		// Ensure each job was counted, with the outer job including its inner jobs
+		ASSERT_EQ(outer.jobs, 1);
+		ASSERT_EQ(inner.jobs, 3);
+		ASSERT_GT(inner.cycles, 0);
+		ASSERT_GE(outer.cycles, inner.cycles);
+
+		// Ensure totals are cleared once reset
+		HardwareCounters::ResetJobTotals();
+		ASSERT_EQ(FindTotals(HardwareCounters::GetJobTotals(), innerName).jobs, 0);
+	}
+
+	// JobScope with jobs ending in a different order to how they began, as jobs on fibers may
+	TEST(HardwareCountersTests, JobScope_Interleaved)
+	{
+		if (!HardwareCounters::IsAvailable())
+		{
+			GTEST_SKIP() << "Hardware counters can't be opened on this system";
+		}
+
+		const JobName* firstName	= ANDGEN_JOB_NAME("First job");
+		const JobName* secondName	= ANDGEN_JOB_NAME("Second job");
+		HardwareCounters::ResetJobTotals();
+		HardwareCounters::Enable();
+		{
+			// Begin the first job, doing most of the work before the second job begins
+			volatile int sum = 0;
+			std::optional<HardwareCounters::JobScope> first(std::in_place, firstName);
+			for (int i = 0; i < 100000; i++)
+			{
+				sum = sum + i;
+			}
+
+			// End the first job before the second
+			std::optional<HardwareCounters::JobScope> second(std::in_place, secondName);
+			for (int i = 0; i < 1000; i++)
+			{
+				sum = sum + i;
+			}
+			first.reset();
+			second.reset();
+		}
+		HardwareCounters::Disable();
+
+		// Ensure each job was counted from its own beginning
+		std::vector<HardwareCounters::JobTypeTotals> jobTotals = HardwareCounters::GetJobTotals();
+		HardwareCounterTotals first		= FindTotals(jobTotals, firstName);
+		HardwareCounterTotals second	= FindTotals(jobTotals, secondName);
+		ASSERT_EQ(first.jobs, 1);
+		ASSERT_EQ(second.jobs, 1);
+		ASSERT_GT(first.cycles, second.cycles);
+	}
+}
@@ -0,0 +1,62 @@
+#include <AndGen/Engine/Jobs/JobCounter.hpp>
+
+// STL includes
+#include <thread>
+// Google Test includes
+#include <gtest/gtest.h>
+
+namespace AndGen::Tests
+{
+	// Normal usage of Increment() and Decrement()
+	TEST(JobCounterTests, IncrementDecrement)
+	{
+		JobCounter counter;
+		// Ensure counter has no jobs on creation
+		ASSERT_EQ(counter.Count(), 0);
+		ASSERT_TRUE(counter.IsComplete());
+
+		// Count queued jobs
+		counter.Increment();
+		counter.Increment(2);
+		ASSERT_EQ(counter.Count(), 3);
+		ASSERT_FALSE(counter.IsComplete());
+
+		// Count completed jobs
+		counter.Decrement();
+		counter.Decrement();
+		ASSERT_FALSE(counter.IsComplete());
+		counter.Decrement();
+		ASSERT_TRUE(counter.IsComplete());
+	}
+
+	// Decrement() with multiple threads
+	TEST(JobCounterTests, Decrement_Threaded)
+	{
+		JobCounter counter;
+		counter.Increment(2000);
+
+		// Decrement counter from multiple threads
+		auto functor = [&counter]
+		{
+			for (size_t i = 0; i < 1000; i++)
+			{
+				counter.Decrement();
+			}
+		};
+		std::thread firstThread(functor);
+		std::thread secondThread(functor);
+
+		// Wait for threads to complete
+		if (firstThread.joinable())
+		{
+			firstThread.join();
+		}
+		if (secondThread.joinable())
+		{
+			secondThread.join();
+		}
+
+		// Ensure all decrements were counted
+		ASSERT_TRUE(counter.IsComplete());
+	}
+}
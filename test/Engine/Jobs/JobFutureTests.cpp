@@ -0,0 +1,175 @@
+#include <Engine/Jobs/JobFuture.hpp>
+
+// STL includes
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+// AndGen includes
+#include <AndGen/Engine/Jobs/CancellationToken.hpp>
+#include <Engine/Jobs/TaskFrameAllocator.hpp>
+#include <Engine/Parallelism/Latch.hpp>
+#include <Engine/Parallelism/ThreadPool.hpp>
+// Google Test includes
+#include <gtest/gtest.h>
+
+namespace AndGen::Tests
+{
+	class SquareJob : public ResultJob<int>
+	{
+	public:
+		explicit SquareJob(int value) : ResultJob<int>(), value(value) {}
+
+		int value;
+
+	protected:
+		virtual int Compute() override
+		{
+			return value * value;
+		}
+	};
+
+	// Normal usage of Get()
+	TEST(JobFutureTests, Get)
+	{
+		ThreadPool threadPool(2);
+
+		// Queue a function and a job, each producing a value
+		JobFuture future(threadPool, [] { return std::string("result"); });
+		JobFuture<int> jobFuture(threadPool, std::make_shared<SquareJob>(7));
+
+		// Ensure values are produced
+		ASSERT_EQ(future.Get(), "result");
+		ASSERT_TRUE(future.IsReady());
+		ASSERT_EQ(jobFuture.Get(), 49);
+		ASSERT_TRUE(jobFuture.GetJob()->HasResult());
+	}
+
+	// Get() executes the job on the waiting thread when the pool's threads are busy
+	TEST(JobFutureTests, Get_ExecutesOnWaitingThread)
+	{
+		ThreadPool threadPool(1);
+
+		// Block the pool's only thread
+		Latch blockedLatch(1);
+		Latch releaseLatch(1);
+		threadPool.QueueJob([&blockedLatch, &releaseLatch]
+		{
+			blockedLatch.CountDown();
+			releaseLatch.Wait();
+		});
+		blockedLatch.Wait();
+
+		// Ensure the waiting thread executes the job itself
+		std::thread::id waitingThread = std::this_thread::get_id();
+		JobFuture future(threadPool, [] { return std::this_thread::get_id(); });
+		ASSERT_EQ(future.Get(), waitingThread);
+
+		releaseLatch.CountDown();
+		threadPool.WaitForThreads();
+	}
+
+	// Normal usage of Then()
+	TEST(JobFutureTests, Then)
+	{
+		ThreadPool threadPool(2);
+
+		// Chain continuations, each using the previous value
+		JobFuture future(threadPool, [] { return 2; });
+		JobFuture<int> squared		= future.Then([](int& value) { return value * value; });
+		JobFuture<std::string> text	= squared.Then([](int& value) { return std::to_string(value); });
+
+		// Ensure each continuation was given the previous value
+		ASSERT_EQ(text.Get(), "4");
+		ASSERT_EQ(squared.Get(), 4);
+		ASSERT_EQ(future.Get(), 2);
+
+		// Ensure continuations of completed futures are still executed
+		ASSERT_EQ(future.Then([](int& value) { return value + 1; }).Get(), 3);
+	}
+
+	// Then() with continuations returning nothing
+	TEST(JobFutureTests, Then_Void)
+	{
+		ThreadPool threadPool(2);
+
+		// Continue a value with a function returning nothing, then continue that
+		std::atomic_int storedValue(0);
+		JobFuture future(threadPool, [] { return 5; });
+		JobFuture<void> stored		= future.Then([&storedValue](int& value) { storedValue = value; });
+		JobFuture<int> continued	= stored.Then([&storedValue] { return storedValue + 1; });
+
+		// Ensure each continuation executed in order
+		ASSERT_EQ(continued.Get(), 6);
+		stored.Get();
+		ASSERT_TRUE(stored.IsReady());
+		ASSERT_EQ(storedValue, 5);
+
+		// Ensure functions returning nothing can be queued directly
+		std::atomic_bool isExecuted(false);
+		JobFuture function(threadPool, [&isExecuted] { isExecuted = true; });
+		function.Get();
+		ASSERT_TRUE(isExecuted);
+		ASSERT_TRUE(function.GetJob()->HasResult());
+	}
+
+	// Futures and their continuations are allocated from the recycled pools, rather than the heap
+	TEST(JobFutureTests, Then_Allocations)
+	{
+		ThreadPool threadPool(2);
+		auto chain = [&threadPool](int value)
+		{
+			JobFuture future(threadPool, [value] { return value; });
+			return future.Then([](int& result) { return result * 2; }).Get();
+		};
+
+		// Warm up the pools of every thread
+		for (int i = 0; i < 1000; i++)
+		{
+			ASSERT_EQ(chain(i), i * 2);
+		}
+
+		// Count allocations made by this thread, while queueing, waiting and helping to execute jobs
+		constexpr int chainCount	= 1000;
+		size_t pooledCount			= TaskFrameAllocator::PooledAllocationsCount();
+		size_t heapCount			= TaskFrameAllocator::HeapAllocationsCount();
+		int total = 0;
+		for (int i = 0; i < chainCount; i++)
+		{
+			total += chain(1);
+		}
+		pooledCount	= TaskFrameAllocator::PooledAllocationsCount() - pooledCount;
+		heapCount	= TaskFrameAllocator::HeapAllocationsCount() - heapCount;
+
+		// Ensure each job, continuation and node linking them was pooled, with only the occasional chunk
+		// allocated from the heap
+		ASSERT_EQ(total, chainCount * 2);
+		ASSERT_GE(pooledCount, static_cast<size_t>(chainCount * 3));
+		ASSERT_LT(heapCount, static_cast<size_t>(chainCount / 10));
+	}
+
+	// Then() on a cancelled job
+	TEST(JobFutureTests, Then_Cancelled)
+	{
+		ThreadPool threadPool(2);
+		CancellationToken token;
+		token.Cancel();
+
+		// Queue a cancelled job, with a continuation
+		std::shared_ptr<SquareJob> job = std::make_shared<SquareJob>(3);
+		job->SetCancellationToken(&token);
+		JobFuture<int> future(threadPool, job);
+		JobFuture<int> continuation = future.Then([](int& value) { return value + 1; });
+
+		JobFuture<void> voidContinuation = future.Then([](int&) {});
+
+		// Ensure none produce a value, but all complete
+		ASSERT_THROW(voidContinuation.Get(), std::logic_error);
+		ASSERT_TRUE(voidContinuation.IsReady());
+		ASSERT_THROW(continuation.Get(), std::logic_error);
+		ASSERT_THROW(future.Get(), std::logic_error);
+		ASSERT_TRUE(future.IsReady());
+		ASSERT_TRUE(continuation.IsReady());
+	}
+}
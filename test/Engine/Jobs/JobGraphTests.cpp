@@ -0,0 +1,210 @@
+#include <Engine/Jobs/JobGraph.hpp>
+
+// STL includes
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+// AndGen includes
+#include <Engine/Parallelism/ThreadPool.hpp>
+// Google Test includes
+#include <gtest/gtest.h>
+
+namespace AndGen::Tests
+{
+	// Normal usage of Run()
+	TEST(JobGraphTests, Run)
+	{
+		ThreadPool threadPool(4);
+		JobGraph graph;
+		std::mutex orderMutex;
+		std::vector<JobGraph::NodeId> order;
+
+		// Build diamond graph, with two nodes between the first and last
+		std::vector<JobGraph::NodeId> nodes;
+		for (size_t i = 0; i < 4; i++)
+		{
+			nodes.push_back(graph.AddNode([&orderMutex, &order, i]
+			{
+				std::scoped_lock<std::mutex> lock(orderMutex);
+				order.push_back(i);
+			}));
+		}
+		graph.AddEdge(nodes[0], nodes[1]);
+		graph.AddEdge(nodes[0], nodes[2]);
+		graph.AddEdge(nodes[1], nodes[3]);
+		graph.AddEdge(nodes[2], nodes[3]);
+
+		// Ensure every node executed once, after its dependencies
+		graph.Run(threadPool);
+		ASSERT_TRUE(graph.IsComplete());
+		ASSERT_EQ(order.size(), 4);
+		ASSERT_EQ(order.front(), 0);
+		ASSERT_EQ(order.back(), 3);
+	}
+
+	// Destroying a graph after the thread pool it last executed with
+	TEST(JobGraphTests, Destroy_AfterThreadPool)
+	{
+		std::unique_ptr<JobGraph> graph = std::make_unique<JobGraph>();
+		std::atomic<int> executedCount = 0;
+		graph->AddNode([&executedCount] { executedCount++; });
+
+		// Execute graph, then destroy the thread pool before the graph
+		std::unique_ptr<ThreadPool> threadPool = std::make_unique<ThreadPool>(2);
+		graph->Run(*threadPool);
+		threadPool.reset();
+
+		// Ensure the completed graph doesn't wait on the destroyed thread pool
+		ASSERT_TRUE(graph->IsComplete());
+		graph.reset();
+		ASSERT_EQ(executedCount, 1);
+	}
+
+	// Run() with nodes on the I/O lane
+	TEST(JobGraphTests, Run_IOLane)
+	{
+		ThreadPool threadPool(2, ThreadPool::ExecutionMode::Threads, IdlePolicy(), ThreadPool::ThreadPlacement::Unpinned,
+			ElasticPolicy::Fixed(), 1);
+		JobGraph graph;
+		std::atomic<ThreadPool*> loadPool	= nullptr;
+		std::atomic_bool isLoaded			= false;
+		std::atomic_bool isProcessed		= false;
+
+		// Build an I/O node loading data, followed by a compute node processing it
+		JobGraph::NodeId load = graph.AddNode([&loadPool, &isLoaded]
+		{
+			loadPool	= PooledThread::GetCurrent()->GetThreadPool();
+			isLoaded	= true;
+		}, JobPriority::Background, JobLane::IO);
+		JobGraph::NodeId process = graph.AddNode([&isLoaded, &isProcessed]
+		{
+			isProcessed = isLoaded.load();
+		});
+		graph.AddEdge(load, process);
+
+		// Ensure the I/O node executed on an I/O thread, before the compute node
+		graph.Run(threadPool);
+		ASSERT_NE(loadPool.load(), nullptr);
+		ASSERT_NE(loadPool.load(), &threadPool);
+		ASSERT_TRUE(isProcessed);
+	}
+
+	// Run() repeatedly on the same graph
+	TEST(JobGraphTests, Run_Repeated)
+	{
+		ThreadPool threadPool(4);
+		JobGraph graph;
+		std::atomic_int executedCount = 0;
+		std::atomic_int lastValue = 0;
+
+		// Build chain of nodes, each checking the previous node has executed
+		JobGraph::NodeId previous = graph.AddNode([&executedCount, &lastValue]
+		{
+			executedCount++;
+			lastValue = 1;
+		});
+		for (int i = 2; i <= 16; i++)
+		{
+			JobGraph::NodeId node = graph.AddNode([&executedCount, &lastValue, i]
+			{
+				executedCount++;
+				if (lastValue == i - 1)
+				{
+					lastValue = i;
+				}
+			});
+			graph.AddEdge(previous, node);
+			previous = node;
+		}
+
+		// Ensure every node executes in order on each run
+		for (int run = 1; run <= 10; run++)
+		{
+			lastValue = 0;
+			graph.Run(threadPool);
+			ASSERT_EQ(executedCount, run * 16);
+			ASSERT_EQ(lastValue, 16);
+		}
+	}
+
+	// Run() with a token cancelled part way through the graph
+	TEST(JobGraphTests, Run_Cancelled)
+	{
+		ThreadPool threadPool(4);
+		JobGraph graph;
+		CancellationToken token;
+		std::atomic_int executedCount = 0;
+
+		// Build chain of nodes, with the second node cancelling the graph
+		JobGraph::NodeId first	= graph.AddNode([&executedCount] { executedCount++; });
+		JobGraph::NodeId second	= graph.AddNode([&executedCount, &token] { executedCount++; token.Cancel(); });
+		JobGraph::NodeId third	= graph.AddNode([&executedCount] { executedCount++; });
+		JobGraph::NodeId fourth	= graph.AddNode([&executedCount] { executedCount++; });
+		graph.AddEdge(first, second);
+		graph.AddEdge(second, third);
+		graph.AddEdge(third, fourth);
+
+		// Ensure nodes after the cancellation are skipped, and the graph still completes
+		graph.Run(threadPool, &token);
+		ASSERT_TRUE(graph.IsComplete());
+		ASSERT_EQ(executedCount.load(), 2);
+
+		// Ensure the graph executes fully without a token
+		graph.Run(threadPool);
+		ASSERT_EQ(executedCount.load(), 6);
+	}
+
+	// Compile() with a cycle
+	TEST(JobGraphTests, Compile_Cycle)
+	{
+		JobGraph graph;
+		JobGraph::NodeId first	= graph.AddNode([] {});
+		JobGraph::NodeId second	= graph.AddNode([] {});
+		graph.AddEdge(first, second);
+		graph.AddEdge(second, first);
+
+		// Ensure cycle is found
+		ASSERT_THROW(graph.Compile(), std::logic_error);
+	}
+
+	// AddEdge() with invalid nodes
+	TEST(JobGraphTests, AddEdge_Invalid)
+	{
+		JobGraph graph;
+		JobGraph::NodeId node = graph.AddNode([] {});
+
+		ASSERT_THROW(graph.AddEdge(node, node + 1), std::out_of_range);
+		ASSERT_THROW(graph.AddEdge(node, node), std::invalid_argument);
+	}
+
+	// Normal usage of GetCriticalPathLength() and GetCriticalPath()
+	TEST(JobGraphTests, GetCriticalPath)
+	{
+		ThreadPool threadPool(2);
+		JobGraph graph;
+
+		// Build a short chain alongside a longer, slower chain
+		JobGraph::NodeId root		= graph.AddNode([] {});
+		JobGraph::NodeId fast		= graph.AddNode([] {});
+		JobGraph::NodeId slowFirst	= graph.AddNode([] { std::this_thread::sleep_for(std::chrono::milliseconds(5)); });
+		JobGraph::NodeId slowSecond	= graph.AddNode([] { std::this_thread::sleep_for(std::chrono::milliseconds(5)); });
+		JobGraph::NodeId end		= graph.AddNode([] {});
+		graph.AddEdge(root, fast);
+		graph.AddEdge(root, slowFirst);
+		graph.AddEdge(slowFirst, slowSecond);
+		graph.AddEdge(fast, end);
+		graph.AddEdge(slowSecond, end);
+		graph.Compile();
+		ASSERT_EQ(graph.GetCriticalPathLength(), 4);
+
+		// Ensure the slower chain bounds the graph
+		graph.Run(threadPool);
+		std::vector<JobGraph::NodeId> criticalPath = graph.GetCriticalPath();
+		ASSERT_EQ(criticalPath, std::vector<JobGraph::NodeId>({ root, slowFirst, slowSecond, end }));
+		ASSERT_GE(graph.GetCriticalPathDuration(), std::chrono::milliseconds(10));
+	}
+}
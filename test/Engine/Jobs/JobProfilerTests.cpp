@@ -0,0 +1,187 @@
+#include <Engine/Jobs/JobProfiler.hpp>
+
+// STL includes
+#include <sstream>
+#include <string>
+// AndGen includes
+#include <Engine/Parallelism/ThreadPool.hpp>
+// Google Test includes
+#include <gtest/gtest.h>
+
+namespace AndGen::Tests
+{
+	// Counts the occurrences of a string within a trace
+	static size_t CountOccurrences(const std::string& trace, const std::string& text)
+	{
+		size_t count = 0;
+		for (size_t position = trace.find(text); position != std::string::npos; position = trace.find(text, position + 1))
+		{
+			count++;
+		}
+
+		return count;
+	}
+
+	// Normal usage of WriteChromeTrace()
+	TEST(JobProfilerTests, WriteChromeTrace)
+	{
+		int job = 0;
+		JobProfiler::SetThreadName("Profiler \"test\" thread");
+		JobProfiler::BeginCapture();
+		JobProfiler::Record(JobProfiler::EventType::Idle);
+		JobProfiler::Record(JobProfiler::EventType::Queue, &job);
+		JobProfiler::Record(JobProfiler::EventType::Steal, &job, 3);
+		JobProfiler::Record(JobProfiler::EventType::JobBegin, &job);
+		JobProfiler::Record(JobProfiler::EventType::JobEnd, &job);
+		JobProfiler::Record(JobProfiler::EventType::Frame);
+		JobProfiler::EndCapture();
+
+		std::ostringstream stream;
+		JobProfiler::WriteChromeTrace(stream);
+		std::string trace = stream.str();
+
+		// Ensure each event was written, with the job paired with when it was queued
+		ASSERT_EQ(trace.find("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["), 0);
+		ASSERT_NE(trace.find("\"name\":\"Profiler \\\"test\\\" thread\""), std::string::npos);
+		ASSERT_EQ(CountOccurrences(trace, "\"name\":\"Job\",\"cat\":\"job\",\"ph\":\"X\""), 1);
+		ASSERT_NE(trace.find("\"queueWait\":"), std::string::npos);
+		ASSERT_EQ(CountOccurrences(trace, "\"name\":\"Idle\""), 1);
+		ASSERT_NE(trace.find("\"victim\":3"), std::string::npos);
+		ASSERT_EQ(CountOccurrences(trace, "\"name\":\"Frame\""), 1);
+	}
+
+	// WriteChromeTrace() only writes events from the last capture
+	TEST(JobProfilerTests, WriteChromeTrace_LastCapture)
+	{
+		int firstJob	= 0;
+		int secondJob	= 0;
+		JobProfiler::BeginCapture();
+		JobProfiler::Record(JobProfiler::EventType::JobBegin, &firstJob);
+		JobProfiler::Record(JobProfiler::EventType::JobEnd, &firstJob);
+		JobProfiler::EndCapture();
+
+		// Ensure events aren't recorded between captures
+		JobProfiler::Record(JobProfiler::EventType::JobBegin, &secondJob);
+		JobProfiler::Record(JobProfiler::EventType::JobEnd, &secondJob);
+
+		JobProfiler::BeginCapture();
+		JobProfiler::Record(JobProfiler::EventType::JobBegin, &secondJob);
+		JobProfiler::Record(JobProfiler::EventType::JobEnd, &secondJob);
+		JobProfiler::EndCapture();
+
+		std::ostringstream stream;
+		JobProfiler::WriteChromeTrace(stream);
+
+		// Ensure the job wasn't paired with a queue event from an earlier capture
+		ASSERT_EQ(CountOccurrences(stream.str(), "\"name\":\"Job\""), 1);
+		ASSERT_EQ(stream.str().find("\"queueWait\":"), std::string::npos);
+	}
+
+	// WriteChromeTrace() with named jobs and zones
+	TEST(JobProfilerTests, WriteChromeTrace_Names)
+	{
+		static constexpr JobName jobName("Physics");
+		int job = 0;
+		JobProfiler::BeginCapture();
+		JobProfiler::Record(JobProfiler::EventType::JobBegin, &job);
+		JobProfiler::Record(JobProfiler::EventType::Name, &jobName);
+		{
+			ProfileZone outerZone(ANDGEN_JOB_NAME("Broadphase"));
+			ProfileZone innerZone(ANDGEN_JOB_NAME("Sort \"pairs\""));
+		}
+		JobProfiler::Record(JobProfiler::EventType::JobEnd, &job);
+		JobProfiler::EndCapture();
+
+		std::ostringstream stream;
+		JobProfiler::WriteChromeTrace(stream);
+		std::string trace = stream.str();
+
+		// Ensure the job is written by its name, and each zone within it
+		ASSERT_EQ(CountOccurrences(trace, "\"name\":\"Job\""), 0);
+		ASSERT_EQ(CountOccurrences(trace, "\"name\":\"Physics\",\"cat\":\"job\""), 1);
+		ASSERT_EQ(CountOccurrences(trace, "\"name\":\"Broadphase\",\"cat\":\"zone\""), 1);
+		ASSERT_EQ(CountOccurrences(trace, "\"name\":\"Sort \\\"pairs\\\"\",\"cat\":\"zone\""), 1);
+		ASSERT_EQ(CountOccurrences(trace, "JobProfilerTests.cpp"), 3);
+	}
+
+	// Normal usage of CaptureFrames()
+	TEST(JobProfilerTests, CaptureFrames)
+	{
+		JobProfiler::CaptureFrames(2);
+		ASSERT_FALSE(JobProfiler::IsCapturing());
+
+		// Ensure the capture begins with the next frame, and ends once both frames have completed
+		JobProfiler::MarkFrame();
+		ASSERT_TRUE(JobProfiler::IsCapturing());
+		JobProfiler::MarkFrame();
+		ASSERT_TRUE(JobProfiler::IsCapturing());
+		JobProfiler::MarkFrame();
+		ASSERT_FALSE(JobProfiler::IsCapturing());
+
+		std::ostringstream stream;
+		JobProfiler::WriteChromeTrace(stream);
+		ASSERT_EQ(CountOccurrences(stream.str(), "\"name\":\"Frame\""), 2);
+	}
+
+#if defined(ANDGEN_JOB_PROFILER)
+	// Capturing frames of a thread pool
+	TEST(JobProfilerTests, CaptureFrames_ThreadPool)
+	{
+		constexpr int jobCount = 32;
+
+		ThreadPool threadPool(1);
+		JobProfiler::CaptureFrames(1);
+		threadPool.BeginFrame(FrameBudget::Unlimited());
+
+		for (int i = 0; i < jobCount; i++)
+		{
+			threadPool.QueueJob([] {});
+		}
+		threadPool.WaitForThreads();
+		threadPool.BeginFrame(FrameBudget::Unlimited());
+		ASSERT_FALSE(JobProfiler::IsCapturing());
+
+		// Ensure every job was written, each with the time it waited after being queued,
+		// whether executed by the pooled thread or by this thread while waiting
+		std::ostringstream stream;
+		JobProfiler::WriteChromeTrace(stream);
+		std::string trace = stream.str();
+		ASSERT_EQ(CountOccurrences(trace, "\"name\":\"Job\""), jobCount);
+		ASSERT_EQ(CountOccurrences(trace, "\"queueWait\":"), jobCount);
+	}
+
+	/// <summary>
+	/// Named job timing a zone within its execution
+	/// </summary>
+	class ZonedJob : public Job
+	{
+	public:
+		ZonedJob() : Job(ANDGEN_JOB_NAME("Zoned job")) {}
+
+	protected:
+		virtual void Execute() override
+		{
+			ANDGEN_ZONE("Zone within job");
+		}
+	};
+
+	// Capturing named jobs and zones executed by a thread pool
+	TEST(JobProfilerTests, CaptureFrames_ThreadPoolNames)
+	{
+		ThreadPool threadPool(1);
+		JobProfiler::CaptureFrames(1);
+		threadPool.BeginFrame(FrameBudget::Unlimited());
+
+		threadPool.QueueJob(std::make_shared<ZonedJob>());
+		threadPool.WaitForThreads();
+		threadPool.BeginFrame(FrameBudget::Unlimited());
+
+		// Ensure the job was written by its name, with its zone
+		std::ostringstream stream;
+		JobProfiler::WriteChromeTrace(stream);
+		std::string trace = stream.str();
+		ASSERT_EQ(CountOccurrences(trace, "\"name\":\"Zoned job\",\"cat\":\"job\""), 1);
+		ASSERT_EQ(CountOccurrences(trace, "\"name\":\"Zone within job\",\"cat\":\"zone\""), 1);
+	}
+#endif
+}
@@ -5,18 +5,20 @@
 #include <functional>
 #include <memory>
 #include <thread>
+#include <vector>
 // Google Test includes
 #include <gtest/gtest.h>
 // AndGen includes
 #include <AndGen/Engine/Jobs/Job.hpp>
+#include <Engine/Jobs/JobRecord.hpp>
 
 namespace AndGen::Tests
 {
-	class TestJob : public Job
+	class TimestampedJob : public Job
 	{
 	public:
-		TestJob() : Job() {}
-		virtual ~TestJob() override {}
+		TimestampedJob() : Job() {}
+		virtual ~TimestampedJob() override {}
 
 		virtual void Execute() override final
 		{
@@ -33,7 +35,7 @@ namespace AndGen::Tests
 		static std::shared_ptr<Job> CreateJob()
 		{
 			std::shared_ptr<Job> job;
-			job.reset(new TestJob);
+			job.reset(new TimestampedJob);
 
 			return job;
 		}
@@ -122,6 +124,31 @@ namespace AndGen::Tests
 		ASSERT_EQ(jobQueue.Count(), 0);
 	}
 
+	// AddJobs() normal usage
+	TEST(JobQueueTests, AddJobs)
+	{
+		// Create Job Queue and records
+		JobQueue jobQueue;
+		std::vector<int> executedIndices;
+		std::vector<JobRecord*> records;
+		for (int i = 0; i < 4; i++)
+		{
+			records.push_back(JobRecord::Create([&executedIndices, i] { executedIndices.push_back(i); }));
+		}
+
+		// Add records as a batch, and ensure job queue has expected count
+		jobQueue.AddJobs(records.data(), records.size(), JobPriority::Background);
+		ASSERT_EQ(jobQueue.Count(), records.size());
+		ASSERT_EQ(jobQueue.Count(JobPriority::Background), records.size());
+
+		// Ensure jobs are executed in the order they were given
+		while (!jobQueue.IsEmpty())
+		{
+			jobQueue.ExecuteNextJob();
+		}
+		ASSERT_EQ(executedIndices, std::vector<int>({ 0, 1, 2, 3 }));
+	}
+
 	// AddJobQueue() normal usage
 	TEST(JobQueueTests, AddJobQueue)
 	{
@@ -193,9 +220,9 @@ namespace AndGen::Tests
 	{
 		// Create Job Queue and test jobs
 		JobQueue jobQueue;
-		std::shared_ptr<TestJob> firstJob = std::make_shared<TestJob>();
-		std::shared_ptr<TestJob> secondJob = std::make_shared<TestJob>();
-		std::shared_ptr<TestJob> thirdJob = std::make_shared<TestJob>();
+		std::shared_ptr<TimestampedJob> firstJob = std::make_shared<TimestampedJob>();
+		std::shared_ptr<TimestampedJob> secondJob = std::make_shared<TimestampedJob>();
+		std::shared_ptr<TimestampedJob> thirdJob = std::make_shared<TimestampedJob>();
 		// Add test jobs to Job Queue
 		jobQueue.AddJob(std::dynamic_pointer_cast<Job>(firstJob));
 		jobQueue.AddJob(std::dynamic_pointer_cast<Job>(secondJob));
@@ -226,9 +253,9 @@ namespace AndGen::Tests
 	{
 		// Create Job Queue and test jobs
 		JobQueue jobQueue;
-		std::shared_ptr<TestJob> firstJob = std::make_shared<TestJob>();
-		std::shared_ptr<TestJob> secondJob = std::make_shared<TestJob>();
-		std::shared_ptr<TestJob> thirdJob = std::make_shared<TestJob>();
+		std::shared_ptr<TimestampedJob> firstJob = std::make_shared<TimestampedJob>();
+		std::shared_ptr<TimestampedJob> secondJob = std::make_shared<TimestampedJob>();
+		std::shared_ptr<TimestampedJob> thirdJob = std::make_shared<TimestampedJob>();
 		// Add test jobs to Job Queue
 		jobQueue.AddJob(std::dynamic_pointer_cast<Job>(firstJob));
 		jobQueue.AddJob(std::dynamic_pointer_cast<Job>(secondJob));
@@ -275,9 +302,9 @@ namespace AndGen::Tests
 	{
 		// Create Job Queue and test jobs
 		JobQueue jobQueue, queueToAdd;
-		std::shared_ptr<TestJob> firstJob = std::make_shared<TestJob>();
-		std::shared_ptr<TestJob> secondJob = std::make_shared<TestJob>();
-		std::shared_ptr<TestJob> thirdJob = std::make_shared<TestJob>();
+		std::shared_ptr<TimestampedJob> firstJob = std::make_shared<TimestampedJob>();
+		std::shared_ptr<TimestampedJob> secondJob = std::make_shared<TimestampedJob>();
+		std::shared_ptr<TimestampedJob> thirdJob = std::make_shared<TimestampedJob>();
 		// Add test jobs to Job Queue to be added
 		queueToAdd.AddJob(std::dynamic_pointer_cast<Job>(firstJob));
 		queueToAdd.AddJob(std::dynamic_pointer_cast<Job>(secondJob));
@@ -310,9 +337,9 @@ namespace AndGen::Tests
 	{
 		// Create Job Queue and test jobs
 		JobQueue jobQueue, queueToAdd;
-		std::shared_ptr<TestJob> firstJob = std::make_shared<TestJob>();
-		std::shared_ptr<TestJob> secondJob = std::make_shared<TestJob>();
-		std::shared_ptr<TestJob> thirdJob = std::make_shared<TestJob>();
+		std::shared_ptr<TimestampedJob> firstJob = std::make_shared<TimestampedJob>();
+		std::shared_ptr<TimestampedJob> secondJob = std::make_shared<TimestampedJob>();
+		std::shared_ptr<TimestampedJob> thirdJob = std::make_shared<TimestampedJob>();
 		// Add test jobs to Job Queue to be added
 		queueToAdd.AddJob(std::dynamic_pointer_cast<Job>(firstJob));
 		queueToAdd.AddJob(std::dynamic_pointer_cast<Job>(secondJob));
@@ -430,4 +457,100 @@ namespace AndGen::Tests
 		// Ensure IsEmpty() is true
 		ASSERT_TRUE(jobQueue.IsEmpty());
 	}
-}
\ No newline at end of file
+
+	// GetNextJob() with jobs of different priorities
+	TEST(JobQueueTests, GetNextJob_Priority)
+	{
+		// Create Job Queue
+		JobQueue jobQueue;
+
+		// Add a job for each priority, from lowest to highest
+		std::vector<JobPriority> executedPriorities;
+		for (size_t i = JobPriorityCount; i > 0; i--)
+		{
+			JobPriority priority = static_cast<JobPriority>(i - 1);
+			jobQueue.AddJob(JobRecord::Create([&executedPriorities, priority]
+			{
+				executedPriorities.push_back(priority);
+			}), priority);
+		}
+		ASSERT_EQ(jobQueue.Count(), JobPriorityCount);
+		ASSERT_EQ(jobQueue.Count(JobPriority::Background), 1);
+
+		// Ensure jobs are taken from highest to lowest priority
+		while (!jobQueue.IsEmpty())
+		{
+			jobQueue.ExecuteNextJob();
+		}
+		ASSERT_EQ(executedPriorities.size(), JobPriorityCount);
+		for (size_t i = 0; i < JobPriorityCount; i++)
+		{
+			ASSERT_EQ(executedPriorities[i], static_cast<JobPriority>(i));
+		}
+	}
+
+	// GetNextJob() with a lowest priority given
+	TEST(JobQueueTests, GetNextJob_LowestPriority)
+	{
+		// Create Job Queue, with a background job
+		JobQueue jobQueue;
+		jobQueue.AddJob(TestHelper::CreateJob(), JobPriority::Background);
+
+		// Ensure background job isn't taken when only critical jobs are wanted
+		ASSERT_EQ(jobQueue.GetNextJob(JobPriority::Critical), nullptr);
+		ASSERT_EQ(jobQueue.Count(), 1);
+
+		// Ensure background job is taken otherwise
+		JobRecord* record = jobQueue.GetNextJob();
+		ASSERT_NE(record, nullptr);
+		ASSERT_TRUE(jobQueue.IsEmpty());
+		JobRecord::Discard(record);
+	}
+
+	// GetNextJob() with low priority jobs waiting behind many higher priority jobs
+	TEST(JobQueueTests, GetNextJob_Aging)
+	{
+		// Create Job Queue, with an idle job queued before many frame jobs
+		JobQueue jobQueue;
+		bool idleJobExecuted = false;
+		jobQueue.AddJob(JobRecord::Create([&idleJobExecuted] { idleJobExecuted = true; }), JobPriority::Idle);
+		for (unsigned int i = 0; i < JobQueue::AgingThreshold * 2; i++)
+		{
+			jobQueue.AddJob(TestHelper::CreateJob(), JobPriority::Frame);
+		}
+
+		// Ensure idle job isn't starved by frame jobs
+		for (unsigned int i = 0; i < JobQueue::AgingThreshold; i++)
+		{
+			jobQueue.ExecuteNextJob();
+			ASSERT_FALSE(idleJobExecuted);
+		}
+		jobQueue.ExecuteNextJob();
+		ASSERT_TRUE(idleJobExecuted);
+		ASSERT_EQ(jobQueue.Count(JobPriority::Frame), JobQueue::AgingThreshold);
+	}
+
+	// GetAgedJob() with a low priority job passed over for jobs taken from elsewhere
+	TEST(JobQueueTests, GetAgedJob_PassOver)
+	{
+		// Create Job Queue, with an idle job and a frame job queued
+		JobQueue jobQueue;
+		bool idleJobExecuted = false;
+		jobQueue.AddJob(JobRecord::Create([&idleJobExecuted] { idleJobExecuted = true; }), JobPriority::Idle);
+		jobQueue.AddJob(TestHelper::CreateJob(), JobPriority::Frame);
+
+		// Ensure the idle job is only taken once passed over enough times, and never the frame job
+		for (unsigned int i = 0; i < JobQueue::AgingThreshold; i++)
+		{
+			ASSERT_EQ(jobQueue.GetAgedJob(), nullptr);
+			jobQueue.PassOver(JobPriority::Frame);
+		}
+		ASSERT_EQ(jobQueue.GetAgedJob(JobPriority::Background), nullptr);
+		JobRecord* record = jobQueue.GetAgedJob();
+		ASSERT_NE(record, nullptr);
+		JobRecord::Execute(record);
+		ASSERT_TRUE(idleJobExecuted);
+		ASSERT_EQ(jobQueue.GetAgedJob(), nullptr);
+		ASSERT_EQ(jobQueue.Count(JobPriority::Frame), 1);
+	}
+}
@@ -0,0 +1,131 @@
+#include <Engine/Jobs/JobRecord.hpp>
+
+// STL includes
+#include <memory>
+#include <stdexcept>
+// Google Test includes
+#include <gtest/gtest.h>
+
+namespace AndGen::Tests
+{
+	class RecordedJob : public Job
+	{
+	public:
+		RecordedJob() : Job() {}
+		~RecordedJob() = default;
+
+		bool executeWasRan = false;
+
+	protected:
+		virtual void Execute() override
+		{
+			executeWasRan = true;
+		}
+	};
+
+	// Normal usage of Create() and Execute()
+	TEST(JobRecordTests, CreateExecute)
+	{
+		int executedCount = 0;
+		JobCounter counter;
+		counter.Increment();
+
+		// Create and execute record
+		JobRecord* record = JobRecord::Create([&executedCount] { executedCount++; }, &counter);
+		JobRecord::Execute(record);
+
+		// Ensure function was executed once and counter was decremented
+		ASSERT_EQ(executedCount, 1);
+		ASSERT_TRUE(counter.IsComplete());
+	}
+
+	// Create() with a job
+	TEST(JobRecordTests, Create_Job)
+	{
+		std::shared_ptr<RecordedJob> job = std::make_shared<RecordedJob>();
+
+		// Create and execute record
+		JobRecord* record = JobRecord::Create(std::static_pointer_cast<Job>(job));
+		ASSERT_EQ(job.use_count(), 2);
+		JobRecord::Execute(record);
+
+		// Ensure job was executed and released by the record
+		ASSERT_TRUE(job->executeWasRan);
+		ASSERT_TRUE(job->IsCompleted());
+		ASSERT_EQ(job.use_count(), 1);
+	}
+
+	// Allocate() after records have been released
+	TEST(JobRecordTests, Allocate_Reused)
+	{
+		// Ensure released records are reused by the same thread
+		JobRecord* record = JobRecord::Allocate();
+		JobRecord::Release(record);
+		ASSERT_EQ(JobRecord::Allocate(), record);
+
+		JobRecord::Release(record);
+	}
+
+	// Normal usage of Discard()
+	TEST(JobRecordTests, Discard)
+	{
+		std::shared_ptr<int> state = std::make_shared<int>(0);
+		JobCounter counter;
+		counter.Increment();
+
+		// Discard record without executing it
+		JobRecord* record = JobRecord::Create([state] { (*state)++; }, &counter);
+		ASSERT_EQ(state.use_count(), 2);
+		JobRecord::Discard(record);
+
+		// Ensure function was destroyed without executing, and counter was still released
+		ASSERT_EQ(*state, 0);
+		ASSERT_EQ(state.use_count(), 1);
+		ASSERT_TRUE(counter.IsComplete());
+	}
+
+	// Discard() with a job, which is completed as cancelled
+	TEST(JobRecordTests, Discard_Job)
+	{
+		std::shared_ptr<RecordedJob> job		= std::make_shared<RecordedJob>();
+		std::shared_ptr<RecordedJob> successor	= std::make_shared<RecordedJob>();
+		successor->Schedule(job);
+
+		// Discard record without executing it
+		JobRecord::Discard(JobRecord::Create(std::static_pointer_cast<Job>(job)));
+
+		// Ensure job completed without executing, cancelling the job depending on it
+		ASSERT_FALSE(job->executeWasRan);
+		ASSERT_TRUE(job->IsCompleted());
+		ASSERT_TRUE(job->IsCancelled());
+		ASSERT_TRUE(successor->IsCancelled());
+	}
+
+	// Normal usage of Clone()
+	TEST(JobRecordTests, Clone)
+	{
+		int executedCount = 0;
+
+		// Clone record
+		JobRecord* record	= JobRecord::Create([&executedCount] { executedCount++; });
+		JobRecord* copy		= JobRecord::Clone(record);
+		ASSERT_NE(copy, record);
+
+		// Ensure both records execute the function
+		JobRecord::Execute(record);
+		JobRecord::Execute(copy);
+		ASSERT_EQ(executedCount, 2);
+	}
+
+	// Clone() with a function which can't be copied
+	TEST(JobRecordTests, Clone_NotCopyable)
+	{
+		std::unique_ptr<int> state = std::make_unique<int>(0);
+		JobRecord* record = JobRecord::Create([state = std::move(state)] { (*state)++; });
+
+		// Ensure function can't be copied
+		ASSERT_THROW(JobRecord::Clone(record), std::logic_error);
+
+		JobRecord::Discard(record);
+	}
+}
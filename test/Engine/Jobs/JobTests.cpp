@@ -1,5 +1,11 @@
 #include <AndGen/Engine/Jobs/Job.hpp>
 
+// STL includes
+#include <list>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
 // Google Test includes
 #include <gtest/gtest.h>
 
@@ -35,4 +41,122 @@ namespace AndGen::Tests
 		// Ensure job is flagged as completed after execution
 		ASSERT_TRUE(testJob->IsCompleted());
 	}
+
+	// Normal usage of Schedule()
+	TEST(JobTests, Schedule)
+	{
+		std::shared_ptr<TestJob> firstJob	= std::make_shared<TestJob>();
+		std::shared_ptr<TestJob> secondJob	= std::make_shared<TestJob>();
+		// Ensure jobs have no dependencies on creation
+		ASSERT_EQ(secondJob->PendingDependenciesCount(), 0);
+
+		// Schedule second job to depend on the first
+		secondJob->Schedule(firstJob);
+		ASSERT_EQ(secondJob->PendingDependenciesCount(), 1);
+
+		// Ensure dependency is released once the first job completes
+		firstJob->Run();
+		ASSERT_EQ(secondJob->PendingDependenciesCount(), 0);
+		ASSERT_FALSE(secondJob->IsCompleted());
+	}
+
+	// Schedule() with collections of jobs
+	TEST(JobTests, Schedule_Collections)
+	{
+		std::shared_ptr<TestJob> job = std::make_shared<TestJob>();
+		std::vector<std::shared_ptr<TestJob>> vectorJobs = { std::make_shared<TestJob>(), std::make_shared<TestJob>() };
+		std::list<std::shared_ptr<TestJob>> listJobs = { std::make_shared<TestJob>(), std::make_shared<TestJob>() };
+
+		// Schedule job to depend on both collections
+		job->Schedule(vectorJobs);
+		job->Schedule(listJobs);
+		ASSERT_EQ(job->PendingDependenciesCount(), 4);
+
+		// Ensure each completed dependency is released
+		vectorJobs[0]->Run();
+		listJobs.front()->Run();
+		ASSERT_EQ(job->PendingDependenciesCount(), 2);
+	}
+
+	// Schedule() with a job which has already completed
+	TEST(JobTests, Schedule_Completed)
+	{
+		std::shared_ptr<TestJob> firstJob	= std::make_shared<TestJob>();
+		std::shared_ptr<TestJob> secondJob	= std::make_shared<TestJob>();
+		firstJob->Run();
+
+		// Ensure no dependency is added on a completed job
+		secondJob->Schedule(firstJob);
+		ASSERT_EQ(secondJob->PendingDependenciesCount(), 0);
+	}
+
+	// Schedule() with invalid dependencies
+	TEST(JobTests, Schedule_Invalid)
+	{
+		std::shared_ptr<TestJob> job = std::make_shared<TestJob>();
+
+		// Null dependency is ignored
+		job->Schedule(std::shared_ptr<TestJob>(nullptr));
+		ASSERT_EQ(job->PendingDependenciesCount(), 0);
+
+		// Job depending on itself
+		ASSERT_THROW(job->Schedule(job), std::invalid_argument);
+	}
+
+	// Run() with a cancelled token, cancelling jobs depending on it
+	TEST(JobTests, Run_Cancelled)
+	{
+		CancellationToken token;
+		std::shared_ptr<TestJob> firstJob	= std::make_shared<TestJob>();
+		std::shared_ptr<TestJob> secondJob	= std::make_shared<TestJob>();
+		firstJob->SetCancellationToken(&token);
+		secondJob->Schedule(firstJob);
+		ASSERT_FALSE(firstJob->IsCancelled());
+
+		// Ensure cancelled job completes without executing
+		token.Cancel();
+		ASSERT_TRUE(firstJob->IsCancelled());
+		firstJob->Run();
+		ASSERT_TRUE(firstJob->IsCompleted());
+		ASSERT_FALSE(firstJob->executeWasRan);
+
+		// Ensure the job depending on it is cancelled too
+		ASSERT_TRUE(secondJob->IsCancelled());
+		secondJob->Run();
+		ASSERT_TRUE(secondJob->IsCompleted());
+		ASSERT_FALSE(secondJob->executeWasRan);
+	}
+
+	// De-constructing a job which never completed, cancelling jobs depending on it
+	TEST(JobTests, Destroy_Uncompleted)
+	{
+		std::shared_ptr<TestJob> firstJob	= std::make_shared<TestJob>();
+		std::shared_ptr<TestJob> secondJob	= std::make_shared<TestJob>();
+		secondJob->Schedule(firstJob);
+		ASSERT_EQ(secondJob->PendingDependenciesCount(), 1);
+
+		// Ensure the job depending on it is released and cancelled
+		firstJob.reset();
+		ASSERT_EQ(secondJob->PendingDependenciesCount(), 0);
+		ASSERT_TRUE(secondJob->IsCancelled());
+		secondJob->Run();
+		ASSERT_TRUE(secondJob->IsCompleted());
+		ASSERT_FALSE(secondJob->executeWasRan);
+	}
+
+	// Normal usage of SetName()
+	TEST(JobTests, SetName)
+	{
+		std::shared_ptr<TestJob> testJob = std::make_shared<TestJob>();
+		ASSERT_EQ(testJob->GetName(), nullptr);
+
+		// Ensure the name refers to the static name declared, with the location it was declared at
+		const JobName* name					= ANDGEN_JOB_NAME("Physics");
+		std::uint_least32_t declaredLine	= __LINE__ - 1;
+		testJob->SetName(name);
+		ASSERT_EQ(testJob->GetName(), name);
+		ASSERT_STREQ(testJob->GetName()->name, "Physics");
+		ASSERT_NE(std::string(testJob->GetName()->file).find("JobTests.cpp"), std::string::npos);
+		ASSERT_EQ(testJob->GetName()->line, declaredLine);
+	}
 }
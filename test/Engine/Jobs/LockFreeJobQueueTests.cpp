@@ -0,0 +1,193 @@
+#include <Engine/Jobs/LockFreeJobQueue.hpp>
+
+// STL includes
+#include <atomic>
+#include <thread>
+#include <vector>
+// Google Test includes
+#include <gtest/gtest.h>
+// AndGen includes
+#include <Engine/Jobs/JobRecord.hpp>
+
+namespace AndGen::Tests
+{
+	// AddJob() normal usage
+	TEST(LockFreeJobQueueTests, AddJob)
+	{
+		LockFreeJobQueue jobQueue;
+		ASSERT_TRUE(jobQueue.IsEmpty());
+
+		// Add jobs, and ensure they're executed in the order they were added
+		std::vector<int> executedIndices;
+		for (int i = 0; i < 3; i++)
+		{
+			jobQueue.AddJob(JobRecord::Create([&executedIndices, i] { executedIndices.push_back(i); }));
+		}
+		ASSERT_EQ(jobQueue.Count(), 3);
+		ASSERT_EQ(jobQueue.Count(JobPriority::Frame), 3);
+
+		while (!jobQueue.IsEmpty())
+		{
+			jobQueue.ExecuteNextJob();
+		}
+		ASSERT_EQ(executedIndices, std::vector<int>({ 0, 1, 2 }));
+	}
+
+	// AddJobs() with more jobs than a lane's ring holds
+	TEST(LockFreeJobQueueTests, AddJobs_Overflow)
+	{
+		LockFreeJobQueue jobQueue(4);
+
+		// Add records as a batch, overflowing the lane's ring
+		std::vector<int> executedIndices;
+		std::vector<JobRecord*> records;
+		for (int i = 0; i < 10; i++)
+		{
+			records.push_back(JobRecord::Create([&executedIndices, i] { executedIndices.push_back(i); }));
+		}
+		jobQueue.AddJobs(records.data(), records.size(), JobPriority::Background);
+		ASSERT_EQ(jobQueue.Count(), records.size());
+		ASSERT_EQ(jobQueue.Count(JobPriority::Background), records.size());
+
+		// Ensure jobs are still executed in the order they were given
+		while (!jobQueue.IsEmpty())
+		{
+			jobQueue.ExecuteNextJob();
+		}
+		ASSERT_EQ(executedIndices, std::vector<int>({ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 }));
+	}
+
+	// GetNextJob() with jobs of different priorities
+	TEST(LockFreeJobQueueTests, GetNextJob_Priority)
+	{
+		LockFreeJobQueue jobQueue;
+
+		// Add a job for each priority, from lowest to highest
+		std::vector<JobPriority> executedPriorities;
+		for (size_t i = JobPriorityCount; i > 0; i--)
+		{
+			JobPriority priority = static_cast<JobPriority>(i - 1);
+			jobQueue.AddJob(JobRecord::Create([&executedPriorities, priority]
+			{
+				executedPriorities.push_back(priority);
+			}), priority);
+		}
+
+		// Ensure critical jobs are taken alone when only critical jobs are wanted
+		JobRecord* record = jobQueue.GetNextJob(JobPriority::Critical);
+		ASSERT_NE(record, nullptr);
+		JobRecord::Execute(record);
+		ASSERT_EQ(jobQueue.GetNextJob(JobPriority::Critical), nullptr);
+
+		// Ensure remaining jobs are taken from highest to lowest priority
+		while (!jobQueue.IsEmpty())
+		{
+			jobQueue.ExecuteNextJob();
+		}
+		ASSERT_EQ(executedPriorities.size(), JobPriorityCount);
+		for (size_t i = 0; i < JobPriorityCount; i++)
+		{
+			ASSERT_EQ(executedPriorities[i], static_cast<JobPriority>(i));
+		}
+	}
+
+	// GetNextJob() with low priority jobs waiting behind many higher priority jobs
+	TEST(LockFreeJobQueueTests, GetNextJob_Aging)
+	{
+		// Create Job Queue, with an idle job queued before many frame jobs
+		LockFreeJobQueue jobQueue;
+		bool idleJobExecuted = false;
+		jobQueue.AddJob(JobRecord::Create([&idleJobExecuted] { idleJobExecuted = true; }), JobPriority::Idle);
+		for (unsigned int i = 0; i < LockFreeJobQueue::AgingThreshold * 2; i++)
+		{
+			jobQueue.AddJob(JobRecord::Create([] {}), JobPriority::Frame);
+		}
+
+		// Ensure idle job isn't starved by frame jobs
+		for (unsigned int i = 0; i < LockFreeJobQueue::AgingThreshold; i++)
+		{
+			jobQueue.ExecuteNextJob();
+			ASSERT_FALSE(idleJobExecuted);
+		}
+		jobQueue.ExecuteNextJob();
+		ASSERT_TRUE(idleJobExecuted);
+		ASSERT_EQ(jobQueue.Count(JobPriority::Frame), LockFreeJobQueue::AgingThreshold);
+	}
+
+	// GetAgedJob() with a low priority job passed over for jobs taken from elsewhere
+	TEST(LockFreeJobQueueTests, GetAgedJob_PassOver)
+	{
+		// Create Job Queue, with an idle job and a frame job queued
+		LockFreeJobQueue jobQueue;
+		bool idleJobExecuted = false;
+		jobQueue.AddJob(JobRecord::Create([&idleJobExecuted] { idleJobExecuted = true; }), JobPriority::Idle);
+		jobQueue.AddJob(JobRecord::Create([] {}), JobPriority::Frame);
+
+		// Ensure the idle job is only taken once passed over enough times, and never the frame job
+		for (unsigned int i = 0; i < LockFreeJobQueue::AgingThreshold; i++)
+		{
+			ASSERT_EQ(jobQueue.GetAgedJob(), nullptr);
+			jobQueue.PassOver(JobPriority::Frame);
+		}
+		ASSERT_EQ(jobQueue.GetAgedJob(JobPriority::Background), nullptr);
+		JobRecord* record = jobQueue.GetAgedJob();
+		ASSERT_NE(record, nullptr);
+		JobRecord::Execute(record);
+		ASSERT_TRUE(idleJobExecuted);
+		ASSERT_EQ(jobQueue.GetAgedJob(), nullptr);
+		ASSERT_EQ(jobQueue.Count(JobPriority::Frame), 1);
+	}
+
+	// Ensures jobs added by many threads are each executed once by many threads
+	TEST(LockFreeJobQueueTests, Threaded)
+	{
+		constexpr int ThreadCount	= 4;
+		constexpr int JobCount		= 4000;
+		LockFreeJobQueue jobQueue(16);
+
+		std::atomic_int executedCount = 0;
+		std::vector<std::thread> threads;
+		for (int thread = 0; thread < ThreadCount; thread++)
+		{
+			threads.emplace_back([&jobQueue, &executedCount]
+			{
+				for (int i = 0; i < JobCount / ThreadCount; i++)
+				{
+					jobQueue.AddJob(JobRecord::Create([&executedCount] { executedCount++; }));
+				}
+			});
+			threads.emplace_back([&jobQueue, &executedCount]
+			{
+				while (executedCount.load() < JobCount)
+				{
+					jobQueue.ExecuteNextJob();
+				}
+			});
+		}
+		for (size_t i = 0; i < threads.size(); i++)
+		{
+			threads[i].join();
+		}
+
+		ASSERT_EQ(executedCount.load(), JobCount);
+		ASSERT_TRUE(jobQueue.IsEmpty());
+	}
+
+	// Clear() normal usage
+	TEST(LockFreeJobQueueTests, Clear)
+	{
+		LockFreeJobQueue jobQueue(2);
+		bool isExecuted = false;
+		for (int i = 0; i < 4; i++)
+		{
+			jobQueue.AddJob(JobRecord::Create([&isExecuted] { isExecuted = true; }), JobPriority::Idle);
+		}
+		ASSERT_EQ(jobQueue.Count(), 4);
+
+		// Ensure jobs are discarded without executing
+		jobQueue.Clear();
+		ASSERT_TRUE(jobQueue.IsEmpty());
+		ASSERT_EQ(jobQueue.Count(JobPriority::Idle), 0);
+		ASSERT_FALSE(isExecuted);
+	}
+}
@@ -0,0 +1,148 @@
+#include <Engine/Jobs/Task.hpp>
+
+// STL includes
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+// Google Test includes
+#include <gtest/gtest.h>
+
+namespace AndGen::Tests
+{
+	// Returns a value without suspending
+	Task<int> ReturnValue(int value)
+	{
+		co_return value;
+	}
+
+	// Awaits a child task, and adds to its value
+	Task<int> AwaitChild(int value)
+	{
+		int childValue = co_await ReturnValue(value);
+		co_return childValue + 1;
+	}
+
+	// Moves onto a thread pool, and returns the thread it resumed on
+	Task<std::thread::id> ResumeOnPool(ThreadPool& threadPool)
+	{
+		co_await ResumeOn(threadPool);
+		co_return std::this_thread::get_id();
+	}
+
+	// Squares a value on a thread pool
+	Task<int> Square(ThreadPool& threadPool, int value)
+	{
+		co_await ResumeOn(threadPool);
+		co_return value * value;
+	}
+
+	// Increments a counter
+	Task<> Increment(std::atomic_int& counter)
+	{
+		counter++;
+		co_return;
+	}
+
+	// Throws from within a task
+	Task<int> Throw()
+	{
+		throw std::runtime_error("Task failed");
+		co_return 0;
+	}
+
+	// Normal usage of co_await on a task
+	TEST(TaskTests, Await)
+	{
+		ThreadPool threadPool(2);
+
+		// Ensure child's value was returned to the awaiting task
+		ASSERT_EQ(WaitForTask(threadPool, AwaitChild(41)), 42);
+	}
+
+	// Normal usage of ResumeOn()
+	TEST(TaskTests, ResumeOn)
+	{
+		ThreadPool threadPool(2);
+
+		// Ensure task resumed on one of the pool's threads, or the waiting thread helping it
+		std::thread::id threadId = WaitForTask(threadPool, ResumeOnPool(threadPool));
+		ASSERT_NE(threadId, std::thread::id());
+	}
+
+	// Normal usage of WhenAll() with tasks returning values
+	TEST(TaskTests, WhenAll)
+	{
+		ThreadPool threadPool(4);
+
+		auto squareAll = [&threadPool]() -> Task<std::vector<int>>
+		{
+			std::vector<Task<int>> tasks;
+			for (int i = 0; i < 64; i++)
+			{
+				tasks.push_back(Square(threadPool, i));
+			}
+
+			co_return co_await WhenAll(threadPool, std::move(tasks));
+		};
+
+		// Ensure every value was returned in order
+		std::vector<int> values = WaitForTask(threadPool, squareAll());
+		ASSERT_EQ(values.size(), 64);
+		for (int i = 0; i < 64; i++)
+		{
+			ASSERT_EQ(values[i], i * i);
+		}
+	}
+
+	// WhenAll() with tasks returning no value
+	TEST(TaskTests, WhenAll_Void)
+	{
+		ThreadPool threadPool(4);
+		std::atomic_int counter = 0;
+
+		auto incrementAll = [&threadPool, &counter]() -> Task<>
+		{
+			std::vector<Task<>> tasks;
+			for (int i = 0; i < 100; i++)
+			{
+				tasks.push_back(Increment(counter));
+			}
+
+			co_await WhenAll(threadPool, std::move(tasks));
+		};
+
+		// Ensure every task was executed before WhenAll() resumed
+		WaitForTask(threadPool, incrementAll());
+		ASSERT_EQ(counter, 100);
+	}
+
+	// Exception thrown by an awaited task
+	TEST(TaskTests, Await_Exception)
+	{
+		ThreadPool threadPool(2);
+
+		auto awaitThrow = []() -> Task<int>
+		{
+			co_return co_await Throw();
+		};
+
+		// Ensure exception was propagated through the awaiting task
+		ASSERT_THROW(WaitForTask(threadPool, awaitThrow()), std::runtime_error);
+	}
+
+	// Normal usage of TaskFrameAllocator
+	TEST(TaskTests, FrameAllocator_Reused)
+	{
+		// Ensure a released frame is reused by the next allocation of the same size class
+		void* frame = TaskFrameAllocator::Allocate(200);
+		TaskFrameAllocator::Deallocate(frame, 200);
+		ASSERT_EQ(TaskFrameAllocator::Allocate(256), frame);
+		TaskFrameAllocator::Deallocate(frame, 256);
+
+		// Ensure oversized frames are allocated directly
+		void* largeFrame = TaskFrameAllocator::Allocate(TaskFrameAllocator::MaxPooledSize + 1);
+		ASSERT_NE(largeFrame, nullptr);
+		TaskFrameAllocator::Deallocate(largeFrame, TaskFrameAllocator::MaxPooledSize + 1);
+	}
+}
@@ -0,0 +1,58 @@
+#include <Engine/Parallelism/Barrier.hpp>
+
+// STL includes
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+// Google Test includes
+#include <gtest/gtest.h>
+
+namespace AndGen::Tests
+{
+	// Normal usage of ArriveAndWait(), over several phases
+	TEST(BarrierTests, ArriveAndWait)
+	{
+		constexpr std::uint32_t threadCount	= 4;
+		constexpr int phaseCount			= 100;
+		Barrier barrier(threadCount);
+
+		// Each thread increments the counter once per phase, and checks all threads did so before continuing
+		std::atomic_int counter = 0;
+		std::atomic_int lastArrivalCount = 0;
+		std::vector<std::thread> threads;
+		for (std::uint32_t i = 0; i < threadCount; i++)
+		{
+			threads.emplace_back([&barrier, &counter, &lastArrivalCount]
+				{
+					for (int phase = 0; phase < phaseCount; phase++)
+					{
+						counter++;
+						if (barrier.ArriveAndWait())
+						{
+							lastArrivalCount++;
+						}
+						ASSERT_GE(counter, (phase + 1) * static_cast<int>(threadCount));
+
+						// Ensure no thread starts the next phase before all have checked this phase
+						barrier.ArriveAndWait();
+					}
+				});
+		}
+		for (size_t i = 0; i < threads.size(); i++)
+		{
+			threads[i].join();
+		}
+
+		// Ensure a single thread completed each phase
+		ASSERT_EQ(counter, phaseCount * static_cast<int>(threadCount));
+		ASSERT_EQ(lastArrivalCount, phaseCount);
+		ASSERT_EQ(barrier.Phase(), static_cast<std::uint32_t>(phaseCount * 2));
+	}
+
+	// Constructor with no threads
+	TEST(BarrierTests, Constructor_NoThreads)
+	{
+		ASSERT_THROW(Barrier(0), std::invalid_argument);
+	}
+}
@@ -0,0 +1,124 @@
+#include <Engine/Parallelism/BoundedMpmcQueue.hpp>
+
+// STL includes
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+// Google Test includes
+#include <gtest/gtest.h>
+
+namespace AndGen::Tests
+{
+	// Normal usage of TryPush() and TryPop()
+	TEST(BoundedMpmcQueueTests, PushPop)
+	{
+		BoundedMpmcQueue<int> queue(4);
+		ASSERT_TRUE(queue.IsEmpty());
+		ASSERT_EQ(queue.Capacity(), 4);
+
+		// Push items
+		ASSERT_TRUE(queue.TryPush(1));
+		ASSERT_TRUE(queue.TryPush(2));
+		ASSERT_TRUE(queue.TryPush(3));
+		ASSERT_EQ(queue.Count(), 3);
+
+		// Ensure items are popped in FIFO order
+		int item = 0;
+		ASSERT_TRUE(queue.TryPop(item));
+		ASSERT_EQ(item, 1);
+		ASSERT_TRUE(queue.TryPop(item));
+		ASSERT_EQ(item, 2);
+		ASSERT_TRUE(queue.TryPop(item));
+		ASSERT_EQ(item, 3);
+
+		// Ensure queue is now empty
+		ASSERT_FALSE(queue.TryPop(item));
+		ASSERT_TRUE(queue.IsEmpty());
+	}
+
+	// Ensures pushing fails once the queue is full, and slots are reused once popped
+	TEST(BoundedMpmcQueueTests, TryPush_Full)
+	{
+		BoundedMpmcQueue<int> queue(3);
+		ASSERT_EQ(queue.Capacity(), 4);
+
+		for (int i = 0; i < 4; i++)
+		{
+			ASSERT_TRUE(queue.TryPush(i));
+		}
+		ASSERT_FALSE(queue.TryPush(4));
+		ASSERT_EQ(queue.Count(), 4);
+
+		// Wrap around the ring several times
+		int item = 0;
+		for (int i = 0; i < 12; i++)
+		{
+			ASSERT_TRUE(queue.TryPop(item));
+			ASSERT_EQ(item, i);
+			ASSERT_TRUE(queue.TryPush(i + 4));
+		}
+	}
+
+	// Ensures each item pushed by many producers is popped exactly once by many consumers
+	TEST(BoundedMpmcQueueTests, Threaded)
+	{
+		constexpr int ThreadCount	= 4;
+		constexpr int ItemCount		= 10000;
+		BoundedMpmcQueue<int> queue(64);
+
+		std::vector<std::vector<int>> popped(ThreadCount);
+		std::atomic_int poppedCount = 0;
+		std::vector<std::thread> threads;
+		for (int thread = 0; thread < ThreadCount; thread++)
+		{
+			// Producer, retrying while the queue is full
+			threads.emplace_back([&queue, thread]
+			{
+				for (int i = thread; i < ItemCount; i += ThreadCount)
+				{
+					while (!queue.TryPush(i))
+					{
+						std::this_thread::yield();
+					}
+				}
+			});
+
+			// Consumer, until every item has been popped
+			threads.emplace_back([&queue, &popped, &poppedCount, thread]
+			{
+				int item = 0;
+				while (poppedCount.load() < ItemCount)
+				{
+					if (queue.TryPop(item))
+					{
+						popped[thread].push_back(item);
+						poppedCount++;
+					}
+					else
+					{
+						std::this_thread::yield();
+					}
+				}
+			});
+		}
+		for (size_t i = 0; i < threads.size(); i++)
+		{
+			threads[i].join();
+		}
+
+		// Ensure every item was popped once
+		std::vector<int> items;
+		for (int thread = 0; thread < ThreadCount; thread++)
+		{
+			items.insert(items.end(), popped[thread].begin(), popped[thread].end());
+		}
+		std::sort(items.begin(), items.end());
+		ASSERT_EQ(items.size(), ItemCount);
+		for (int i = 0; i < ItemCount; i++)
+		{
+			ASSERT_EQ(items[i], i);
+		}
+		ASSERT_TRUE(queue.IsEmpty());
+	}
+}
@@ -0,0 +1,168 @@
+#include <Engine/Parallelism/CpuTopology.hpp>
+
+// STL includes
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+// Google Test includes
+#include <gtest/gtest.h>
+
+namespace AndGen::Tests
+{
+	/// <summary>
+	/// Test fixture, which builds a sysfs CPU directory for a single package with 4 cores of 2 hardware threads.
+	/// Cores 0 and 1 have their own L2 caches, cores 2 and 3 share an L2 cache,
+	/// and each pair of cores shares an L3 cache.
+	/// </summary>
+	class CpuTopologyTests : public ::testing::Test
+	{
+	protected:
+		std::filesystem::path m_sysfsPath;
+
+		/// <summary>
+		/// Per-test Set Up
+		/// </summary>
+		virtual void SetUp() override final
+		{
+			m_sysfsPath = std::filesystem::temp_directory_path() /
+				("AndGenCpuTopologyTests" + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())));
+			std::filesystem::remove_all(m_sysfsPath);
+
+			WriteFile("online", "0-7");
+			for (unsigned int cpu = 0; cpu < 8; cpu++)
+			{
+				unsigned int core		= cpu % 4;
+				std::string cpuPath		= "cpu" + std::to_string(cpu);
+				std::string siblings	= std::to_string(core) + "," + std::to_string(core + 4);
+				std::string l2Shared	= core < 2 ? siblings : "2-3,6-7";
+				std::string l3Shared	= core < 2 ? "0-1,4-5" : "2-3,6-7";
+
+				WriteFile(cpuPath + "/topology/physical_package_id", "0");
+				WriteFile(cpuPath + "/topology/thread_siblings_list", siblings);
+				WriteCache(cpuPath + "/cache/index0", 1, "Data", siblings);
+				WriteCache(cpuPath + "/cache/index1", 1, "Instruction", siblings);
+				WriteCache(cpuPath + "/cache/index2", 2, "Unified", l2Shared);
+				WriteCache(cpuPath + "/cache/index3", 3, "Unified", l3Shared);
+			}
+		}
+
+		/// <summary>
+		/// Per-test Tear Down
+		/// </summary>
+		virtual void TearDown() override final
+		{
+			std::filesystem::remove_all(m_sysfsPath);
+		}
+
+		/// <summary>
+		/// Writes a single line file within the sysfs directory
+		/// </summary>
+		void WriteFile(const std::string& path, const std::string& contents)
+		{
+			std::filesystem::path filePath = m_sysfsPath / path;
+			std::filesystem::create_directories(filePath.parent_path());
+			std::ofstream(filePath) << contents << '\n';
+		}
+
+		/// <summary>
+		/// Writes a cache's description within the sysfs directory
+		/// </summary>
+		void WriteCache(const std::string& path, unsigned int level, const std::string& type,
+			const std::string& sharedCpus)
+		{
+			WriteFile(path + "/level", std::to_string(level));
+			WriteFile(path + "/type", type);
+			WriteFile(path + "/shared_cpu_list", sharedCpus);
+		}
+	};
+
+	// Normal usage of CpuTopology(sysfsPath)
+	TEST_F(CpuTopologyTests, Constructor)
+	{
+		CpuTopology topology(m_sysfsPath.string());
+
+		// Ensure each CPU's core and caches are read
+		const std::vector<CpuTopology::Cpu>& cpus = topology.GetCpus();
+		ASSERT_EQ(cpus.size(), 8);
+		for (unsigned int i = 0; i < cpus.size(); i++)
+		{
+			ASSERT_EQ(cpus[i].id, i);
+			ASSERT_EQ(cpus[i].core, i % 4);
+			ASSERT_EQ(cpus[i].package, 0);
+			ASSERT_EQ(cpus[i].l2Group, i % 4 < 2 ? i % 4 : 2);
+			ASSERT_EQ(cpus[i].l3Group, i % 4 < 2 ? 0 : 2);
+		}
+		ASSERT_EQ(topology.PhysicalCoreCount(), 4);
+	}
+
+	// Ensures a topology is still available when sysfs can't be read
+	TEST_F(CpuTopologyTests, Constructor_MissingSysfs)
+	{
+		CpuTopology topology((m_sysfsPath / "missing").string());
+
+		// Ensure each hardware thread is treated as its own core
+		size_t cpuCount = std::max(1u, std::thread::hardware_concurrency());
+		ASSERT_EQ(topology.GetCpus().size(), cpuCount);
+		ASSERT_EQ(topology.PhysicalCoreCount(), cpuCount);
+	}
+
+	// Normal usage of GetDistance()
+	TEST_F(CpuTopologyTests, GetDistance)
+	{
+		CpuTopology topology(m_sysfsPath.string());
+
+		ASSERT_EQ(topology.GetDistance(1, 1), CpuTopology::Distance::SameCpu);
+		ASSERT_EQ(topology.GetDistance(1, 5), CpuTopology::Distance::SameCore);
+		ASSERT_EQ(topology.GetDistance(2, 7), CpuTopology::Distance::SameL2);
+		ASSERT_EQ(topology.GetDistance(0, 5), CpuTopology::Distance::SameL3);
+		ASSERT_EQ(topology.GetDistance(1, 2), CpuTopology::Distance::SamePackage);
+		ASSERT_EQ(topology.GetDistance(0, 8), CpuTopology::Distance::Remote);
+	}
+
+	// Normal usage of SelectCpus()
+	TEST_F(CpuTopologyTests, SelectCpus)
+	{
+		CpuTopology topology(m_sysfsPath.string());
+
+		// Ensure every core is given a thread before any core is given a second,
+		// and CPUs are reused once each has a thread
+		std::vector<unsigned int> expectedCpus = { 0, 1, 2, 3, 4, 5, 6, 7, 0, 1 };
+		ASSERT_EQ(topology.SelectCpus(10), expectedCpus);
+		ASSERT_TRUE(topology.SelectCpus(0).empty());
+	}
+
+	// Ensures the reserved CPU's core is used last
+	TEST_F(CpuTopologyTests, SelectCpus_Reserved)
+	{
+		CpuTopology topology(m_sysfsPath.string());
+
+		std::vector<unsigned int> expectedCpus = { 0, 2, 3, 4, 6, 7, 1, 5 };
+		ASSERT_EQ(topology.SelectCpus(8, 5), expectedCpus);
+	}
+
+	// Ensures higher capacity cores are selected first
+	TEST_F(CpuTopologyTests, SelectCpus_Capacity)
+	{
+		for (unsigned int cpu = 0; cpu < 8; cpu++)
+		{
+			WriteFile("cpu" + std::to_string(cpu) + "/cpu_capacity", cpu % 4 < 2 ? "512" : "1024");
+		}
+		CpuTopology topology(m_sysfsPath.string());
+
+		std::vector<unsigned int> expectedCpus = { 2, 3, 0, 1 };
+		ASSERT_EQ(topology.SelectCpus(4), expectedCpus);
+	}
+
+	// Normal usage of Get()
+	TEST_F(CpuTopologyTests, Get)
+	{
+		// Ensure the process can execute on at least one of the CPUs found
+		const CpuTopology& topology = CpuTopology::Get();
+		ASSERT_FALSE(topology.GetCpus().empty());
+		ASSERT_GE(topology.PhysicalCoreCount(), 1);
+		ASSERT_EQ(&topology, &CpuTopology::Get());
+	}
+}
@@ -0,0 +1,93 @@
+#include <Engine/Parallelism/Fiber.hpp>
+
+// STL includes
+#include <vector>
+// Google Test includes
+#include <gtest/gtest.h>
+
+namespace AndGen::Tests
+{
+	/// <summary>
+	/// State shared between a test and the fiber it creates
+	/// </summary>
+	struct FiberTestState
+	{
+		Fiber* threadFiber	= nullptr;
+		Fiber* fiber		= nullptr;
+		std::vector<int> steps;
+	};
+
+	// Normal usage of SwitchTo()
+	TEST(FiberTests, SwitchTo)
+	{
+		if (!Fiber::IsSupported())
+		{
+			return;
+		}
+
+		FiberTestState state;
+		Fiber threadFiber;
+		Fiber fiber([](void* argument)
+		{
+			// Record steps on the fiber's own stack, switching back to the thread between each
+			FiberTestState& state = *static_cast<FiberTestState*>(argument);
+			for (int i = 0;; i++)
+			{
+				state.steps.push_back(i * 2 + 1);
+				state.fiber->SwitchTo(*state.threadFiber);
+			}
+		}, &state);
+		state.threadFiber	= &threadFiber;
+		state.fiber			= &fiber;
+
+		// Alternate between this thread and the fiber
+		for (int i = 0; i < 3; i++)
+		{
+			state.steps.push_back(i * 2);
+			threadFiber.SwitchTo(fiber);
+		}
+
+		// Ensure steps were recorded in order
+		ASSERT_EQ(state.steps, std::vector<int>({ 0, 1, 2, 3, 4, 5 }));
+	}
+
+	// SwitchTo() with fibers using floating point and deep stacks
+	TEST(FiberTests, SwitchTo_PreservesState)
+	{
+		if (!Fiber::IsSupported())
+		{
+			return;
+		}
+
+		FiberTestState state;
+		Fiber threadFiber;
+		Fiber fiber([](void* argument)
+		{
+			FiberTestState& state = *static_cast<FiberTestState*>(argument);
+
+			// Use a large part of the fiber's stack
+			volatile char buffer[64 * 1024];
+			buffer[0] = 1;
+			buffer[sizeof(buffer) - 1] = 1;
+
+			for (;;)
+			{
+				state.steps.push_back(buffer[0] + buffer[sizeof(buffer) - 1]);
+				state.fiber->SwitchTo(*state.threadFiber);
+			}
+		}, &state);
+		state.threadFiber	= &threadFiber;
+		state.fiber			= &fiber;
+
+		// Ensure values held across a switch are preserved
+		double value = 1.5;
+		for (int i = 0; i < 4; i++)
+		{
+			double before = value * 3.0;
+			threadFiber.SwitchTo(fiber);
+			ASSERT_EQ(before, value * 3.0);
+			value += 1.0;
+		}
+		ASSERT_EQ(state.steps, std::vector<int>({ 2, 2, 2, 2 }));
+	}
+}
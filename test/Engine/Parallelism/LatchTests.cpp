@@ -0,0 +1,69 @@
+#include <Engine/Parallelism/Latch.hpp>
+
+// STL includes
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+// Google Test includes
+#include <gtest/gtest.h>
+
+namespace AndGen::Tests
+{
+	// Normal usage of CountDown() and Wait()
+	TEST(LatchTests, Wait)
+	{
+		Latch latch(3);
+
+		// Start threads waiting on the latch
+		std::atomic_int releasedCount = 0;
+		std::vector<std::thread> threads;
+		for (size_t i = 0; i < 4; i++)
+		{
+			threads.emplace_back([&latch, &releasedCount]
+				{
+					latch.Wait();
+					releasedCount++;
+				});
+		}
+
+		// Ensure threads stay blocked until the latch reaches zero
+		latch.CountDown();
+		latch.CountDown();
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		ASSERT_FALSE(latch.TryWait());
+		ASSERT_EQ(releasedCount, 0);
+
+		latch.CountDown();
+		for (size_t i = 0; i < threads.size(); i++)
+		{
+			threads[i].join();
+		}
+		ASSERT_TRUE(latch.TryWait());
+		ASSERT_EQ(releasedCount, 4);
+	}
+
+	// ArriveAndWait() from every counted thread
+	TEST(LatchTests, ArriveAndWait)
+	{
+		Latch latch(4);
+
+		std::atomic_int arrivedCount = 0;
+		std::vector<std::thread> threads;
+		for (size_t i = 0; i < 4; i++)
+		{
+			threads.emplace_back([&latch, &arrivedCount]
+				{
+					arrivedCount++;
+					latch.ArriveAndWait();
+
+					// Ensure every thread arrived before any was released
+					ASSERT_EQ(arrivedCount, 4);
+				});
+		}
+		for (size_t i = 0; i < threads.size(); i++)
+		{
+			threads[i].join();
+		}
+	}
+}
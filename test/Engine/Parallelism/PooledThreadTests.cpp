@@ -1,10 +1,12 @@
 #include <Engine/Parallelism/PooledThread.hpp>
 
 // STL includes
+#include <array>
 #include <chrono>
 #include <memory>
 // AndGen includes
 #include <AndGen/Engine/Jobs/Job.hpp>
+#include <Engine/Jobs/JobRecord.hpp>
 // AndGen test includes
 #include "TimedJob.hpp"
 // Google Test includes
@@ -96,6 +98,66 @@ namespace AndGen::Tests
 		ASSERT_EQ(m_pooledThread->GetQueue().Count(), 0);
 	}
 
+	// Normal usage of QueueJobs()
+	TEST_F(PooledThreadTests, QueueJobs)
+	{
+		// Create Pooled Thread
+		m_pooledThread = std::make_unique<PooledThread>();
+
+		// Queue batch of jobs, without starting the thread
+		std::array<std::shared_ptr<TimedJob>, 3> jobs;
+		std::array<JobRecord*, 3> records;
+		for (size_t i = 0; i < jobs.size(); i++)
+		{
+			jobs[i]		= CreateJob();
+			records[i]	= JobRecord::Create(std::static_pointer_cast<Job>(jobs[i]));
+		}
+		m_pooledThread->QueueJobs(records.data(), records.size());
+
+		// Ensure all jobs were added to the queue
+		ASSERT_EQ(m_pooledThread->GetQueue().Count(), jobs.size());
+		ASSERT_EQ(m_pooledThread->PendingJobsCount(), jobs.size());
+	}
+
+	// PushLocalJob() from a thread other than the pooled thread
+	TEST_F(PooledThreadTests, PushLocalJob_OtherThread)
+	{
+		// Create Pooled Thread
+		m_pooledThread = std::make_unique<PooledThread>();
+
+		// Push job from this thread, which doesn't own the deque
+		std::shared_ptr<TimedJob> job = CreateJob();
+		m_pooledThread->PushLocalJob(job);
+
+		// Ensure job was added to the queue instead
+		ASSERT_EQ(m_pooledThread->GetQueue().Count(), 1);
+		ASSERT_EQ(m_pooledThread->PendingJobsCount(), 1);
+	}
+
+	// Normal usage of StealJob()
+	TEST_F(PooledThreadTests, StealJob)
+	{
+		// Create Pooled Thread
+		m_pooledThread = std::make_unique<PooledThread>();
+
+		// Queue job, without starting the thread
+		std::shared_ptr<TimedJob> job = CreateJob();
+		m_pooledThread->QueueJob(job);
+
+		// Ensure job can be stolen
+		JobRecord* stolenRecord = nullptr;
+		ASSERT_TRUE(m_pooledThread->StealJob(stolenRecord));
+		ASSERT_EQ(m_pooledThread->PendingJobsCount(), 0);
+
+		// Ensure stolen record executes the queued job
+		job->canExecute = true;
+		JobRecord::Execute(stolenRecord);
+		ASSERT_TRUE(job->IsCompleted());
+
+		// Ensure no more jobs can be stolen
+		ASSERT_FALSE(m_pooledThread->StealJob(stolenRecord));
+	}
+
 	// Normal usage of Start()
 	TEST_F(PooledThreadTests, Start)
 	{
@@ -247,6 +309,28 @@ namespace AndGen::Tests
 		ASSERT_EQ(m_pooledThread->GetQueue().Count(), 0);
 	}
 
+	// ClearQueue() releases the counters of the jobs discarded
+	TEST_F(PooledThreadTests, ClearQueue_Counters)
+	{
+		// Create pooled thread, without starting it
+		m_pooledThread = std::make_unique<PooledThread>();
+
+		// Add a function and a job to queue
+		JobCounter counter;
+		counter.Increment();
+		bool functionExecuted = false;
+		m_pooledThread->QueueJob(JobRecord::Create([&functionExecuted] { functionExecuted = true; }, &counter));
+		std::shared_ptr<TimedJob> job = CreateJob();
+		m_pooledThread->QueueJob<TimedJob>(job);
+
+		// Ensure both jobs are discarded without executing
+		ASSERT_EQ(m_pooledThread->ClearQueue(), 2);
+		ASSERT_FALSE(functionExecuted);
+		ASSERT_TRUE(counter.IsComplete());
+		ASSERT_TRUE(job->IsCompleted());
+		ASSERT_TRUE(job->IsCancelled());
+	}
+
 	// Usage of ClearQueue with an empty queue
 	TEST_F(PooledThreadTests, ClearQueue_Empty)
 	{
@@ -0,0 +1,64 @@
+#include <Engine/Parallelism/Semaphore.hpp>
+
+// STL includes
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+// Google Test includes
+#include <gtest/gtest.h>
+
+namespace AndGen::Tests
+{
+	// Normal usage of TryAcquire() and Release()
+	TEST(SemaphoreTests, TryAcquire)
+	{
+		Semaphore semaphore(2);
+
+		// Ensure count can only be acquired while above zero
+		ASSERT_TRUE(semaphore.TryAcquire());
+		ASSERT_TRUE(semaphore.TryAcquire());
+		ASSERT_FALSE(semaphore.TryAcquire());
+
+		semaphore.Release();
+		ASSERT_EQ(semaphore.Count(), 1);
+		ASSERT_TRUE(semaphore.TryAcquire());
+	}
+
+	// Acquire() blocking until released
+	TEST(SemaphoreTests, Acquire)
+	{
+		Semaphore semaphore;
+
+		// Start threads waiting on the semaphore
+		std::atomic_int acquiredCount = 0;
+		std::vector<std::thread> threads;
+		for (size_t i = 0; i < 4; i++)
+		{
+			threads.emplace_back([&semaphore, &acquiredCount]
+				{
+					semaphore.Acquire();
+					acquiredCount++;
+				});
+		}
+
+		// Ensure threads block until released, and each release lets a single thread through
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		ASSERT_EQ(acquiredCount, 0);
+		semaphore.Release();
+		while (acquiredCount < 1)
+		{
+			std::this_thread::yield();
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		ASSERT_EQ(acquiredCount, 1);
+
+		semaphore.Release(3);
+		for (size_t i = 0; i < threads.size(); i++)
+		{
+			threads[i].join();
+		}
+		ASSERT_EQ(acquiredCount, 4);
+		ASSERT_EQ(semaphore.Count(), 0);
+	}
+}
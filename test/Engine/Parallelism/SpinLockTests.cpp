@@ -0,0 +1,53 @@
+#include <Engine/Parallelism/SpinLock.hpp>
+
+// STL includes
+#include <mutex>
+#include <thread>
+#include <vector>
+// Google Test includes
+#include <gtest/gtest.h>
+
+namespace AndGen::Tests
+{
+	// Normal usage of Lock() and Unlock()
+	TEST(SpinLockTests, Lock)
+	{
+		SpinLock spinLock;
+
+		// Increment a shared counter from several threads under the lock
+		constexpr int incrementCount = 10000;
+		int counter = 0;
+		std::vector<std::thread> threads;
+		for (size_t i = 0; i < 4; i++)
+		{
+			threads.emplace_back([&spinLock, &counter]
+				{
+					for (int j = 0; j < incrementCount; j++)
+					{
+						std::scoped_lock<SpinLock> lock(spinLock);
+						counter++;
+					}
+				});
+		}
+		for (size_t i = 0; i < threads.size(); i++)
+		{
+			threads[i].join();
+		}
+
+		// Ensure no increments were lost
+		ASSERT_EQ(counter, incrementCount * 4);
+		ASSERT_FALSE(spinLock.IsLocked());
+	}
+
+	// TryLock() while locked
+	TEST(SpinLockTests, TryLock)
+	{
+		SpinLock spinLock;
+
+		ASSERT_TRUE(spinLock.TryLock());
+		ASSERT_FALSE(spinLock.TryLock());
+		spinLock.Unlock();
+		ASSERT_TRUE(spinLock.TryLock());
+		spinLock.Unlock();
+	}
+}
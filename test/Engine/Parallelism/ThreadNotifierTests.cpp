@@ -1,6 +1,8 @@
 #include <Engine/Parallelism/ThreadNotifier.hpp>
 
 // STL includes
+#include <atomic>
+#include <chrono>
 #include <thread>
 // Google Test includes
 #include <gtest/gtest.h>
@@ -76,4 +78,29 @@ namespace AndGen::Tests
 		ASSERT_TRUE(notified);
 		ASSERT_TRUE(waitSuccessful);
 	}
+
+	// Wait() after a notification has already been consumed
+	TEST(ThreadNotifierTests, Wait_Consumed)
+	{
+		AndGen::ThreadNotifier threadNotifier;
+
+		// Consume notification given before waiting
+		threadNotifier.Notify();
+		threadNotifier.Wait();
+
+		// Start waiting thread, which must block until notified again
+		std::atomic_bool waitSuccessful = false;
+		std::thread waitingThread([&threadNotifier, &waitSuccessful]
+			{
+				threadNotifier.Wait();
+				waitSuccessful = true;
+			});
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		ASSERT_FALSE(waitSuccessful);
+
+		// Notification is kept for the thread if it hasn't begun waiting yet
+		threadNotifier.Notify();
+		waitingThread.join();
+		ASSERT_TRUE(waitSuccessful);
+	}
 }
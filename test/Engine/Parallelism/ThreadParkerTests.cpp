@@ -0,0 +1,82 @@
+#include <Engine/Parallelism/ThreadParker.hpp>
+
+// STL includes
+#include <atomic>
+#include <chrono>
+#include <thread>
+// Google Test includes
+#include <gtest/gtest.h>
+
+namespace AndGen::Tests
+{
+	// Normal usage of Park() and Unpark()
+	TEST(ThreadParkerTests, Park)
+	{
+		ThreadParker threadParker;
+
+		// Start parked thread
+		std::atomic_bool unparked = false;
+		std::thread parkedThread([&threadParker, &unparked]
+			{
+				threadParker.Park();
+				unparked = true;
+			});
+
+		// Ensure thread stays parked until unparked
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		ASSERT_FALSE(unparked);
+		threadParker.Unpark();
+		parkedThread.join();
+
+		ASSERT_TRUE(unparked);
+	}
+
+	// Unpark() before Park()
+	TEST(ThreadParkerTests, Unpark_BeforePark)
+	{
+		ThreadParker threadParker;
+
+		// Ensure unpark isn't lost, and is only consumed once
+		threadParker.Unpark();
+		threadParker.Unpark();
+		threadParker.Park();
+
+		std::atomic_bool unparked = false;
+		std::thread parkedThread([&threadParker, &unparked]
+			{
+				threadParker.Park();
+				unparked = true;
+			});
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		ASSERT_FALSE(unparked);
+		threadParker.Unpark();
+		parkedThread.join();
+	}
+
+	// Normal usage of ParkFor()
+	TEST(ThreadParkerTests, ParkFor)
+	{
+		ThreadParker threadParker;
+
+		// Ensure parking times out without an unpark
+		auto start = std::chrono::steady_clock::now();
+		ASSERT_FALSE(threadParker.ParkFor(std::chrono::milliseconds(10)));
+		ASSERT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(10));
+
+		// Ensure a pending unpark is consumed immediately
+		threadParker.Unpark();
+		ASSERT_TRUE(threadParker.ParkFor(std::chrono::seconds(5)));
+
+		// Ensure an unpark releases the parked thread before the timeout
+		std::atomic_bool unparked = false;
+		std::thread parkedThread([&threadParker, &unparked]
+			{
+				unparked = threadParker.ParkFor(std::chrono::seconds(5));
+			});
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		threadParker.Unpark();
+		parkedThread.join();
+
+		ASSERT_TRUE(unparked);
+	}
+}
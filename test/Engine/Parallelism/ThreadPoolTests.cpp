@@ -1,9 +1,16 @@
 #include <Engine/Parallelism/ThreadPool.hpp>
+#include <Engine/Parallelism/BlockingRegion.hpp>
+#include <Engine/Parallelism/Latch.hpp>
 
 // STL includes
 #include <array>
+#include <atomic>
 #include <algorithm>
+#include <chrono>
+#include <functional>
+#include <stdexcept>
 #include <thread>
+#include <vector>
 // AndGen Tests includes
 #include "TimedJob.hpp"
 // Google Test includes
@@ -54,6 +61,29 @@ namespace AndGen::Tests
 
 			return job;
 		}
+
+		/// <summary>
+		/// Waits for jobs to be completed, or a timeout to elapse
+		/// </summary>
+		/// <returns>
+		/// True if all jobs were completed
+		/// </returns>
+		template<class Iterator>
+		static bool WaitForCompletion(const Iterator beginItr, const Iterator endItr)
+		{
+			auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+			while (std::chrono::steady_clock::now() < timeout)
+			{
+				if (std::all_of(beginItr, endItr, [](const std::shared_ptr<TimedJob>& job) { return job->IsCompleted(); }))
+				{
+					return true;
+				}
+
+				std::this_thread::yield();
+			}
+
+			return false;
+		}
 	};
 	std::vector<std::shared_ptr<TimedJob>> ThreadPoolTests::m_jobs;
 	std::unique_ptr<ThreadPool> ThreadPoolTests::m_threadPool(nullptr);
@@ -67,9 +97,8 @@ namespace AndGen::Tests
 	TEST_F(ThreadPoolTests, GetIdealThreadCount)
 	{
 		// Ensure ideal thread count is:
-		// Hardware thread count - 1 (because of main thread being a separate thread)
-		ASSERT_EQ(ThreadPool::GetIdealThreadCount(),
-			std::max<unsigned int>(0, std::thread::hardware_concurrency() - 1));
+		// Physical core count - 1 (because of main thread being a separate thread)
+		ASSERT_EQ(ThreadPool::GetIdealThreadCount(), CpuTopology::Get().PhysicalCoreCount() - 1);
 	}
 
 	// Full constructor test
@@ -163,6 +192,1165 @@ namespace AndGen::Tests
 		ASSERT_EQ(executionIds.size(), m_threadPool->Size());
 	}
 
+	// QueueJobs() test
+	// with many jobs
+	TEST_F(ThreadPoolTests, QueueJobs_Many)
+	{
+		// Create thread pool
+		m_threadPool = std::make_unique<ThreadPool>(4);
+
+		std::vector<std::shared_ptr<TimedJob>> jobs(10000);
+		m_jobs.reserve(jobs.size());
+		for (size_t i = 0; i < jobs.size(); i++)
+		{
+			jobs[i] = CreateJob();
+			jobs[i]->canExecute = true;
+		}
+
+		// Enqueue jobs to thread pool, and wait for them
+		JobCounter counter;
+		m_threadPool->QueueJobs(jobs.begin(), jobs.end(), &counter);
+		m_threadPool->Wait(counter);
+
+		// Ensure all jobs were completed
+		for (size_t i = 0; i < jobs.size(); i++)
+		{
+			ASSERT_TRUE(jobs[i]->IsCompleted());
+		}
+	}
+
+	// QueueJobs() test
+	// called from within a job executing on one of the pool's threads
+	TEST_F(ThreadPoolTests, QueueJobs_FromPoolThread)
+	{
+		// Create thread pool
+		m_threadPool = std::make_unique<ThreadPool>(4);
+
+		std::array<std::shared_ptr<TimedJob>, 64> jobs;
+		m_jobs.reserve(jobs.size());
+		for (size_t i = 0; i < jobs.size(); i++)
+		{
+			jobs[i] = CreateJob();
+			jobs[i]->canExecute = true;
+		}
+
+		// Enqueue jobs from one of the pool's threads, and wait for them
+		JobCounter counter;
+		m_threadPool->QueueJob([&jobs, &counter]
+		{
+			m_threadPool->QueueJobs(jobs.begin(), jobs.end(), &counter);
+		}, &counter);
+		m_threadPool->Wait(counter);
+
+		// Ensure all jobs were completed
+		for (size_t i = 0; i < jobs.size(); i++)
+		{
+			ASSERT_TRUE(jobs[i]->IsCompleted());
+		}
+	}
+
+	// QueueJob() test
+	// with jobs queued behind a job which doesn't complete
+	TEST_F(ThreadPoolTests, QueueJob_StealsFromBusyThread)
+	{
+		// Create thread pool
+		m_threadPool = std::make_unique<ThreadPool>(2);
+
+		// Create job which blocks the first thread
+		std::shared_ptr<TimedJob> blockingJob = CreateJob();
+		// Create jobs, which will be distributed between both threads
+		std::array<std::shared_ptr<TimedJob>, 3> jobs;
+		m_jobs.reserve(jobs.size() + 1);
+		for (size_t i = 0; i < jobs.size(); i++)
+		{
+			jobs[i] = CreateJob();
+			jobs[i]->canExecute = true;
+		}
+
+		// Enqueue jobs to thread pool
+		m_threadPool->QueueJob(blockingJob);
+		m_threadPool->QueueJobs(jobs.begin(), jobs.end());
+
+		// Wait for jobs to be completed by the thread which isn't blocked
+		bool allCompleted = WaitForCompletion(jobs.begin(), jobs.end());
+
+		// Ensure jobs queued behind the blocking job were stolen and completed
+		ASSERT_TRUE(allCompleted);
+		ASSERT_FALSE(blockingJob->IsCompleted());
+	}
+
+	// QueueJob() test
+	// with jobs depending on each other
+	TEST_F(ThreadPoolTests, QueueJob_Dependencies)
+	{
+		// Create thread pool
+		m_threadPool = std::make_unique<ThreadPool>(4);
+
+		// Create jobs forming a diamond shape,
+		// where the last job depends on two jobs both depending on the first job
+		std::array<std::shared_ptr<TimedJob>, 4> jobs;
+		m_jobs.reserve(jobs.size());
+		for (size_t i = 0; i < jobs.size(); i++)
+		{
+			jobs[i] = CreateJob();
+			jobs[i]->canExecute = true;
+		}
+		jobs[1]->Schedule(jobs[0]);
+		jobs[2]->Schedule(jobs[0]);
+		jobs[3]->Schedule(std::vector<std::shared_ptr<TimedJob>>{ jobs[1], jobs[2] });
+
+		// Enqueue jobs in reverse order to thread pool
+		m_threadPool->QueueJobs(jobs.rbegin(), jobs.rend());
+
+		// Ensure all jobs complete
+		ASSERT_TRUE(WaitForCompletion(jobs.begin(), jobs.end()));
+		// Ensure jobs didn't start until their dependencies completed
+		ASSERT_LE(jobs[0]->endOfExecution, jobs[1]->startOfExecution);
+		ASSERT_LE(jobs[0]->endOfExecution, jobs[2]->startOfExecution);
+		ASSERT_LE(jobs[1]->endOfExecution, jobs[3]->startOfExecution);
+		ASSERT_LE(jobs[2]->endOfExecution, jobs[3]->startOfExecution);
+	}
+
+	// QueueJob() test
+	// with a job depending on a job which hasn't completed
+	TEST_F(ThreadPoolTests, QueueJob_PendingDependency)
+	{
+		// Create thread pool
+		m_threadPool = std::make_unique<ThreadPool>(2);
+
+		// Create job depending on a job blocked from executing
+		std::shared_ptr<TimedJob> firstJob	= CreateJob();
+		std::shared_ptr<TimedJob> secondJob	= CreateJob();
+		secondJob->canExecute = true;
+		secondJob->Schedule(firstJob);
+
+		// Enqueue jobs to thread pool
+		m_threadPool->QueueJob(secondJob);
+		m_threadPool->QueueJob(firstJob);
+		// Ensure dependencies can't be scheduled once queued
+		ASSERT_THROW(secondJob->Schedule(CreateJob()), std::logic_error);
+
+		// Give enough time for threads to begin executing
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		// Ensure job is held until its dependency completes
+		ASSERT_FALSE(secondJob->IsCompleted());
+		ASSERT_EQ(secondJob->PendingDependenciesCount(), 1);
+		ASSERT_EQ(m_threadPool->PendingJobsCount(), 0);
+
+		// Allow dependency to complete, and ensure job is then executed
+		firstJob->canExecute = true;
+		std::array<std::shared_ptr<TimedJob>, 1> jobs = { secondJob };
+		ASSERT_TRUE(WaitForCompletion(jobs.begin(), jobs.end()));
+	}
+
+	// QueueJob() test
+	// with jobs of different priorities waiting for a busy thread
+	TEST_F(ThreadPoolTests, QueueJob_Priority)
+	{
+		// Create thread pool
+		m_threadPool = std::make_unique<ThreadPool>(1);
+
+		// Block the only thread, and wait for it to begin executing
+		std::shared_ptr<TimedJob> blockingJob = CreateJob();
+		m_threadPool->QueueJob(blockingJob);
+		while (blockingJob->threadID.load() == std::thread::id())
+		{
+			std::this_thread::yield();
+		}
+
+		// Enqueue a function for each priority, from lowest to highest
+		std::vector<JobPriority> executedPriorities;
+		JobCounter counter;
+		for (size_t i = JobPriorityCount; i > 0; i--)
+		{
+			JobPriority priority = static_cast<JobPriority>(i - 1);
+			m_threadPool->QueueJob([&executedPriorities, priority]
+			{
+				executedPriorities.push_back(priority);
+			}, &counter, priority);
+		}
+
+		// Unblock thread, and wait for it to execute all functions,
+		// without this thread helping so they're all executed in order by the pool's thread
+		blockingJob->canExecute = true;
+		while (!counter.IsComplete())
+		{
+			std::this_thread::yield();
+		}
+
+		// Ensure functions were executed from highest to lowest priority
+		ASSERT_EQ(executedPriorities.size(), JobPriorityCount);
+		for (size_t i = 0; i < JobPriorityCount; i++)
+		{
+			ASSERT_EQ(executedPriorities[i], static_cast<JobPriority>(i));
+		}
+	}
+
+	// QueueJob() with functions rather than jobs
+	TEST_F(ThreadPoolTests, QueueJob_Function)
+	{
+		// Create thread pool
+		m_threadPool = std::make_unique<ThreadPool>(4);
+
+		// Enqueue functions to thread pool, and wait for them
+		constexpr int functionCount = 1000;
+		std::atomic_int executedCount(0);
+		JobCounter counter;
+		for (int i = 0; i < functionCount; i++)
+		{
+			m_threadPool->QueueJob([&executedCount] { executedCount++; }, &counter);
+		}
+		m_threadPool->Wait(counter);
+
+		// Ensure all functions were executed once
+		ASSERT_EQ(executedCount, functionCount);
+		m_threadPool->WaitForThreads();
+	}
+
+	// Constructor with an idle policy which never spins
+	TEST_F(ThreadPoolTests, IdlePolicy_LowPower)
+	{
+		// Create thread pool
+		m_threadPool = std::make_unique<ThreadPool>(4, ThreadPool::ExecutionMode::Threads, IdlePolicy::LowPower());
+		ASSERT_EQ(m_threadPool->GetIdlePolicy().spinCount, 0);
+
+		// Ensure all threads go to sleep without jobs
+		auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+		while (m_threadPool->SleepingCount() < m_threadPool->Size() && std::chrono::steady_clock::now() < timeout)
+		{
+			std::this_thread::yield();
+		}
+		ASSERT_EQ(m_threadPool->SleepingCount(), m_threadPool->Size());
+
+		// Ensure a single job only wakes the thread it was given, and at most one other to steal it
+		std::atomic_uint sleepingCount(0);
+		JobCounter counter;
+		m_threadPool->QueueJob([this, &sleepingCount] { sleepingCount = m_threadPool->SleepingCount(); }, &counter);
+		m_threadPool->Wait(counter);
+		ASSERT_GE(sleepingCount, m_threadPool->Size() - 2);
+	}
+
+	// Constructor with an idle policy which spins for longer
+	TEST_F(ThreadPoolTests, IdlePolicy_LowLatency)
+	{
+		// Create thread pool
+		m_threadPool = std::make_unique<ThreadPool>(4, ThreadPool::ExecutionMode::Threads, IdlePolicy::LowLatency());
+
+		// Ensure jobs are executed, whether threads are spinning or have gone to sleep
+		std::atomic_int executedCount(0);
+		for (int i = 0; i < 3; i++)
+		{
+			JobCounter counter;
+			for (int j = 0; j < 100; j++)
+			{
+				m_threadPool->QueueJob([&executedCount] { executedCount++; }, &counter);
+			}
+			m_threadPool->Wait(counter);
+
+			std::this_thread::sleep_for(std::chrono::milliseconds(5));
+		}
+		ASSERT_EQ(executedCount, 300);
+	}
+
+	// Ensures pinned threads execute jobs on their own CPUs
+	TEST_F(ThreadPoolTests, Placement_Pinned)
+	{
+		// Create thread pool
+		m_threadPool = std::make_unique<ThreadPool>(4, ThreadPool::ExecutionMode::Threads, IdlePolicy(),
+			ThreadPool::ThreadPlacement::Pinned);
+		ASSERT_EQ(m_threadPool->GetPlacement(), ThreadPool::ThreadPlacement::Pinned);
+
+		// Ensure each job executes on the CPU its thread was pinned to,
+		// other than jobs executed by this thread while waiting
+		std::atomic_int mismatchCount(0);
+		JobCounter counter;
+		for (int i = 0; i < 100; i++)
+		{
+			m_threadPool->QueueJob([&mismatchCount]
+			{
+				PooledThread* thread = PooledThread::GetCurrent();
+				if (thread != nullptr && thread->GetCpu() != CpuTopology::GetCurrentCpu())
+				{
+					mismatchCount++;
+				}
+			}, &counter);
+		}
+		m_threadPool->Wait(counter);
+		ASSERT_EQ(mismatchCount, 0);
+	}
+
+	// Ensures unpinned threads are left for the operating system to place
+	TEST_F(ThreadPoolTests, Placement_Unpinned)
+	{
+		// Create thread pool
+		m_threadPool = std::make_unique<ThreadPool>(4, ThreadPool::ExecutionMode::Threads, IdlePolicy(),
+			ThreadPool::ThreadPlacement::Unpinned);
+		ASSERT_EQ(m_threadPool->GetReservedCpu(), -1);
+		ASSERT_FALSE(m_threadPool->PinToReservedCpu());
+
+		// Ensure no thread is pinned, other than this thread which may execute jobs while waiting
+		std::atomic_int executedCount(0);
+		JobCounter counter;
+		for (int i = 0; i < 100; i++)
+		{
+			m_threadPool->QueueJob([&executedCount]
+			{
+				PooledThread* thread = PooledThread::GetCurrent();
+				if (thread == nullptr || thread->GetCpu() == -1)
+				{
+					executedCount++;
+				}
+			}, &counter);
+		}
+		m_threadPool->Wait(counter);
+		ASSERT_EQ(executedCount, 100);
+	}
+
+	// Ensures an elastic pool starts temporary threads for blocked threads, and retires them once idle
+	TEST_F(ThreadPoolTests, ElasticPolicy_Blocking)
+	{
+		// Create thread pool
+		m_threadPool = std::make_unique<ThreadPool>(2, ThreadPool::ExecutionMode::Threads, IdlePolicy(),
+			ThreadPool::ThreadPlacement::Unpinned, ElasticPolicy::Elastic(1, 4, std::chrono::milliseconds(20)));
+		ASSERT_EQ(m_threadPool->Size(), 2);
+		ASSERT_EQ(m_threadPool->MaxSize(), 4);
+
+		// Block both threads
+		Latch blockedLatch(2);
+		Latch releaseLatch(1);
+		JobCounter blockedCounter;
+		for (int i = 0; i < 2; i++)
+		{
+			m_threadPool->QueueJob([&blockedLatch, &releaseLatch]
+			{
+				BlockingRegion blockingRegion;
+				blockedLatch.CountDown();
+				releaseLatch.Wait();
+			}, &blockedCounter);
+		}
+		blockedLatch.Wait();
+		ASSERT_EQ(m_threadPool->BlockingCount(), 2);
+		ASSERT_GE(m_threadPool->Size(), 3);
+
+		// Ensure a temporary thread executes jobs while both threads are blocked
+		JobCounter counter;
+		std::atomic_bool executed(false);
+		m_threadPool->QueueJob([&executed] { executed = true; }, &counter);
+		m_threadPool->Wait(counter);
+		ASSERT_TRUE(executed);
+
+		// Ensure threads beyond the minimum retire once idle
+		releaseLatch.CountDown();
+		m_threadPool->Wait(blockedCounter);
+		ASSERT_EQ(m_threadPool->BlockingCount(), 0);
+		auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+		while (m_threadPool->Size() > 1 && std::chrono::steady_clock::now() < timeout)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+		ASSERT_EQ(m_threadPool->Size(), 1);
+
+		// Ensure jobs are still executed once threads have retired
+		for (int i = 0; i < 100; i++)
+		{
+			m_threadPool->QueueJob([] {}, &counter);
+		}
+		m_threadPool->Wait(counter);
+	}
+
+	// Ensures a fixed pool only counts blocked threads
+	TEST_F(ThreadPoolTests, ElasticPolicy_Fixed)
+	{
+		// Create thread pool
+		m_threadPool = std::make_unique<ThreadPool>(2);
+
+		// Ensure regions outside of the pool aren't counted
+		{
+			BlockingRegion blockingRegion;
+			ASSERT_EQ(m_threadPool->BlockingCount(), 0);
+		}
+
+		// Ensure nested regions are counted once, and no threads are added
+		Latch blockedLatch(1);
+		Latch releaseLatch(1);
+		JobCounter counter;
+		m_threadPool->QueueJob([&blockedLatch, &releaseLatch]
+		{
+			BlockingRegion blockingRegion;
+			BlockingRegion nestedRegion;
+			blockedLatch.CountDown();
+			releaseLatch.Wait();
+		}, &counter);
+		blockedLatch.Wait();
+		ASSERT_EQ(m_threadPool->BlockingCount(), 1);
+		ASSERT_EQ(m_threadPool->Size(), 2);
+
+		releaseLatch.CountDown();
+		m_threadPool->Wait(counter);
+		ASSERT_EQ(m_threadPool->BlockingCount(), 0);
+	}
+
+	// Ensures I/O jobs execute on separate threads, without occupying the pool's own threads
+	TEST_F(ThreadPoolTests, QueueJob_IOLane)
+	{
+		// Create thread pool
+		m_threadPool = std::make_unique<ThreadPool>(2, ThreadPool::ExecutionMode::Threads, IdlePolicy(),
+			ThreadPool::ThreadPlacement::Unpinned, ElasticPolicy::Fixed(), 1);
+		ASSERT_EQ(m_threadPool->Size(), 2);
+		ASSERT_EQ(m_threadPool->IOSize(), 1);
+
+		// Block the I/O thread
+		Latch blockedLatch(1);
+		Latch releaseLatch(1);
+		std::atomic_bool isOnIOThread(false);
+		JobCounter ioCounter;
+		ThreadPool* threadPool = m_threadPool.get();
+		m_threadPool->QueueJob([&blockedLatch, &releaseLatch, &isOnIOThread, threadPool]
+		{
+			PooledThread* thread = PooledThread::GetCurrent();
+			isOnIOThread = thread != nullptr && thread->GetThreadPool() != threadPool;
+			blockedLatch.CountDown();
+			releaseLatch.Wait();
+		}, &ioCounter, JobPriority::Background, JobLane::IO);
+		blockedLatch.Wait();
+		ASSERT_TRUE(isOnIOThread);
+
+		// Ensure compute jobs still execute while the I/O thread is blocked
+		std::atomic_int executedCount(0);
+		JobCounter counter;
+		for (int i = 0; i < 100; i++)
+		{
+			m_threadPool->QueueJob([&executedCount] { executedCount++; }, &counter);
+		}
+		m_threadPool->Wait(counter);
+		ASSERT_EQ(executedCount, 100);
+		ASSERT_FALSE(ioCounter.IsComplete());
+
+		releaseLatch.CountDown();
+		m_threadPool->Wait(ioCounter);
+	}
+
+	// Ensures a compute job depending on an I/O job is queued with the compute threads
+	TEST_F(ThreadPoolTests, QueueJob_IOLane_Dependencies)
+	{
+		// Create thread pool
+		m_threadPool = std::make_unique<ThreadPool>(2, ThreadPool::ExecutionMode::Threads, IdlePolicy(),
+			ThreadPool::ThreadPlacement::Unpinned, ElasticPolicy::Fixed(), 1);
+
+		// Create compute job depending on an I/O job
+		std::shared_ptr<TimedJob> ioJob			= CreateJob();
+		std::shared_ptr<TimedJob> computeJob	= CreateJob();
+		ioJob->canExecute		= true;
+		computeJob->canExecute	= true;
+		computeJob->Schedule(ioJob);
+
+		// Enqueue jobs to thread pool, and wait for them
+		m_threadPool->QueueJob(computeJob);
+		m_threadPool->QueueJob(ioJob, nullptr, JobPriority::Frame, JobLane::IO);
+		m_threadPool->WaitForThreads();
+
+		// Ensure both jobs completed, on different threads
+		ASSERT_TRUE(ioJob->IsCompleted());
+		ASSERT_TRUE(computeJob->IsCompleted());
+		ASSERT_NE(ioJob->threadID.load(), computeJob->threadID.load());
+	}
+
+	// Normal usage of BeginFrame(), deferring background jobs once the budget is used
+	TEST_F(ThreadPoolTests, BeginFrame_Defer)
+	{
+		// Create thread pool
+		m_threadPool = std::make_unique<ThreadPool>(1);
+
+		// Begin a frame with no time left before deferring
+		FrameBudget budget		= FrameBudget::Target(std::chrono::milliseconds(16));
+		budget.deferMargin		= budget.frameTime;
+		m_threadPool->BeginFrame(budget);
+		ASSERT_TRUE(m_threadPool->IsDeferring());
+
+		// Queue a background job, and a frame job after it
+		std::atomic_bool isBackgroundComplete = false;
+		Latch frameLatch(1);
+		Latch backgroundLatch(1);
+		m_threadPool->QueueJob([&isBackgroundComplete, &backgroundLatch]
+		{
+			isBackgroundComplete = true;
+			backgroundLatch.CountDown();
+		}, JobPriority::Background);
+		m_threadPool->QueueJob([&frameLatch] { frameLatch.CountDown(); });
+
+		// Ensure only the frame job executes within this frame,
+		// waiting on latches rather than the pool so this thread doesn't execute the background job
+		frameLatch.Wait();
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+		ASSERT_FALSE(isBackgroundComplete.load());
+		ASSERT_EQ(m_threadPool->PendingJobsCount(), 1);
+
+		// Ensure the background job resumes once the next frame begins
+		m_threadPool->BeginFrame(FrameBudget::Unlimited());
+		ASSERT_FALSE(m_threadPool->IsDeferring());
+		backgroundLatch.Wait();
+		ASSERT_TRUE(isBackgroundComplete.load());
+	}
+
+	// BeginFrame() test
+	// with a thread outside the pool waiting while background jobs are deferred
+	TEST_F(ThreadPoolTests, BeginFrame_Defer_Wait)
+	{
+		// Create thread pool
+		m_threadPool = std::make_unique<ThreadPool>(1);
+
+		// Begin a frame with no time left before deferring
+		FrameBudget budget		= FrameBudget::Target(std::chrono::milliseconds(16));
+		budget.deferMargin		= budget.frameTime;
+		m_threadPool->BeginFrame(budget);
+
+		// Block the pool's only thread with the job waited on, and queue a background job behind it
+		Latch blockedLatch(1);
+		std::atomic_bool canComplete = false;
+		JobCounter counter;
+		m_threadPool->QueueJob([&blockedLatch, &canComplete]
+		{
+			blockedLatch.CountDown();
+			while (!canComplete)
+			{
+				std::this_thread::yield();
+			}
+		}, &counter);
+		blockedLatch.Wait();
+		std::atomic_bool isBackgroundComplete = false;
+		Latch backgroundLatch(1);
+		m_threadPool->QueueJob([&isBackgroundComplete, &backgroundLatch]
+		{
+			isBackgroundComplete = true;
+			backgroundLatch.CountDown();
+		}, JobPriority::Background);
+
+		// Allow the job waited on to complete once the waiting thread has had time to look for jobs
+		std::thread releasingThread([&canComplete]()
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(20));
+			canComplete = true;
+		});
+
+		// Ensure the waiting thread doesn't start the background job within this frame
+		m_threadPool->Wait(counter);
+		releasingThread.join();
+		ASSERT_FALSE(isBackgroundComplete.load());
+
+		// Ensure the background job resumes once the next frame begins
+		m_threadPool->BeginFrame(FrameBudget::Unlimited());
+		backgroundLatch.Wait();
+		ASSERT_TRUE(isBackgroundComplete.load());
+	}
+
+	// Normal usage of QueueJob() with deadlines
+	TEST_F(ThreadPoolTests, QueueJob_Deadline)
+	{
+		// Create thread pool
+		m_threadPool = std::make_unique<ThreadPool>(1);
+
+		// Block the pool's only thread until all jobs are queued
+		Latch blockedLatch(1);
+		Latch releaseLatch(1);
+		m_threadPool->QueueJob([&blockedLatch, &releaseLatch]
+		{
+			blockedLatch.CountDown();
+			releaseLatch.Wait();
+		});
+		blockedLatch.Wait();
+
+		// Queue a frame job, then jobs with deadlines out of order
+		std::vector<unsigned int> order;
+		Latch completeLatch(4);
+		std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		m_threadPool->QueueJob([&order, &completeLatch] { order.push_back(3); completeLatch.CountDown(); });
+		m_threadPool->QueueJob([&order, &completeLatch] { order.push_back(2); completeLatch.CountDown(); },
+			now + std::chrono::seconds(3));
+		m_threadPool->QueueJob([&order, &completeLatch] { order.push_back(0); completeLatch.CountDown(); },
+			now + std::chrono::seconds(1));
+		m_threadPool->QueueJob([&order, &completeLatch] { order.push_back(1); completeLatch.CountDown(); },
+			now + std::chrono::seconds(2));
+
+		// Ensure jobs with deadlines execute first, earliest first
+		releaseLatch.CountDown();
+		completeLatch.Wait();
+		std::vector<unsigned int> expectedOrder = { 0, 1, 2, 3 };
+		ASSERT_EQ(order, expectedOrder);
+	}
+
+	// QueueJob() with a deadline, for a job released by its dependency after a frame job was queued
+	TEST_F(ThreadPoolTests, QueueJob_Deadline_Job)
+	{
+		// Create thread pool
+		m_threadPool = std::make_unique<ThreadPool>(1);
+
+		// Block the pool's only thread until all jobs are queued
+		Latch blockedLatch(1);
+		Latch releaseLatch(1);
+		m_threadPool->QueueJob([&blockedLatch, &releaseLatch]
+		{
+			blockedLatch.CountDown();
+			releaseLatch.Wait();
+		});
+		blockedLatch.Wait();
+
+		// Queue a frame job, then a job with a deadline after its dependency
+		std::shared_ptr<TimedJob> dependency	= CreateJob();
+		std::shared_ptr<TimedJob> job			= CreateJob();
+		dependency->canExecute	= true;
+		job->canExecute			= true;
+		job->Schedule(dependency);
+		std::atomic_bool wasJobCompleted(false);
+		std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		m_threadPool->QueueJob([&wasJobCompleted, job] { wasJobCompleted = job->IsCompleted(); });
+		m_threadPool->QueueJob(job, now + std::chrono::seconds(1));
+		m_threadPool->QueueJob(dependency, now);
+
+		// Ensure the job kept its deadline once released, executing before the frame job
+		releaseLatch.CountDown();
+		m_threadPool->WaitForThreads();
+		ASSERT_TRUE(job->IsCompleted());
+		ASSERT_TRUE(wasJobCompleted);
+	}
+
+	// QueueJob() with a deadline on the I/O lane
+	TEST_F(ThreadPoolTests, QueueJob_Deadline_IOLane)
+	{
+		// Create thread pool
+		m_threadPool = std::make_unique<ThreadPool>(2, ThreadPool::ExecutionMode::Threads, IdlePolicy(),
+			ThreadPool::ThreadPlacement::Unpinned, ElasticPolicy::Fixed(), 1);
+
+		// Queue a function and a job with deadlines to the I/O thread
+		std::atomic_bool isOnIOThread(false);
+		std::atomic<std::thread::id> ioThreadID;
+		JobCounter counter;
+		ThreadPool* threadPool = m_threadPool.get();
+		std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+		m_threadPool->QueueJob([&isOnIOThread, &ioThreadID, threadPool]
+		{
+			PooledThread* thread = PooledThread::GetCurrent();
+			isOnIOThread	= thread != nullptr && thread->GetThreadPool() != threadPool;
+			ioThreadID		= std::this_thread::get_id();
+		}, deadline, &counter, JobLane::IO);
+		std::shared_ptr<TimedJob> job = CreateJob();
+		job->canExecute = true;
+		m_threadPool->QueueJob(job, deadline, &counter, JobLane::IO);
+
+		// Ensure both executed on the I/O thread
+		m_threadPool->Wait(counter);
+		ASSERT_TRUE(isOnIOThread);
+		ASSERT_TRUE(job->IsCompleted());
+		ASSERT_EQ(job->threadID.load(), ioThreadID.load());
+	}
+
+	// QueueJob() with a cancellation token cancelled before the job is taken
+	TEST_F(ThreadPoolTests, QueueJob_Cancelled)
+	{
+		// Create thread pool
+		m_threadPool = std::make_unique<ThreadPool>(1);
+
+		// Block the pool's only thread until all jobs are queued
+		Latch blockedLatch(1);
+		Latch releaseLatch(1);
+		m_threadPool->QueueJob([&blockedLatch, &releaseLatch]
+		{
+			blockedLatch.CountDown();
+			releaseLatch.Wait();
+		});
+		blockedLatch.Wait();
+
+		// Queue jobs with a token, and a job with a token which isn't cancelled
+		CancellationToken token;
+		CancellationToken otherToken;
+		JobCounter counter;
+		std::atomic_int executedCount = 0;
+		for (int i = 0; i < 4; i++)
+		{
+			m_threadPool->QueueJob([&executedCount] { executedCount++; }, token, &counter);
+		}
+		m_threadPool->QueueJob([&executedCount] { executedCount += 10; }, otherToken, &counter);
+
+		// Ensure cancelled jobs are skipped, but still completed
+		token.Cancel();
+		releaseLatch.CountDown();
+		m_threadPool->Wait(counter);
+		ASSERT_EQ(executedCount.load(), 10);
+		ASSERT_TRUE(counter.IsComplete());
+
+		// Wait for the blocking job too, as it isn't counted and uses latches on this stack
+		m_threadPool->WaitForThreads();
+	}
+
+	// Normal usage of Spawn(), with recursive divide and conquer
+	TEST_F(ThreadPoolTests, Spawn_Recursive)
+	{
+		// Create thread pool
+		m_threadPool = std::make_unique<ThreadPool>(4);
+		ThreadPool* threadPool = m_threadPool.get();
+
+		// Split a range in half until each part is a single element, waiting on the children of each part
+		std::atomic_uint leafCount = 0;
+		std::function<void(unsigned int, unsigned int)> split;
+		split = [&split, &leafCount, threadPool](unsigned int begin, unsigned int end)
+		{
+			if (end - begin == 1)
+			{
+				leafCount++;
+				return;
+			}
+
+			unsigned int middle = begin + (end - begin) / 2;
+			JobCounter children;
+			ThreadPool::Spawn([&split, begin, middle] { split(begin, middle); }, &children);
+			ThreadPool::Spawn([&split, middle, end] { split(middle, end); }, &children);
+			threadPool->Wait(children);
+		};
+
+		JobCounter counter;
+		m_threadPool->QueueJob([&split] { split(0, 1024); }, &counter);
+		m_threadPool->Wait(counter);
+
+		// Ensure every leaf was reached
+		ASSERT_EQ(leafCount.load(), 1024);
+	}
+
+	// Ensures children are executed newest first by the spawning thread
+	TEST_F(ThreadPoolTests, Spawn_LIFO)
+	{
+		// Create thread pool with a single thread, so no other thread steals the children
+		m_threadPool = std::make_unique<ThreadPool>(1);
+
+		std::vector<unsigned int> order;
+		Latch childrenLatch(3);
+		m_threadPool->QueueJob([&order, &childrenLatch]
+		{
+			for (unsigned int i = 0; i < 3; i++)
+			{
+				ThreadPool::Spawn([&order, &childrenLatch, i]
+				{
+					order.push_back(i);
+					childrenLatch.CountDown();
+				});
+			}
+		});
+
+		// Wait on the latch rather than the pool, so this thread doesn't steal any children
+		childrenLatch.Wait();
+
+		std::vector<unsigned int> expectedOrder = { 2, 1, 0 };
+		ASSERT_EQ(order, expectedOrder);
+	}
+
+	// Ensures lower priority jobs queued on a thread aren't starved by the children it keeps spawning
+	TEST_F(ThreadPoolTests, Spawn_Aging)
+	{
+		constexpr unsigned int generationCount = PooledThread::QueueType::AgingThreshold * 4;
+
+		// Create thread pool with a single thread, so no other thread steals the children
+		m_threadPool = std::make_unique<ThreadPool>(1);
+
+		// Spawn a chain of children, each spawning the next, once the background job has been queued
+		std::atomic_bool canSpawn				= false;
+		std::atomic_uint generation				= 0;
+		std::atomic_uint backgroundGeneration	= generationCount;
+		Latch completionLatch(2);
+		std::function<void()> spawnNext = [&spawnNext, &generation, &completionLatch]
+		{
+			if (generation.fetch_add(1) + 1 < generationCount)
+			{
+				ThreadPool::Spawn(spawnNext);
+			}
+			else
+			{
+				completionLatch.CountDown();
+			}
+		};
+		m_threadPool->QueueJob([&canSpawn, &spawnNext]
+		{
+			while (!canSpawn)
+			{
+				std::this_thread::yield();
+			}
+			spawnNext();
+		});
+		m_threadPool->QueueJob([&generation, &backgroundGeneration, &completionLatch]
+		{
+			backgroundGeneration = generation.load();
+			completionLatch.CountDown();
+		}, JobPriority::Background);
+		canSpawn = true;
+
+		// Wait on the latch rather than the pool, so this thread doesn't steal any jobs
+		completionLatch.Wait();
+
+		// Ensure the background job executed once passed over enough times, rather than after every child
+		ASSERT_LE(backgroundGeneration, PooledThread::QueueType::AgingThreshold + 1);
+	}
+
+	// Ensures Spawn() can't be called from outside a job
+	TEST_F(ThreadPoolTests, Spawn_Outside)
+	{
+		m_threadPool = std::make_unique<ThreadPool>(1);
+
+		ASSERT_THROW(ThreadPool::Spawn([] {}), std::logic_error);
+	}
+
+	// Wait() test
+	TEST_F(ThreadPoolTests, Wait)
+	{
+		// Create thread pool
+		m_threadPool = std::make_unique<ThreadPool>(4);
+
+		std::array<std::shared_ptr<TimedJob>, 8> jobs;
+		m_jobs.reserve(jobs.size());
+		for (size_t i = 0; i < jobs.size(); i++)
+		{
+			jobs[i] = CreateJob();
+			jobs[i]->canExecute = true;
+		}
+
+		// Enqueue jobs to thread pool, and wait for them
+		JobCounter counter;
+		m_threadPool->QueueJobs(jobs.begin(), jobs.end(), &counter);
+		m_threadPool->Wait(counter);
+
+		// Ensure all jobs were completed
+		ASSERT_TRUE(counter.IsComplete());
+		for (size_t i = 0; i < jobs.size(); i++)
+		{
+			ASSERT_TRUE(jobs[i]->IsCompleted());
+		}
+	}
+
+	// Wait() test
+	// with all threads within the pool busy
+	TEST_F(ThreadPoolTests, Wait_ExecutesOnWaitingThread)
+	{
+		// Create thread pool
+		m_threadPool = std::make_unique<ThreadPool>(1);
+
+		// Block the only thread within the pool
+		std::shared_ptr<TimedJob> blockingJob = CreateJob();
+		m_threadPool->QueueJob(blockingJob);
+		// Give enough time for thread to begin executing the job
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+		std::array<std::shared_ptr<TimedJob>, 4> jobs;
+		m_jobs.reserve(jobs.size() + 1);
+		for (size_t i = 0; i < jobs.size(); i++)
+		{
+			jobs[i] = CreateJob();
+			jobs[i]->canExecute = true;
+		}
+
+		// Enqueue jobs to thread pool, and wait for them
+		JobCounter counter;
+		m_threadPool->QueueJobs(jobs.begin(), jobs.end(), &counter);
+		m_threadPool->Wait(counter);
+
+		// Ensure jobs were executed by the waiting thread
+		for (size_t i = 0; i < jobs.size(); i++)
+		{
+			ASSERT_TRUE(jobs[i]->IsCompleted());
+			ASSERT_EQ(jobs[i]->threadID, std::this_thread::get_id());
+		}
+		ASSERT_FALSE(blockingJob->IsCompleted());
+	}
+
+	// Wait() test
+	// blocking while the jobs counted execute on other threads, until the last completes
+	TEST_F(ThreadPoolTests, Wait_Blocks)
+	{
+		// Create thread pool, whose waiting threads block without spinning
+		m_threadPool = std::make_unique<ThreadPool>(1, ThreadPool::ExecutionMode::Threads, IdlePolicy::LowPower());
+
+		// Block the only thread within the pool with the job waited on
+		std::shared_ptr<TimedJob> job = CreateJob();
+		JobCounter counter;
+		m_threadPool->QueueJob(job, &counter);
+
+		// Allow the job to complete once the waiting thread has had time to block
+		std::thread releasingThread([&job]()
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(20));
+			job->canExecute = true;
+		});
+
+		// Ensure the waiting thread is woken once the job completes
+		m_threadPool->Wait(counter);
+		ASSERT_TRUE(counter.IsComplete());
+		ASSERT_TRUE(job->IsCompleted());
+		releasingThread.join();
+	}
+
+	// Wait() test
+	// with a job executed by the waiting thread throwing
+	TEST_F(ThreadPoolTests, Wait_Exception)
+	{
+		// Create thread pool
+		m_threadPool = std::make_unique<ThreadPool>(1);
+
+		// Block the only thread within the pool, so the waiting thread executes the throwing job
+		std::shared_ptr<TimedJob> blockingJob = CreateJob();
+		m_threadPool->QueueJob(blockingJob);
+		// Give enough time for thread to begin executing the job
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+		JobCounter counter;
+		m_threadPool->QueueJob([]() { throw std::runtime_error("Job failed"); }, &counter);
+		ASSERT_THROW(m_threadPool->Wait(counter), std::runtime_error);
+
+		// Ensure the waiting thread no longer spawns jobs with the pool, as it's no longer helping it
+		ASSERT_THROW(ThreadPool::Spawn([] {}), std::logic_error);
+	}
+
+	// Wait() test
+	// from within jobs executing on fibers
+	TEST_F(ThreadPoolTests, Wait_Fibers)
+	{
+		if (!Fiber::IsSupported())
+		{
+			return;
+		}
+
+		// Create thread pool in fiber mode, with a single thread
+		m_threadPool = std::make_unique<ThreadPool>(1, ThreadPool::ExecutionMode::Fibers);
+
+		// Queue a job waiting on a counter, then a second job waiting on another counter
+		JobCounter firstCounter, secondCounter;
+		firstCounter.Increment();
+		secondCounter.Increment();
+		std::atomic_bool firstCompleted(false), secondCompleted(false);
+		m_threadPool->QueueJob([&firstCounter, &firstCompleted]
+		{
+			m_threadPool->Wait(firstCounter);
+			firstCompleted = true;
+		});
+		m_threadPool->QueueJob([&secondCounter, &secondCompleted]
+		{
+			m_threadPool->Wait(secondCounter);
+			secondCompleted = true;
+		});
+
+		// Complete first counter, and ensure first job resumes
+		// even though the second job is still waiting on the same thread
+		firstCounter.Decrement();
+		auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+		while (!firstCompleted && std::chrono::steady_clock::now() < timeout)
+		{
+			std::this_thread::yield();
+		}
+		ASSERT_TRUE(firstCompleted);
+		ASSERT_FALSE(secondCompleted);
+
+		// Complete second counter, and wait for second job
+		secondCounter.Decrement();
+		m_threadPool->WaitForThreads();
+		ASSERT_TRUE(secondCompleted);
+	}
+
+	// ParallelFor() test
+	// with a thread pool in fiber mode
+	TEST_F(ThreadPoolTests, ParallelFor_Fibers)
+	{
+		if (!Fiber::IsSupported())
+		{
+			return;
+		}
+
+		// Create thread pool in fiber mode
+		m_threadPool = std::make_unique<ThreadPool>(2, ThreadPool::ExecutionMode::Fibers);
+
+		// Process each row in parallel, and each column of each row in parallel,
+		// suspending rows while waiting for their columns
+		constexpr size_t rowCount		= 32;
+		constexpr size_t columnCount	= 1000;
+		std::vector<std::atomic_int> processedCounts(rowCount * columnCount);
+		m_threadPool->ParallelFor(0, rowCount, 1, [&processedCounts](size_t row)
+		{
+			m_threadPool->ParallelFor(0, columnCount, 16, [&processedCounts, row](size_t column)
+			{
+				processedCounts[row * columnCount + column]++;
+			});
+		});
+
+		// Ensure each index was processed exactly once
+		for (size_t i = 0; i < processedCounts.size(); i++)
+		{
+			ASSERT_EQ(processedCounts[i], 1);
+		}
+	}
+
+	// Normal usage of ParallelFor()
+	TEST_F(ThreadPoolTests, ParallelFor)
+	{
+		// Create thread pool
+		m_threadPool = std::make_unique<ThreadPool>(4);
+
+		// Process each index in parallel
+		constexpr size_t indexCount = 100000;
+		std::vector<std::atomic_int> processedCounts(indexCount);
+		m_threadPool->ParallelFor(0, indexCount, 64, [&processedCounts](size_t i)
+		{
+			processedCounts[i]++;
+		});
+
+		// Ensure each index was processed exactly once
+		for (size_t i = 0; i < indexCount; i++)
+		{
+			ASSERT_EQ(processedCounts[i], 1);
+		}
+
+		// Ensure empty ranges are ignored
+		m_threadPool->ParallelFor(10, 10, 1, [&processedCounts](size_t i)
+		{
+			processedCounts[i]++;
+		});
+		ASSERT_EQ(processedCounts[10], 1);
+	}
+
+	// ParallelFor() test
+	// called from within jobs executing on the pool's threads
+	TEST_F(ThreadPoolTests, ParallelFor_Nested)
+	{
+		// Create thread pool
+		m_threadPool = std::make_unique<ThreadPool>(2);
+
+		// Process each row in parallel, and each column of each row in parallel
+		constexpr size_t rowCount		= 16;
+		constexpr size_t columnCount	= 1000;
+		std::vector<std::atomic_int> processedCounts(rowCount * columnCount);
+		m_threadPool->ParallelFor(0, rowCount, 1, [&processedCounts](size_t row)
+		{
+			m_threadPool->ParallelFor(0, columnCount, 16, [&processedCounts, row](size_t column)
+			{
+				processedCounts[row * columnCount + column]++;
+			});
+		});
+
+		// Ensure each index was processed exactly once
+		for (size_t i = 0; i < processedCounts.size(); i++)
+		{
+			ASSERT_EQ(processedCounts[i], 1);
+		}
+	}
+
+	// Normal usage of ParallelReduce()
+	TEST_F(ThreadPoolTests, ParallelReduce)
+	{
+		// Create thread pool
+		m_threadPool = std::make_unique<ThreadPool>(4);
+
+		// Sum indices in parallel
+		constexpr size_t indexCount = 100000;
+		auto map		= [](size_t i) { return static_cast<unsigned long long>(i); };
+		auto combine	= [](unsigned long long a, unsigned long long b) { return a + b; };
+		unsigned long long sum = m_threadPool->ParallelReduce(0, indexCount, 256, 0ULL, map, combine);
+
+		// Ensure sum is correct
+		ASSERT_EQ(sum, static_cast<unsigned long long>(indexCount) * (indexCount - 1) / 2);
+
+		// Ensure empty ranges reduce to the identity
+		ASSERT_EQ(m_threadPool->ParallelReduce(5, 5, 256, 7ULL, map, combine), 7ULL);
+	}
+
+	// ParallelReduce() test
+	// with an operation which isn't associative
+	TEST_F(ThreadPoolTests, ParallelReduce_Deterministic)
+	{
+		// Create thread pool
+		m_threadPool = std::make_unique<ThreadPool>(4);
+
+		// Sum floating point values, which round differently depending on order of addition
+		constexpr size_t indexCount = 100000;
+		auto map		= [](size_t i) { return 1.0f / static_cast<float>(i + 1); };
+		auto combine	= [](float a, float b) { return a + b; };
+		float firstSum = m_threadPool->ParallelReduce(0, indexCount, 100, 0.0f, map, combine);
+
+		// Ensure every reduction produces exactly the same result
+		for (int i = 0; i < 20; i++)
+		{
+			ASSERT_EQ(m_threadPool->ParallelReduce(0, indexCount, 100, 0.0f, map, combine), firstSum);
+		}
+	}
+
+	// ParallelReduce() test
+	// with boolean values, written by each chunk in parallel
+	TEST_F(ThreadPoolTests, ParallelReduce_Bool)
+	{
+		// Create thread pool
+		m_threadPool = std::make_unique<ThreadPool>(4);
+
+		// Reduce many small chunks, so adjacent chunks complete on different threads
+		constexpr size_t indexCount = 4096;
+		auto isEven		= [](size_t i) { return i % 2 == 0; };
+		auto isSmall	= [](size_t i) { return i < indexCount; };
+		auto any		= [](bool a, bool b) { return a || b; };
+		auto all		= [](bool a, bool b) { return a && b; };
+		for (int i = 0; i < 20; i++)
+		{
+			// Ensure no chunk's result is lost
+			ASSERT_TRUE(m_threadPool->ParallelReduce(0, indexCount, 1, true, isSmall, all));
+			ASSERT_FALSE(m_threadPool->ParallelReduce(0, indexCount, 1, true, isEven, all));
+			ASSERT_TRUE(m_threadPool->ParallelReduce(indexCount - 1, indexCount + 1, 1, false, isEven, any));
+		}
+	}
+
+	// WaitForThreads() test
+	// with a job depending on a job which is never queued
+	TEST_F(ThreadPoolTests, WaitForThreads_UnqueuedDependency)
+	{
+		// Create thread pool
+		m_threadPool = std::make_unique<ThreadPool>(2);
+
+		// Create job depending on a job which is never queued
+		std::shared_ptr<TimedJob> dependency	= std::make_shared<TimedJob>();
+		std::shared_ptr<TimedJob> job			= CreateJob();
+		job->canExecute = true;
+		job->Schedule(dependency);
+
+		// Enqueue job to thread pool, release its dependency, and wait for it
+		m_threadPool->QueueJob(job);
+		dependency.reset();
+		m_threadPool->WaitForThreads();
+
+		// Ensure job was completed as cancelled
+		ASSERT_TRUE(job->IsCompleted());
+		ASSERT_TRUE(job->IsCancelled());
+		ASSERT_EQ(m_threadPool->PendingJobsCount(), 0);
+	}
+
+	// WaitForThreads() test
+	// with jobs waiting for dependencies
+	TEST_F(ThreadPoolTests, WaitForThreads_Dependencies)
+	{
+		// Create thread pool
+		m_threadPool = std::make_unique<ThreadPool>(2);
+
+		// Create chain of jobs, each depending on the previous job
+		std::array<std::shared_ptr<TimedJob>, 4> jobs;
+		m_jobs.reserve(jobs.size());
+		for (size_t i = 0; i < jobs.size(); i++)
+		{
+			jobs[i] = CreateJob();
+			jobs[i]->canExecute = true;
+			if (i > 0)
+			{
+				jobs[i]->Schedule(jobs[i - 1]);
+			}
+		}
+
+		// Enqueue jobs to thread pool, and wait for them
+		m_threadPool->QueueJobs(jobs.begin(), jobs.end());
+		m_threadPool->WaitForThreads();
+
+		// Ensure all jobs were completed
+		for (size_t i = 0; i < jobs.size(); i++)
+		{
+			ASSERT_TRUE(jobs[i]->IsCompleted());
+		}
+	}
+
 	// RunningCount() test
 	// with all threads running
 	TEST_F(ThreadPoolTests, RunningCount_AllRunning)
@@ -309,4 +1497,86 @@ namespace AndGen::Tests
 		// (since some jobs are being executed while some are pending to be executed)
 		ASSERT_EQ(m_threadPool->PendingJobsCount(), jobs.size() - static_cast<size_t>(m_threadPool->Size()));
 	}
+
+	// Normal usage of GetStats()
+	TEST_F(ThreadPoolTests, GetStats)
+	{
+		constexpr unsigned int jobCount		= 64;
+		constexpr unsigned int spawnCount	= 4;
+
+		// Create thread pool
+		m_threadPool = std::make_unique<ThreadPool>(2);
+
+		// Queue jobs from this thread, each spawning children from within the pool
+		for (unsigned int i = 0; i < jobCount; i++)
+		{
+			m_threadPool->QueueJob([]
+			{
+				for (unsigned int j = 0; j < spawnCount; j++)
+				{
+					ThreadPool::Spawn([] {});
+				}
+			});
+		}
+		m_threadPool->WaitForThreads();
+
+		// Ensure every job was counted as queued and executed, by whichever thread did so,
+		// children spawned by jobs this thread executed while waiting being queued from outside the pool
+		ThreadPoolStats stats = m_threadPool->GetStats();
+		ThreadStats total = stats.Total();
+		ASSERT_EQ(stats.threads.size(), 2);
+		ASSERT_GE(stats.external.jobsQueued, jobCount);
+		ASSERT_EQ(total.jobsQueued, jobCount * (spawnCount + 1));
+		ASSERT_EQ(total.jobsExecuted, jobCount * (spawnCount + 1));
+		ASSERT_EQ(stats.pendingJobs, 0);
+		ASSERT_LE(total.steals, total.stealAttempts);
+
+		// Ensure each job executed by the pool's threads was counted within their queue depth histograms
+		std::uint64_t histogramCount = 0;
+		for (const ThreadStats& thread : stats.threads)
+		{
+			for (std::uint64_t bucketCount : thread.queueDepthHistogram)
+			{
+				histogramCount += bucketCount;
+			}
+		}
+		ASSERT_EQ(histogramCount, total.jobsExecuted - stats.external.jobsExecuted);
+	}
+
+	// GetStats() timing each thread's activity
+	TEST_F(ThreadPoolTests, GetStats_Times)
+	{
+		// Create thread pool with a single thread
+		m_threadPool = std::make_unique<ThreadPool>(1);
+
+		// Wait on latches rather than the pool so this thread doesn't execute the job
+		Latch latch(1);
+		m_threadPool->QueueJob([&latch]
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+			latch.CountDown();
+		});
+		latch.Wait();
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+		// Ensure the job was timed once the thread ran out of jobs
+		ThreadStats stats = m_threadPool->GetStats().threads[0];
+		ASSERT_EQ(stats.jobsExecuted, 1);
+		ASSERT_GE(stats.executingTime, std::chrono::milliseconds(10));
+		ASSERT_EQ(m_threadPool->RunningCount(), 0);
+	}
+
+	// ThreadStats::QueueDepthBucket() test
+	TEST(ThreadStatsTests, QueueDepthBucket)
+	{
+		ASSERT_EQ(ThreadStats::QueueDepthBucket(0), 0);
+		ASSERT_EQ(ThreadStats::QueueDepthBucket(1), 1);
+		ASSERT_EQ(ThreadStats::QueueDepthBucket(2), 2);
+		ASSERT_EQ(ThreadStats::QueueDepthBucket(3), 2);
+		ASSERT_EQ(ThreadStats::QueueDepthBucket(4), 3);
+		ASSERT_EQ(ThreadStats::QueueDepthBucket(63), 6);
+		// Ensure larger depths are counted within the last bucket
+		ASSERT_EQ(ThreadStats::QueueDepthBucket(64), ThreadStats::QueueDepthBucketCount - 1);
+		ASSERT_EQ(ThreadStats::QueueDepthBucket(1u << 20), ThreadStats::QueueDepthBucketCount - 1);
+	}
 }
@@ -0,0 +1,140 @@
+#include <Engine/Parallelism/WorkStealingDeque.hpp>
+
+// STL includes
+#include <atomic>
+#include <thread>
+#include <vector>
+// Google Test includes
+#include <gtest/gtest.h>
+
+namespace AndGen::Tests
+{
+	// Normal usage of Push() and Pop()
+	TEST(WorkStealingDequeTests, PushPop)
+	{
+		WorkStealingDeque<int> deque;
+		ASSERT_TRUE(deque.IsEmpty());
+
+		// Push items
+		deque.Push(1);
+		deque.Push(2);
+		deque.Push(3);
+		ASSERT_EQ(deque.Count(), 3);
+
+		// Ensure items are popped in LIFO order
+		int item = 0;
+		ASSERT_TRUE(deque.Pop(item));
+		ASSERT_EQ(item, 3);
+		ASSERT_TRUE(deque.Pop(item));
+		ASSERT_EQ(item, 2);
+		ASSERT_TRUE(deque.Pop(item));
+		ASSERT_EQ(item, 1);
+
+		// Ensure deque is now empty
+		ASSERT_FALSE(deque.Pop(item));
+		ASSERT_TRUE(deque.IsEmpty());
+	}
+
+	// Normal usage of Steal()
+	TEST(WorkStealingDequeTests, Steal)
+	{
+		WorkStealingDeque<int> deque;
+
+		// Push items
+		deque.Push(1);
+		deque.Push(2);
+		deque.Push(3);
+
+		// Ensure items are stolen in FIFO order
+		int item = 0;
+		ASSERT_TRUE(deque.Steal(item));
+		ASSERT_EQ(item, 1);
+		ASSERT_TRUE(deque.Steal(item));
+		ASSERT_EQ(item, 2);
+
+		// Ensure owner still pops remaining item
+		ASSERT_TRUE(deque.Pop(item));
+		ASSERT_EQ(item, 3);
+		ASSERT_FALSE(deque.Steal(item));
+	}
+
+	// Push() beyond initial capacity
+	TEST(WorkStealingDequeTests, Push_Grow)
+	{
+		WorkStealingDeque<int> deque(2);
+
+		// Push more items than initial capacity
+		for (int i = 0; i < 100; i++)
+		{
+			deque.Push(i);
+		}
+		ASSERT_EQ(deque.Count(), 100);
+
+		// Ensure all items are retained in order
+		int item = 0;
+		for (int i = 99; i >= 0; i--)
+		{
+			ASSERT_TRUE(deque.Pop(item));
+			ASSERT_EQ(item, i);
+		}
+	}
+
+	// Steal() with multiple threads while the owner pushes and pops
+	TEST(WorkStealingDequeTests, Steal_Threaded)
+	{
+		constexpr int itemCount = 10000;
+
+		WorkStealingDeque<int> deque(16);
+		std::vector<std::atomic_int> itemTakenCounts(itemCount);
+		std::atomic_int takenCount(0);
+
+		// Thieves steal until all items are taken
+		auto thief = [&]
+		{
+			int item = 0;
+			while (takenCount < itemCount)
+			{
+				if (deque.Steal(item))
+				{
+					itemTakenCounts[item]++;
+					takenCount++;
+				}
+			}
+		};
+		std::thread firstThief(thief);
+		std::thread secondThief(thief);
+
+		// Owner pushes all items, and pops every other push
+		int item = 0;
+		for (int i = 0; i < itemCount; i++)
+		{
+			deque.Push(i);
+			if (i % 2 == 0 && deque.Pop(item))
+			{
+				itemTakenCounts[item]++;
+				takenCount++;
+			}
+		}
+		while (deque.Pop(item))
+		{
+			itemTakenCounts[item]++;
+			takenCount++;
+		}
+
+		// Wait for thieves
+		if (firstThief.joinable())
+		{
+			firstThief.join();
+		}
+		if (secondThief.joinable())
+		{
+			secondThief.join();
+		}
+
+		// Ensure every item was taken exactly once
+		for (int i = 0; i < itemCount; i++)
+		{
+			ASSERT_EQ(itemTakenCounts[i], 1);
+		}
+	}
+}